@@ -0,0 +1,93 @@
+// Relinking algorithms against the copy-to-vector-and-rebuild approach on
+// lists of large elements.  Each run reports time and allocator calls.
+
+#include <p_linked_list/algorithm.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "count_allocations.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+struct payload {
+    std::uint64_t key;
+    std::array<std::uint64_t, 31> data;  // 256 bytes in all
+
+    friend bool operator<(const payload& a, const payload& b) { return a.key < b.key; }
+    friend bool operator==(const payload& a, const payload& b) { return a.key == b.key; }
+};
+
+using list = std::list<payload>;
+
+template <class F>
+void via_vector(list& l, F f) {
+    std::vector<payload> v(l.begin(), l.end());
+    f(v);
+    l.assign(v.begin(), v.end());
+}
+
+template <class Setup, class F>
+void run(const char* name, const char* how, const list& input, Setup setup, F f) {
+    list l = input;
+    setup(l);
+    bench::allocations.store(0);
+    double t = bench::seconds([&] { f(l); });
+    std::printf("%-16s %-10s %10.2f ms %12zu\n", name, how, t * 1e3, bench::allocations.load());
+    bench::keep(l.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = bench::scaled(500'000, bench::scale(argc, argv));
+    std::mt19937_64 rng(7);
+    list input;
+    for (std::size_t i = 0; i < n; ++i)
+        input.push_back(payload{rng() % (n / 4 + 1), {}});
+    auto odd = [](const payload& p) { return p.key % 2 != 0; };
+    auto none = [](list&) {};
+    auto sorted = [](list& l) { l.sort(); };
+
+    std::printf("%zu elements of %zu bytes\n", n, sizeof(payload));
+    std::printf("%-16s %-10s %13s %12s\n", "algorithm", "method", "time", "allocations");
+
+    run("stable_partition", "relink", input, none, [&](list& l) { pl::stable_partition(l, odd); });
+    run("stable_partition", "vector", input, none,
+        [&](list& l) { via_vector(l, [&](auto& v) { std::stable_partition(v.begin(), v.end(), odd); }); });
+
+    run("unique", "relink", input, sorted, [&](list& l) {
+        list removed;
+        pl::unique(l, removed);
+    });
+    run("unique", "vector", input, sorted, [&](list& l) {
+        via_vector(l, [](auto& v) { v.erase(std::unique(v.begin(), v.end()), v.end()); });
+    });
+
+    run("remove_if", "relink", input, none, [&](list& l) {
+        list removed;
+        pl::remove_if(l, removed, odd);
+    });
+    run("remove_if", "vector", input, none,
+        [&](list& l) { via_vector(l, [&](auto& v) { v.erase(std::remove_if(v.begin(), v.end(), odd), v.end()); }); });
+
+    run("rotate", "relink", input, none, [&](list& l) { pl::rotate(l, std::next(l.begin(), l.size() / 3)); });
+    run("rotate", "vector", input, none, [&](list& l) {
+        via_vector(l, [](auto& v) { std::rotate(v.begin(), v.begin() + v.size() / 3, v.end()); });
+    });
+
+    run("reverse", "relink", input, none, [&](list& l) { pl::reverse(l); });
+    run("reverse", "vector", input, none, [&](list& l) { via_vector(l, [](auto& v) { std::reverse(v.begin(), v.end()); }); });
+
+    run("nth_element", "relink", input, none, [&](list& l) { pl::nth_element(l, l.size() / 2); });
+    run("nth_element", "vector", input, none, [&](list& l) {
+        via_vector(l, [](auto& v) { std::nth_element(v.begin(), v.begin() + v.size() / 2, v.end()); });
+    });
+}
@@ -0,0 +1,84 @@
+// Shared helpers for the benchmarks: timing, percentiles, resident set size
+// and the scale argument every benchmark takes.
+
+#ifndef P_LINKED_LIST_BENCH_BENCH_HPP
+#define P_LINKED_LIST_BENCH_BENCH_HPP
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+namespace bench {
+
+using clock = std::chrono::steady_clock;
+
+inline double elapsed(clock::time_point since) {
+    return std::chrono::duration<double>(clock::now() - since).count();
+}
+
+// Wall-clock seconds taken by f().
+template <class F>
+double seconds(F&& f) {
+    auto t0 = clock::now();
+    f();
+    return elapsed(t0);
+}
+
+// Keeps the compiler from discarding a computed value.
+template <class T>
+inline void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// The p-th percentile (0..100) of `samples`, which it sorts.
+inline double percentile(std::vector<double>& samples, double p) {
+    if (samples.empty())
+        return 0;
+    std::sort(samples.begin(), samples.end());
+    std::size_t i = static_cast<std::size_t>(p / 100 * static_cast<double>(samples.size() - 1) + 0.5);
+    return samples[std::min(i, samples.size() - 1)];
+}
+
+// Current resident set size in KiB, from /proc/self/statm.
+inline std::size_t rss_kib() {
+    std::FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f)
+        return 0;
+    unsigned long size = 0, resident = 0;
+    int got = std::fscanf(f, "%lu %lu", &size, &resident);
+    std::fclose(f);
+    if (got != 2)
+        return 0;
+    return resident * static_cast<std::size_t>(::sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+// Multiplies a benchmark's default size by the optional first argument.
+inline double scale(int argc, char** argv) {
+    double s = argc > 1 ? std::atof(argv[1]) : 1.0;
+    return s > 0 ? s : 1.0;
+}
+
+inline std::size_t scaled(std::size_t n, double s) {
+    return std::max<std::size_t>(1, static_cast<std::size_t>(static_cast<double>(n) * s));
+}
+
+// 1, 2, 4, ... up to `max`, with `max` itself last.
+inline std::vector<unsigned> thread_counts(unsigned max) {
+    std::vector<unsigned> out;
+    for (unsigned t = 1; t < max; t *= 2)
+        out.push_back(t);
+    out.push_back(max);
+    return out;
+}
+
+inline unsigned hardware_threads() { return std::max(1u, std::thread::hardware_concurrency()); }
+
+} // namespace bench
+
+#endif
@@ -0,0 +1,69 @@
+// blob_list against std::list<std::string> on short strings (some beyond the
+// small-string buffer) and on medium-sized blobs.  Reports allocator calls,
+// heap bytes, build time and traversal time.
+
+#include <p_linked_list/blob_list.hpp>
+
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench.hpp"
+#include "count_allocations.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+template <class List, class Push>
+void run(const char* workload, const char* name, const std::vector<std::string>& items, Push push) {
+    std::optional<List> l;
+    l.emplace();
+    bench::allocations.store(0);
+    bench::allocated_bytes.store(0);
+    double t_build = bench::seconds([&] {
+        for (const auto& x : items)
+            push(*l, x);
+    });
+    const std::size_t allocs = bench::allocations.load();
+    const double heap_mib = static_cast<double>(bench::allocated_bytes.load()) / (1 << 20);
+    std::uint64_t sum = 0;
+    double t_walk = bench::seconds([&] {
+        for (const auto& x : *l)
+            sum += static_cast<unsigned char>(x[x.size() / 2]) + x.size();
+    });
+    bench::keep(sum);
+    const double per = 1e9 / static_cast<double>(items.size());
+    std::printf("%-8s %-22s %12zu %10.1f %14.1f %16.2f\n", workload, name, allocs, heap_mib, t_build * per,
+                t_walk * per);
+}
+
+std::vector<std::string> make(std::size_t n, std::size_t min_len, std::size_t max_len, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<std::string> out;
+    out.reserve(n);
+    for (std::size_t i = 0; i < n; ++i)
+        out.emplace_back(min_len + rng() % (max_len - min_len + 1), static_cast<char>('a' + rng() % 26));
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const auto short_strings = make(bench::scaled(2'000'000, s), 8, 40, 1);
+    const auto blobs = make(bench::scaled(200'000, s), 200, 2000, 2);
+
+    auto push_string = [](std::list<std::string>& l, const std::string& x) { l.push_back(x); };
+    auto push_blob = [](pl::blob_list& l, const std::string& x) { l.push_back(x); };
+
+    std::printf("%-8s %-22s %12s %10s %14s %16s\n", "workload", "list", "allocations", "heap MiB",
+                "build ns/elem", "traverse ns/elem");
+    run<std::list<std::string>>("short", "std::list<std::string>", short_strings, push_string);
+    run<pl::blob_list>("short", "blob_list", short_strings, push_blob);
+    run<std::list<std::string>>("medium", "std::list<std::string>", blobs, push_string);
+    run<pl::blob_list>("medium", "blob_list", blobs, push_blob);
+}
@@ -0,0 +1,108 @@
+// Fan-out of one producer to 1..16 readers that each must see every item.
+// broadcast_log stores each item once and every reader follows it with its
+// own cursor; the baseline copies each item into one mutex-protected deque
+// per reader, and readers drain their deque a batch at a time.  Reports
+// millions of items per second as seen by each reader, from the first push
+// until the last reader has read everything.
+
+#include <p_linked_list/broadcast_log.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+struct item {
+    std::uint64_t seq;
+    std::uint64_t payload[3];
+};
+
+double run_log(unsigned readers, std::size_t items) {
+    pl::broadcast_log<item> log;
+    std::vector<std::unique_ptr<pl::broadcast_log<item>::cursor>> cursors;
+    for (unsigned r = 0; r < readers; ++r)
+        cursors.push_back(log.subscribe());
+    return bench::seconds([&] {
+        std::vector<std::jthread> threads;
+        for (unsigned r = 0; r < readers; ++r) {
+            threads.emplace_back([&, r] {
+                std::uint64_t sum = 0;
+                while (const item* v = cursors[r]->wait_next())
+                    sum += v->seq;
+                bench::keep(sum);
+            });
+        }
+        for (std::size_t i = 0; i < items; ++i)
+            log.push(item{i, {i, i, i}});
+        log.close();
+    });
+}
+
+struct locked_queue {
+    std::mutex m;
+    std::deque<item> q;
+    bool closed = false;
+};
+
+double run_queues(unsigned readers, std::size_t items) {
+    std::vector<locked_queue> queues(readers);
+    return bench::seconds([&] {
+        std::vector<std::jthread> threads;
+        for (unsigned r = 0; r < readers; ++r) {
+            threads.emplace_back([&, r] {
+                std::uint64_t sum = 0;
+                std::deque<item> batch;
+                for (;;) {
+                    bool closed;
+                    {
+                        std::lock_guard<std::mutex> lock(queues[r].m);
+                        batch.swap(queues[r].q);
+                        closed = queues[r].closed;
+                    }
+                    for (const item& v : batch)
+                        sum += v.seq;
+                    if (batch.empty() && closed)
+                        break;
+                    if (batch.empty())
+                        std::this_thread::yield();
+                    batch.clear();
+                }
+                bench::keep(sum);
+            });
+        }
+        for (std::size_t i = 0; i < items; ++i) {
+            const item v{i, {i, i, i}};
+            for (auto& q : queues) {
+                std::lock_guard<std::mutex> lock(q.m);
+                q.q.push_back(v);
+            }
+        }
+        for (auto& q : queues) {
+            std::lock_guard<std::mutex> lock(q.m);
+            q.closed = true;
+        }
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t items = bench::scaled(5'000'000, s);
+    std::printf("%zu items of %zu bytes, %u hardware threads\n", items, sizeof(item), bench::hardware_threads());
+    std::printf("%8s %22s %22s\n", "readers", "log Mitems/s/reader", "queues Mitems/s/reader");
+    for (unsigned readers : bench::thread_counts(16)) {
+        const double a = run_log(readers, items);
+        const double b = run_queues(readers, items);
+        const double m = static_cast<double>(items) / 1e6;
+        std::printf("%8u %22.2f %22.2f\n", readers, m / a, m / b);
+    }
+}
@@ -0,0 +1,121 @@
+// Sending a message held as a chain of slices through a pipe and a Unix
+// socket pair: write_to() hands the slices to writev, while the baseline
+// gathers them into one contiguous buffer and calls write.  A reader thread
+// drains the other end, with read_from() in the chain case.  Messages are 64
+// slices of 64 B to 16 KiB.  Each chain send starts from clone(), which
+// allocates one slice per piece; with small slices that, not the copy, is
+// what the chain pays for.  Reports GB/s.
+
+#include <p_linked_list/buffer_chain.hpp>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+constexpr std::size_t pieces = 64;
+
+pl::buffer_chain make_message(std::size_t piece) {
+    pl::buffer_chain msg;
+    const std::string bytes(piece, 'x');
+    for (std::size_t i = 0; i < pieces; ++i) {
+        pl::buffer_chain part;
+        part.append(bytes);
+        msg.append(std::move(part));
+    }
+    return msg;
+}
+
+bool write_all(int fd, const char* p, std::size_t n) {
+    while (n) {
+        ssize_t w = ::write(fd, p, n);
+        if (w < 0)
+            return false;
+        p += w;
+        n -= static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+// Sends `count` copies of `msg` over fds[1] and drains fds[0]; returns GB/s.
+template <bool Chain>
+double run(int fds[2], const pl::buffer_chain& msg, std::size_t count) {
+    std::size_t received = 0;
+    const double t = bench::seconds([&] {
+        std::jthread reader([&] {
+            if constexpr (Chain) {
+                pl::buffer_chain in;
+                for (ssize_t r; (r = in.read_from(fds[0], 1 << 16)) > 0;) {
+                    received += static_cast<std::size_t>(r);
+                    in.clear();
+                }
+            } else {
+                std::vector<char> buf(1 << 16);
+                for (ssize_t r; (r = ::read(fds[0], buf.data(), buf.size())) > 0;)
+                    received += static_cast<std::size_t>(r);
+            }
+        });
+        std::string flat;
+        for (std::size_t i = 0; i < count; ++i) {
+            if constexpr (Chain) {
+                pl::buffer_chain out = msg.clone();
+                while (!out.empty()) {
+                    if (out.write_to(fds[1]) < 0)
+                        return;
+                }
+            } else {
+                flat.resize(msg.size());
+                msg.copy_to(flat.data(), flat.size());
+                if (!write_all(fds[1], flat.data(), flat.size()))
+                    return;
+            }
+        }
+        ::close(fds[1]);
+    });
+    ::close(fds[0]);
+    if (received != msg.size() * count)
+        std::fprintf(stderr, "short transfer: %zu of %zu bytes\n", received, msg.size() * count);
+    return static_cast<double>(received) / t / 1e9;
+}
+
+template <bool Chain>
+double run_pipe(const pl::buffer_chain& msg, std::size_t count) {
+    int fds[2];
+    if (::pipe(fds) != 0)
+        return 0;
+    return run<Chain>(fds, msg, count);
+}
+
+template <bool Chain>
+double run_socket(const pl::buffer_chain& msg, std::size_t count) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+        return 0;
+    return run<Chain>(fds, msg, count);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t total = bench::scaled(std::size_t(1) << 30, s);
+    std::printf("%zu bytes per run, %zu slices per message\n", total, pieces);
+    std::printf("%10s %12s | %14s %14s | %14s %14s\n", "slice B", "message B", "pipe writev", "pipe copy",
+                "socket writev", "socket copy");
+    for (std::size_t piece : {64, 512, 4096, 16384}) {
+        const pl::buffer_chain msg = make_message(piece);
+        const std::size_t count = std::max<std::size_t>(1, total / msg.size());
+        std::printf("%10zu %12zu | %14.2f %14.2f | %14.2f %14.2f\n", piece, msg.size(),
+                    run_pipe<true>(msg, count), run_pipe<false>(msg, count), run_socket<true>(msg, count),
+                    run_socket<false>(msg, count));
+    }
+}
@@ -0,0 +1,104 @@
+// load_delimited_file on a generated file of numeric records, by thread
+// count, against a single-threaded loop that parses each line and calls
+// push_back.  Reports GB/s.  The file is read once beforehand so every run
+// is served from the page cache.
+
+#include <p_linked_list/bulk_load.hpp>
+
+#include <unistd.h>
+
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <list>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <string_view>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+std::uint64_t parse(std::string_view s) {
+    std::uint64_t v = 0;
+    std::from_chars(s.data(), s.data() + s.size(), v);
+    return v;
+}
+
+std::size_t write_file(const char* path, std::size_t bytes) {
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) {
+        std::perror(path);
+        std::exit(1);
+    }
+    std::mt19937_64 rng(1);
+    std::size_t written = 0;
+    std::string line;
+    while (written < bytes) {
+        line = std::to_string(rng() >> (rng() % 48));
+        line += '\n';
+        std::fwrite(line.data(), 1, line.size(), f);
+        written += line.size();
+    }
+    std::fclose(f);
+    return written;
+}
+
+// The baseline: read the whole file, then parse and push_back line by line.
+std::size_t load_serial(const char* path) {
+    std::FILE* f = std::fopen(path, "r");
+    std::string data;
+    char buf[1 << 16];
+    for (std::size_t n; (n = std::fread(buf, 1, sizeof buf, f)) > 0;)
+        data.append(buf, n);
+    std::fclose(f);
+    std::list<std::uint64_t> out;
+    std::string_view rest = data;
+    while (!rest.empty()) {
+        std::size_t end = rest.find('\n');
+        out.push_back(parse(rest.substr(0, end)));
+        if (end == std::string_view::npos)
+            break;
+        rest.remove_prefix(end + 1);
+    }
+    return out.size();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    char path[] = "/tmp/p_linked_list_bulk_load_bench_XXXXXX";
+    int fd = ::mkstemp(path);
+    if (fd < 0) {
+        std::perror("mkstemp");
+        return 1;
+    }
+    ::close(fd);
+    const std::size_t bytes = write_file(path, bench::scaled(512u << 20, s));
+    const double gb = static_cast<double>(bytes) / 1e9;
+    bench::keep(load_serial(path));
+
+    std::printf("%.2f GB file, %u hardware threads\n", gb, bench::hardware_threads());
+    std::printf("serial read + push_back: %.2f GB/s\n", gb / bench::seconds([&] { bench::keep(load_serial(path)); }));
+    std::printf("%8s %10s %10s\n", "threads", "GB/s", "speedup");
+    double base = 0;
+    for (unsigned threads : bench::thread_counts(bench::hardware_threads())) {
+        std::pmr::synchronized_pool_resource pool;
+        std::size_t records = 0;
+        const double t = bench::seconds([&] {
+            auto l = pl::load_delimited_file<std::uint64_t>(path, parse, &pool, {threads, '\n'});
+            records = l.size();
+        });
+        bench::keep(records);
+        const double rate = gb / t;
+        if (base == 0)
+            base = rate;
+        std::printf("%8u %10.2f %10.2f\n", threads, rate, rate / base);
+    }
+    ::unlink(path);
+}
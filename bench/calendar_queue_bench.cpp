@@ -0,0 +1,94 @@
+// Classic hold-model benchmark: with N events queued, each hold pops the
+// earliest event and schedules a new one a random increment later.
+// calendar_queue is compared with std::priority_queue as a binary min-heap
+// for N from 10^2 to 10^6 and several increment distributions.  Reports ns
+// per hold.
+
+#include <p_linked_list/calendar_queue.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+struct later {
+    bool operator()(const std::pair<double, std::uint64_t>& a, const std::pair<double, std::uint64_t>& b) const {
+        return a.first > b.first;
+    }
+};
+
+using heap = std::priority_queue<std::pair<double, std::uint64_t>, std::vector<std::pair<double, std::uint64_t>>, later>;
+
+template <class Dist>
+double hold_calendar(std::size_t n, std::size_t holds, Dist dist) {
+    std::mt19937_64 rng(1);
+    pl::calendar_queue<std::uint64_t> q;
+    for (std::size_t i = 0; i < n; ++i)
+        q.push(dist(rng), i);
+    // Warm up so the calendar has settled on a width.
+    for (std::size_t i = 0; i < n; ++i) {
+        auto [t, v] = q.pop();
+        q.push(t + dist(rng), v);
+    }
+    const double s = bench::seconds([&] {
+        for (std::size_t i = 0; i < holds; ++i) {
+            auto [t, v] = q.pop();
+            q.push(t + dist(rng), v);
+        }
+    });
+    return s / static_cast<double>(holds) * 1e9;
+}
+
+template <class Dist>
+double hold_heap(std::size_t n, std::size_t holds, Dist dist) {
+    std::mt19937_64 rng(1);
+    heap q;
+    for (std::size_t i = 0; i < n; ++i)
+        q.emplace(dist(rng), i);
+    for (std::size_t i = 0; i < n; ++i) {
+        auto [t, v] = q.top();
+        q.pop();
+        q.emplace(t + dist(rng), v);
+    }
+    const double s = bench::seconds([&] {
+        for (std::size_t i = 0; i < holds; ++i) {
+            auto [t, v] = q.top();
+            q.pop();
+            q.emplace(t + dist(rng), v);
+        }
+    });
+    return s / static_cast<double>(holds) * 1e9;
+}
+
+template <class Dist>
+void row(const char* name, std::size_t n, std::size_t holds, Dist dist) {
+    std::printf("%-14s %9zu %14.1f %14.1f\n", name, n, hold_calendar(n, holds, dist), hold_heap(n, holds, dist));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t holds = bench::scaled(2'000'000, s);
+    std::printf("%zu holds per run\n", holds);
+    std::printf("%-14s %9s %14s %14s\n", "increment", "events", "calendar ns", "binary heap ns");
+    for (std::size_t n : {100u, 10'000u, 1'000'000u}) {
+        n = bench::scaled(n, s);
+        row("exponential", n, holds, std::exponential_distribution<double>(1.0));
+        row("uniform 0-2", n, holds, std::uniform_real_distribution<double>(0.0, 2.0));
+        row("bimodal", n, holds, [u = std::uniform_real_distribution<double>(0.0, 1.0)](std::mt19937_64& r) mutable {
+            return r() % 10 ? u(r) * 0.1 : u(r) * 100;
+        });
+        row("triangular", n, holds, [u = std::uniform_real_distribution<double>(0.0, 1.0)](std::mt19937_64& r) mutable {
+            return u(r) + u(r);
+        });
+    }
+}
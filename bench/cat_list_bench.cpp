@@ -0,0 +1,91 @@
+// Building output by concatenating many small immutable lists, then
+// consuming it from the front.  cat_list is compared with a persistent
+// cons-list, whose concatenation must copy its left operand.
+
+#include <p_linked_list/cat_list.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// Minimal persistent cons-list with shared tails.
+struct cons {
+    std::uint64_t head;
+    std::shared_ptr<const cons> tail;
+};
+using cons_list = std::shared_ptr<const cons>;
+
+// Iterative copy of `a` in front of `b`, so long left operands do not
+// overflow the stack.
+cons_list concat(const cons_list& a, const cons_list& b) {
+    std::vector<std::uint64_t> heads;
+    for (const cons* c = a.get(); c; c = c->tail.get())
+        heads.push_back(c->head);
+    cons_list out = b;
+    for (std::size_t i = heads.size(); i-- > 0;)
+        out = std::make_shared<const cons>(cons{heads[i], out});
+    return out;
+}
+
+void release(cons_list l) {
+    // Unwind iteratively; the default destructor recurses per node.
+    while (l && l.use_count() == 1)
+        l = l->tail;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t chunk = 16;
+    std::printf("%10s %16s %16s %16s\n", "chunks", "cons-list ms", "cat_list ms", "cat_list pop ns");
+    // The cons-list is quadratic, so it only runs the smaller sizes.
+    const std::size_t cons_limit = bench::scaled(2000, s);
+    for (std::size_t chunks : {125, 500, 2000, 8000, 32000}) {
+        chunks = bench::scaled(chunks, s);
+        cons_list piece;
+        pl::cat_list<std::uint64_t> cpiece;
+        for (std::size_t i = 0; i < chunk; ++i) {
+            piece = std::make_shared<const cons>(cons{i, piece});
+            cpiece = cpiece.push_back(i);
+        }
+
+        double t_cons = -1;
+        if (chunks <= cons_limit) {
+            t_cons = bench::seconds([&] {
+                cons_list out;
+                for (std::size_t c = 0; c < chunks; ++c)
+                    out = concat(out, piece);
+                bench::keep(out.get());
+                release(std::move(out));
+            });
+        }
+
+        pl::cat_list<std::uint64_t> out;
+        double t_cat = bench::seconds([&] {
+            for (std::size_t c = 0; c < chunks; ++c)
+                out = out + cpiece;
+        });
+        std::uint64_t sum = 0;
+        const std::size_t n = out.size();
+        double t_pop = bench::seconds([&] {
+            while (!out.empty()) {
+                sum += out.front();
+                out = out.pop_front();
+            }
+        });
+        bench::keep(sum);
+        std::printf("%10zu ", chunks);
+        if (t_cons >= 0)
+            std::printf("%16.2f", t_cons * 1e3);
+        else
+            std::printf("%16s", "-");
+        std::printf(" %16.3f %16.1f\n", t_cat * 1e3, t_pop * 1e9 / static_cast<double>(n));
+    }
+}
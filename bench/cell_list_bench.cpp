@@ -0,0 +1,95 @@
+// Steps per second of a toy particle simulation: 10^6 particles at
+// Lennard-Jones liquid density in a closed box, cutoff 1.5 (about eleven
+// neighbours each).  Every step displaces each particle by a small random
+// amount, rebins, and accumulates a pair term over all pairs within the
+// cutoff.  Rebinning is either update(), which relinks only the particles
+// that changed cell, or a full counting-sort rebuild() at each thread
+// count.  Reports ms per step for binning and for the pair pass, and the
+// resulting steps per second.
+
+#include <p_linked_list/cell_list.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+using cells = pl::cell_list<double>;
+using vec = cells::vec;
+
+void drift(std::vector<vec>& p, double side, double sigma, std::mt19937_64& rng) {
+    std::normal_distribution<double> step(0.0, sigma);
+    for (auto& v : p) {
+        for (double& x : v)
+            x = std::clamp(x + step(rng), 0.0, side);
+    }
+}
+
+double pair_pass(const cells& c, const std::vector<vec>& p) {
+    double energy = 0;
+    c.for_each_pair(std::span<const vec>(p), [&](std::uint32_t i, std::uint32_t j) {
+        double r2 = 0;
+        for (int k = 0; k < 3; ++k)
+            r2 += (p[i][k] - p[j][k]) * (p[i][k] - p[j][k]);
+        const double inv6 = 1.0 / (r2 * r2 * r2 + 1e-12);
+        energy += inv6 * inv6 - inv6;
+    });
+    return energy;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t n = bench::scaled(1'000'000, s);
+    const double density = 0.8, cutoff = 1.5, sigma = 0.03;
+    const double side = std::cbrt(static_cast<double>(n) / density);
+    const int steps = 10;
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> u(0.0, side);
+    std::vector<vec> initial(n);
+    for (auto& v : initial)
+        v = {u(rng), u(rng), u(rng)};
+
+    {
+        cells c({0, 0, 0}, {side, side, side}, cutoff);
+        std::printf("%zu particles, box %.1f, %zu cells, %d steps\n", n, side, c.cell_count(), steps);
+    }
+    std::printf("%-16s %10s %12s %12s %12s\n", "binning", "relinked %", "bin ms", "pairs ms", "steps/s");
+
+    auto run = [&](const char* name, auto bin) {
+        std::vector<vec> p = initial;
+        cells c({0, 0, 0}, {side, side, side}, cutoff);
+        c.rebuild(p);
+        std::mt19937_64 step_rng(2);
+        double t_bin = 0, t_pairs = 0, energy = 0;
+        std::size_t moved = 0;
+        for (int k = 0; k < steps; ++k) {
+            drift(p, side, sigma, step_rng);
+            t_bin += bench::seconds([&] { moved += bin(c, p); });
+            t_pairs += bench::seconds([&] { energy += pair_pass(c, p); });
+        }
+        bench::keep(energy);
+        std::printf("%-16s %10.2f %12.2f %12.2f %12.2f\n", name,
+                    100.0 * static_cast<double>(moved) / static_cast<double>(n * steps), t_bin * 1e3 / steps,
+                    t_pairs * 1e3 / steps, steps / (t_bin + t_pairs));
+    };
+
+    run("update", [](cells& c, const std::vector<vec>& p) { return c.update(p); });
+    for (unsigned threads : bench::thread_counts(bench::hardware_threads())) {
+        char name[32];
+        std::snprintf(name, sizeof name, "rebuild %u thr", threads);
+        run(name, [threads](cells& c, const std::vector<vec>& p) {
+            c.rebuild(p, threads);
+            return p.size();
+        });
+    }
+}
@@ -0,0 +1,148 @@
+// Select latency over 2 to 32 channels.  A coordinator blocks in select()
+// over N unbuffered channels; a producer sends a timestamp on a random one,
+// waits until the coordinator has taken it, and repeats.  The baseline is a
+// coordinator that polls N mutex-protected deques in turn, yielding between
+// sweeps.  Reports p50 and p99 send-to-receive latency in microseconds and
+// the CPU seconds the coordinator burned, mostly while waiting.
+
+#include <p_linked_list/channel.hpp>
+
+#include <sys/resource.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+using stamp = std::int64_t;
+
+stamp now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(bench::clock::now().time_since_epoch()).count();
+}
+
+double thread_cpu_seconds() {
+    rusage u{};
+    ::getrusage(RUSAGE_THREAD, &u);
+    return static_cast<double>(u.ru_utime.tv_sec + u.ru_stime.tv_sec) +
+           static_cast<double>(u.ru_utime.tv_usec + u.ru_stime.tv_usec) / 1e6;
+}
+
+struct result {
+    double p50, p99, cpu;
+};
+
+// The producer side shared by both variants: `send(i, t)` posts timestamp t
+// on queue i; the coordinator bumps `taken` after each receive.
+template <class Send>
+void produce(std::size_t n, std::size_t messages, std::atomic<std::size_t>& taken, Send send) {
+    std::mt19937 rng(1);
+    for (std::size_t m = 0; m < messages; ++m) {
+        send(rng() % n, now_ns());
+        while (taken.load(std::memory_order_acquire) <= m)
+            std::this_thread::yield();
+        // Leave the coordinator idle for a moment so it really waits.
+        const auto until = bench::clock::now() + std::chrono::microseconds(50);
+        while (bench::clock::now() < until)
+            std::this_thread::yield();
+    }
+}
+
+template <std::size_t N, std::size_t... I>
+result run_select(std::size_t messages, std::index_sequence<I...>) {
+    std::array<pl::channel<stamp>, N> chans;  // unbuffered
+    std::atomic<std::size_t> taken{0};
+    std::vector<double> lat;
+    double cpu = 0;
+    std::thread coordinator([&] {
+        const double c0 = thread_cpu_seconds();
+        for (std::size_t m = 0; m < messages; ++m) {
+            std::array<pl::recv_case<stamp>, N> cases{pl::recv_case<stamp>(chans[I])...};
+            const std::size_t i = pl::select(cases[I]...);
+            lat.push_back(static_cast<double>(now_ns() - *cases[i].value) / 1e3);
+            taken.store(m + 1, std::memory_order_release);
+        }
+        cpu = thread_cpu_seconds() - c0;
+    });
+    produce(N, messages, taken, [&](std::size_t i, stamp t) { chans[i].send(t); });
+    coordinator.join();
+    const double p50 = bench::percentile(lat, 50);
+    return {p50, bench::percentile(lat, 99), cpu};
+}
+
+struct locked_queue {
+    std::mutex m;
+    std::deque<stamp> q;
+};
+
+result run_polling(std::size_t n, std::size_t messages) {
+    std::vector<locked_queue> queues(n);
+    std::atomic<std::size_t> taken{0};
+    std::vector<double> lat;
+    double cpu = 0;
+    std::thread coordinator([&] {
+        const double c0 = thread_cpu_seconds();
+        for (std::size_t m = 0; m < messages;) {
+            bool got = false;
+            for (auto& q : queues) {
+                std::optional<stamp> v;
+                {
+                    std::lock_guard<std::mutex> lock(q.m);
+                    if (!q.q.empty()) {
+                        v = q.q.front();
+                        q.q.pop_front();
+                    }
+                }
+                if (v) {
+                    lat.push_back(static_cast<double>(now_ns() - *v) / 1e3);
+                    taken.store(++m, std::memory_order_release);
+                    got = true;
+                }
+            }
+            if (!got)
+                std::this_thread::yield();
+        }
+        cpu = thread_cpu_seconds() - c0;
+    });
+    produce(n, messages, taken, [&](std::size_t i, stamp t) {
+        std::lock_guard<std::mutex> lock(queues[i].m);
+        queues[i].q.push_back(t);
+    });
+    coordinator.join();
+    const double p50 = bench::percentile(lat, 50);
+    return {p50, bench::percentile(lat, 99), cpu};
+}
+
+template <std::size_t N>
+void row(std::size_t messages) {
+    const result a = run_select<N>(messages, std::make_index_sequence<N>());
+    const result b = run_polling(N, messages);
+    std::printf("%9zu | %9.1f %9.1f %9.3f | %9.1f %9.1f %9.3f\n", N, a.p50, a.p99, a.cpu, b.p50, b.p99, b.cpu);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t messages = bench::scaled(20000, s);
+    std::printf("%zu messages per run, 50 us idle gap between them\n", messages);
+    std::printf("%9s | %9s %9s %9s | %9s %9s %9s\n", "channels", "sel p50", "sel p99", "sel cpu", "poll p50",
+                "poll p99", "poll cpu");
+    row<2>(messages);
+    row<4>(messages);
+    row<8>(messages);
+    row<16>(messages);
+    row<32>(messages);
+}
@@ -0,0 +1,49 @@
+// Replaces the global allocation functions with counting ones.  Include it
+// in exactly one translation unit of a benchmark and read
+// bench::allocations, and bench::allocated_bytes for the usable size of
+// every block handed out (malloc's rounding included, frees not subtracted).
+
+#ifndef P_LINKED_LIST_BENCH_COUNT_ALLOCATIONS_HPP
+#define P_LINKED_LIST_BENCH_COUNT_ALLOCATIONS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace bench {
+
+inline std::atomic<std::size_t> allocations{0};
+inline std::atomic<std::size_t> allocated_bytes{0};
+
+inline void* counted(void* p) {
+    if (!p)
+        throw std::bad_alloc();
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(::malloc_usable_size(p), std::memory_order_relaxed);
+    return p;
+}
+
+} // namespace bench
+
+void* operator new(std::size_t n) { return bench::counted(std::malloc(n ? n : 1)); }
+
+void* operator new(std::size_t n, std::align_val_t a) {
+    std::size_t align = static_cast<std::size_t>(a);
+    return bench::counted(std::aligned_alloc(align, (n + align - 1) / align * align));
+}
+
+void* operator new[](std::size_t n) { return ::operator new(n); }
+void* operator new[](std::size_t n, std::align_val_t a) { return ::operator new(n, a); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#endif
@@ -0,0 +1,140 @@
+// Dancing Links on the two classic suites.  Sudoku: a handful of hard
+// published puzzles, time to the first solution with one thread and with
+// every hardware thread.  Pentominoes: rectangles of area 60, time to the
+// first tiling for each thread count, and the time to count every tiling
+// with one thread.
+
+#include <p_linked_list/exact_cover.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// Standard encoding: cell, row-digit, column-digit and box-digit
+// constraints; the givens only get the row for their digit.
+pl::exact_cover sudoku(const std::string& puzzle) {
+    pl::exact_cover x(324);
+    for (std::size_t cell = 0; cell < 81; ++cell) {
+        const std::size_t r = cell / 9, c = cell % 9, b = r / 3 * 3 + c / 3;
+        for (int d = 1; d <= 9; ++d) {
+            if (puzzle[cell] != '.' && puzzle[cell] - '0' != d)
+                continue;
+            const auto k = static_cast<std::size_t>(d - 1);
+            x.add_row({cell, 81 + r * 9 + k, 162 + c * 9 + k, 243 + b * 9 + k});
+        }
+    }
+    return x;
+}
+
+// The twelve pentominoes, each as five (row, column) cells.
+using shape = std::array<std::pair<int, int>, 5>;
+const shape pentominoes[12] = {
+    {{{0, 1}, {0, 2}, {1, 0}, {1, 1}, {2, 1}}}, {{{0, 0}, {0, 1}, {0, 2}, {0, 3}, {0, 4}}},
+    {{{0, 0}, {1, 0}, {2, 0}, {3, 0}, {3, 1}}}, {{{0, 1}, {1, 1}, {2, 0}, {2, 1}, {3, 0}}},
+    {{{0, 0}, {0, 1}, {1, 0}, {1, 1}, {2, 0}}}, {{{0, 0}, {0, 1}, {0, 2}, {1, 1}, {2, 1}}},
+    {{{0, 0}, {0, 2}, {1, 0}, {1, 1}, {1, 2}}}, {{{0, 0}, {1, 0}, {2, 0}, {2, 1}, {2, 2}}},
+    {{{0, 0}, {1, 0}, {1, 1}, {2, 1}, {2, 2}}}, {{{0, 1}, {1, 0}, {1, 1}, {1, 2}, {2, 1}}},
+    {{{0, 1}, {1, 0}, {1, 1}, {2, 1}, {3, 1}}}, {{{0, 0}, {0, 1}, {1, 1}, {2, 1}, {2, 2}}},
+};
+
+// Every placement of every piece, in every distinct orientation, on a
+// height x width board; columns are the 12 pieces and then the cells.
+pl::exact_cover pentomino_board(int height, int width) {
+    pl::exact_cover x(12 + static_cast<std::size_t>(height * width));
+    for (std::size_t p = 0; p < 12; ++p) {
+        std::set<shape> orientations;
+        for (int o = 0; o < 8; ++o) {
+            shape s = pentominoes[p];
+            for (auto& [r, c] : s) {
+                if (o & 1)
+                    std::swap(r, c);
+                if (o & 2)
+                    r = -r;
+                if (o & 4)
+                    c = -c;
+            }
+            const int r0 = std::min_element(s.begin(), s.end())->first;
+            int c0 = s[0].second;
+            for (auto& cell : s)
+                c0 = std::min(c0, cell.second);
+            for (auto& [r, c] : s) {
+                r -= r0;
+                c -= c0;
+            }
+            std::sort(s.begin(), s.end());
+            orientations.insert(s);
+        }
+        for (const shape& s : orientations) {
+            for (int dr = 0; dr < height; ++dr) {
+                for (int dc = 0; dc < width; ++dc) {
+                    std::vector<std::size_t> row = {p};
+                    for (auto [r, c] : s) {
+                        if (r + dr >= height || c + dc >= width)
+                            break;
+                        row.push_back(12 + static_cast<std::size_t>((r + dr) * width + c + dc));
+                    }
+                    if (row.size() == 6)
+                        x.add_row(row);
+                }
+            }
+        }
+    }
+    return x;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const unsigned hw = bench::hardware_threads();
+    const char* puzzles[] = {
+        "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......",
+        "52...6.........7.13...........4..8..6......5...........418.........3..2...87.....",
+        "6.....8.3.4.7.................5.4.7.3..2.....1.6.......2.....5.....8.6......1....",
+        "48.3............71.2.......7.5....6....2..8.............1.76...3.....4......5....",
+        "..............3.85..1.2.......5.7.....4...1...9.......5......73..2.1........4...9",
+    };
+    std::printf("%-10s %14s %10u thr us\n", "sudoku", "1 thread us", hw);
+    for (std::size_t i = 0; i < std::size(puzzles); ++i) {
+        double t1 = 0, tn = 0;
+        const int reps = static_cast<int>(bench::scaled(20, s));
+        for (int r = 0; r < reps; ++r) {
+            pl::exact_cover a = sudoku(puzzles[i]);
+            pl::exact_cover b = sudoku(puzzles[i]);
+            t1 += bench::seconds([&] { bench::keep(a.solve(1).has_value()); });
+            tn += bench::seconds([&] { bench::keep(b.solve(hw).has_value()); });
+        }
+        std::printf("puzzle %-3zu %14.1f %14.1f\n", i + 1, t1 * 1e6 / reps, tn * 1e6 / reps);
+    }
+
+    std::printf("\n%-8s %8s %18s\n", "board", "threads", "first tiling ms");
+    const std::pair<int, int> boards[] = {{3, 20}, {4, 15}, {5, 12}, {6, 10}};
+    for (auto [h, w] : boards) {
+        for (unsigned threads : bench::thread_counts(hw)) {
+            pl::exact_cover x = pentomino_board(h, w);
+            const double t = bench::seconds([&] { bench::keep(x.solve(threads).has_value()); });
+            std::printf("%2d x %-3d %8u %18.2f\n", h, w, threads, t * 1e3);
+        }
+    }
+    // Counting every tiling of the larger boards takes seconds, so they
+    // only run at full scale.
+    std::printf("\n%-8s %10s %14s\n", "board", "tilings", "count ms");
+    for (auto [h, w] : boards) {
+        if (h > 3 && s < 1)
+            continue;
+        pl::exact_cover x = pentomino_board(h, w);
+        std::size_t n = 0;
+        const double t = bench::seconds([&] { n = x.count_solutions(); });
+        std::printf("%2d x %-3d %10zu %14.1f\n", h, w, n, t * 1e3);
+    }
+}
@@ -0,0 +1,222 @@
+// Extent tracking with millions of extents.
+//
+// Ranges: random coalescing inserts and splitting erases over n extents.
+// extent_set is compared with a std::map from start to end, and with the
+// sorted linked list of intervals that walks from the front on every
+// operation, which only runs at the smaller sizes.  Every extent_set change
+// also updates its (length, start) index for best fit, a second tree the
+// plain map does not keep, so the map wins here by a constant factor.
+//
+// Allocation: a free-space map of n mostly small extents with one in ten
+// thousand large, serving requests of which one in ten is large.  Every
+// allocation is freed again straight away, so the map keeps its shape.
+// extent_set's first fit and best fit are compared with a first-fit scan
+// of the std::map.  Reports ns per operation.
+
+#include <p_linked_list/extent_set.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <map>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+using key = std::uint64_t;
+
+// Coalescing interval map keyed by start.
+class map_set {
+public:
+    void insert(key start, key end) {
+        auto it = map_.upper_bound(start);
+        if (it != map_.begin() && std::prev(it)->second >= start) {
+            --it;
+            start = it->first;
+            end = std::max(end, it->second);
+        }
+        while (it != map_.end() && it->first <= end) {
+            end = std::max(end, it->second);
+            it = map_.erase(it);
+        }
+        map_.emplace_hint(it, start, end);
+    }
+
+    void erase(key start, key end) {
+        auto it = map_.upper_bound(start);
+        if (it != map_.begin() && std::prev(it)->second > start) {
+            --it;
+            const key old_end = it->second;
+            if (it->first < start) {
+                it->second = start;
+                ++it;
+            } else {
+                it = map_.erase(it);
+            }
+            if (old_end > end) {
+                map_.emplace_hint(it, end, old_end);
+                return;
+            }
+        }
+        while (it != map_.end() && it->first < end) {
+            if (it->second > end) {
+                key e = it->second;
+                map_.erase(it);
+                map_.emplace(end, e);
+                return;
+            }
+            it = map_.erase(it);
+        }
+    }
+
+    std::optional<key> allocate_first_fit(key length) {
+        for (auto& [s, e] : map_) {
+            if (e - s >= length) {
+                key at = s;
+                erase(at, at + length);
+                return at;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::size_t size() const { return map_.size(); }
+
+private:
+    std::map<key, key> map_;
+};
+
+// The sorted linked list of intervals the request started from.
+class list_set {
+public:
+    void insert(key start, key end) {
+        auto it = list_.begin();
+        while (it != list_.end() && it->second < start)
+            ++it;
+        while (it != list_.end() && it->first <= end) {
+            start = std::min(start, it->first);
+            end = std::max(end, it->second);
+            it = list_.erase(it);
+        }
+        list_.emplace(it, start, end);
+    }
+
+    void erase(key start, key end) {
+        auto it = list_.begin();
+        while (it != list_.end() && it->second <= start)
+            ++it;
+        while (it != list_.end() && it->first < end) {
+            auto [s, e] = *it;
+            it = list_.erase(it);
+            if (s < start)
+                list_.emplace(it, s, start);
+            if (e > end)
+                it = list_.emplace(it, end, e);
+        }
+    }
+
+private:
+    std::list<std::pair<key, key>> list_;
+};
+
+// Extents [4i, 4i + 2); ops fill or reopen the gap after a random extent.
+template <class Set>
+double ranges(Set& set, std::size_t n, std::size_t ops) {
+    for (std::size_t i = 0; i < n; ++i)
+        set.insert(4 * i, 4 * i + 2);
+    std::mt19937_64 rng(1);
+    double t = bench::seconds([&] {
+        for (std::size_t k = 0; k < ops; ++k) {
+            const key i = rng() % n;
+            if (rng() % 2)
+                set.insert(4 * i + 2, 4 * i + 4);
+            else
+                set.erase(4 * i + 1, 4 * i + 4);
+        }
+    });
+    return t * 1e9 / static_cast<double>(ops);
+}
+
+template <class Set, class Allocate>
+double allocation(std::size_t n, std::size_t ops, Allocate allocate) {
+    Set set;
+    std::mt19937_64 rng(2);
+    key at = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const key len = rng() % 10000 == 0 ? 256 + rng() % 768 : 1 + rng() % 16;
+        set.insert(at, at + len);
+        at += len + 1 + rng() % 8;
+    }
+    std::size_t failed = 0;
+    double t = bench::seconds([&] {
+        for (std::size_t k = 0; k < ops; ++k) {
+            const key len = rng() % 10 == 0 ? 200 : 1 + rng() % 8;
+            if (auto got = allocate(set, len))
+                set.insert(*got, *got + len);
+            else
+                ++failed;
+        }
+    });
+    bench::keep(failed);
+    return t * 1e9 / static_cast<double>(ops);
+}
+
+void print_cell(double ns) {
+    if (ns >= 0)
+        std::printf(" %14.1f", ns);
+    else
+        std::printf(" %14s", "-");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t ops = bench::scaled(1'000'000, s);
+    // The linked list walks half of it per operation on average.
+    const std::size_t list_limit = bench::scaled(20'000, s);
+    const std::size_t sizes[] = {10'000, 100'000, 1'000'000, 4'000'000};
+
+    std::printf("ranges, ns/op\n%10s %14s %14s %14s\n", "extents", "extent_set", "std::map", "linked list");
+    for (std::size_t n : sizes) {
+        n = bench::scaled(n, s);
+        pl::extent_set<key> a;
+        map_set b;
+        const double ta = ranges(a, n, ops);
+        const double tb = ranges(b, n, ops);
+        double tc = -1;
+        if (n <= list_limit) {
+            list_set c;
+            tc = ranges(c, n, ops / 100);
+        }
+        std::printf("%10zu", n);
+        print_cell(ta);
+        print_cell(tb);
+        print_cell(tc);
+        std::printf("\n");
+    }
+
+    std::printf("\nallocation, ns/op\n%10s %14s %14s %14s\n", "extents", "first fit", "best fit",
+                "std::map scan");
+    for (std::size_t n : sizes) {
+        n = bench::scaled(n, s);
+        const double first = allocation<pl::extent_set<key>>(
+            n, ops, [](auto& set, key len) { return set.allocate_first_fit(len); });
+        const double best = allocation<pl::extent_set<key>>(
+            n, ops, [](auto& set, key len) { return set.allocate_best_fit(len); });
+        const double scan =
+            allocation<map_set>(n, ops / 10, [](auto& set, key len) { return set.allocate_first_fit(len); });
+        std::printf("%10zu", n);
+        print_cell(first);
+        print_cell(best);
+        print_cell(scan);
+        std::printf("\n");
+    }
+}
@@ -0,0 +1,79 @@
+// Memory saved by hash-consing call-stack-like lists.
+//
+// Stacks are random root-to-leaf walks of a synthetic call tree, stored
+// innermost frame first so callers form shared suffixes.  The baseline keeps
+// every stack as its own std::forward_list.
+
+#include <p_linked_list/hash_cons.hpp>
+
+#include <cstdint>
+#include <forward_list>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t stacks = bench::scaled(1'000'000, s);
+    const unsigned fanout = 6;
+    const unsigned max_depth = 32;
+
+    std::mt19937_64 rng(42);
+    std::vector<std::vector<std::uint32_t>> data(stacks);
+    std::size_t frames = 0;
+    for (auto& st : data) {
+        // A frame id is a call site's position in the tree, so equal paths
+        // from the root mean equal callers.  Most calls take the hot path
+        // (child 0), as in a real profile.
+        std::uint64_t id = 1;
+        const unsigned depth = 8 + static_cast<unsigned>(rng() % (max_depth - 8));
+        for (unsigned d = 0; d < depth; ++d) {
+            st.push_back(static_cast<std::uint32_t>(id % 1'000'003));
+            id = id * fanout + (rng() % 4 == 0 ? 1 + rng() % (fanout - 1) : 0);
+        }
+        frames += st.size();
+    }
+
+    std::size_t rss0 = bench::rss_kib();
+    std::vector<std::forward_list<std::uint32_t>> plain(stacks);
+    double t_plain = bench::seconds([&] {
+        for (std::size_t i = 0; i < stacks; ++i)
+            plain[i].assign(data[i].rbegin(), data[i].rend());
+    });
+    std::size_t rss_plain = bench::rss_kib() - rss0;
+
+    rss0 = bench::rss_kib();
+    pl::hash_cons<std::uint32_t> hc;
+    std::vector<pl::hash_cons<std::uint32_t>::list> consed(stacks);
+    double t_cons = bench::seconds([&] {
+        for (std::size_t i = 0; i < stacks; ++i)
+            consed[i] = hc.from_range(data[i].rbegin(), data[i].rend());
+    });
+    std::size_t rss_cons = bench::rss_kib() - rss0;
+
+    // Equality of every stack against its neighbour.
+    std::size_t eq_plain = 0, eq_cons = 0;
+    double t_eq_plain = bench::seconds([&] {
+        for (std::size_t i = 1; i < stacks; ++i)
+            eq_plain += plain[i] == plain[i - 1];
+    });
+    double t_eq_cons = bench::seconds([&] {
+        for (std::size_t i = 1; i < stacks; ++i)
+            eq_cons += consed[i] == consed[i - 1];
+    });
+    bench::keep(eq_plain + eq_cons);
+
+    const auto& st = hc.stats();
+    std::printf("stacks %zu, frames %zu\n", stacks, frames);
+    std::printf("%-14s %12s %12s %12s %14s\n", "", "nodes", "RSS KiB", "build s", "compare ns/op");
+    std::printf("%-14s %12zu %12zu %12.3f %14.1f\n", "forward_list", frames, rss_plain, t_plain,
+                t_eq_plain * 1e9 / static_cast<double>(stacks - 1));
+    std::printf("%-14s %12zu %12zu %12.3f %14.1f\n", "hash_cons", st.nodes, rss_cons, t_cons,
+                t_eq_cons * 1e9 / static_cast<double>(stacks - 1));
+    std::printf("node bytes saved %zu (%.1f%% of %zu cons calls deduplicated)\n", st.bytes_saved(),
+                100.0 * static_cast<double>(st.cons_calls - st.nodes) / static_cast<double>(st.cons_calls),
+                st.cons_calls);
+}
@@ -0,0 +1,91 @@
+// What analyze_locality() reports for lists of growing size in three
+// layouts, next to what a full traversal actually costs.  The layouts are
+// freshly built from an arena (compact), one node in ten swapped with a
+// random one, and every node swapped (fragmented).  Reports the
+// estimated miss rate and recommendation, the cost of one default sampling
+// call, and the measured traversal time per node.
+
+#include <p_linked_list/locality.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+struct payload {
+    std::uint64_t key;
+    std::uint64_t pad[3];
+};
+
+using list = std::pmr::list<payload>;
+
+// Swaps a fraction of the nodes with nodes at random positions.  splice()
+// moves links, not nodes, so addresses stay put while the order scatters.
+void scatter(list& l, double fraction, std::mt19937_64& rng) {
+    std::vector<list::iterator> its;
+    for (auto it = l.begin(); it != l.end(); ++it)
+        its.push_back(it);
+    std::bernoulli_distribution moved(fraction);
+    for (std::size_t i = 0; i < its.size(); ++i) {
+        if (moved(rng))
+            std::swap(its[i], its[rng() % its.size()]);
+    }
+    list out(l.get_allocator());
+    for (auto it : its)
+        out.splice(out.end(), l, it);
+    l.swap(out);
+}
+
+double traverse_ns(const list& l) {
+    std::uint64_t sum = 0;
+    const int reps = 3;
+    double t = bench::seconds([&] {
+        for (int r = 0; r < reps; ++r) {
+            for (const payload& p : l)
+                sum += p.key;
+        }
+    });
+    bench::keep(sum);
+    return t * 1e9 / static_cast<double>(reps * l.size());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    std::printf("%10s %-12s %10s %10s %8s %14s %12s\n", "nodes", "layout", "est. miss", "x-page",
+                "compact?", "analyze us", "walk ns/node");
+    for (std::size_t n : {10'000, 100'000, 1'000'000, 4'000'000}) {
+        n = bench::scaled(n, s);
+        const std::pair<const char*, double> layouts[] = {{"compact", 0.0}, {"10% moved", 0.1}, {"fragmented", 1.0}};
+        for (auto [name, fraction] : layouts) {
+            // A fresh arena per list, so one list's freed nodes do not
+            // shape the next one's layout.
+            std::pmr::monotonic_buffer_resource arena;
+            std::mt19937_64 rng(n);
+            list l(&arena);
+            for (std::size_t i = 0; i < n; ++i)
+                l.push_back({i, {}});
+            if (fraction > 0)
+                scatter(l, fraction, rng);
+
+            pl::locality_report r;
+            const int calls = 100;
+            double t_analyze = bench::seconds([&] {
+                for (int c = 0; c < calls; ++c)
+                    r = pl::analyze_locality(l);
+            });
+            std::printf("%10zu %-12s %10.3f %10.3f %8s %14.1f %12.2f\n", n, name, r.estimated_miss_rate(),
+                        r.cross_page_fraction(), r.recommend_compaction ? "yes" : "no",
+                        t_analyze * 1e6 / calls, traverse_ns(l));
+        }
+    }
+}
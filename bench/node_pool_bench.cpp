@@ -0,0 +1,97 @@
+// Resident memory over time through a traffic spike and the idle period
+// after it.
+//
+// A list holds a steady base load, grows by a spike, and the spike is
+// released again.  The run is repeated with a node_pool and a background
+// pool_trimmer, with a node_pool that is never trimmed, and with the default
+// allocator.  The process RSS is sampled throughout.
+
+#include <p_linked_list/node_pool.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+struct item {
+    std::uint64_t id;
+    char payload[40];
+};
+
+using clock_ms = std::chrono::milliseconds;
+
+template <class List>
+void spike(List& l, std::size_t base, std::size_t peak, const char* name, bool trim,
+           pl::node_pool* pool) {
+    const std::size_t rss0 = bench::rss_kib();
+    std::vector<std::pair<double, std::size_t>> samples;
+    auto t0 = bench::clock::now();
+    auto sample = [&] {
+        const std::size_t rss = bench::rss_kib();
+        samples.push_back({bench::elapsed(t0), rss > rss0 ? rss - rss0 : 0});
+    };
+
+    for (std::size_t i = 0; i < base; ++i)
+        l.push_back(item{i, {}});
+    sample();
+    for (std::size_t i = 0; i < peak; ++i)
+        l.push_back(item{i, {}});
+    sample();
+    // The spike drains: everything after the base load goes.
+    l.erase(std::next(l.begin(), static_cast<std::ptrdiff_t>(base)), l.end());
+    sample();
+
+    std::optional<pl::pool_trimmer> trimmer;
+    if (trim && pool)
+        trimmer.emplace(*pool, clock_ms(50), pl::trim_policy{1});
+    for (int i = 0; i < 10; ++i) {
+        std::this_thread::sleep_for(clock_ms(50));
+        sample();
+    }
+    trimmer.reset();
+
+    std::printf("%-22s", name);
+    for (auto& s : samples)
+        std::printf(" %8zu", s.second);
+    std::printf("\n");
+    l.clear();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t base = bench::scaled(50'000, s);
+    const std::size_t peak = bench::scaled(2'000'000, s);
+
+    std::printf("RSS growth in KiB: after base load, at peak, after drain, then every 50 ms idle\n");
+    std::printf("%-22s %8s %8s %8s", "allocator", "base", "peak", "drained");
+    for (int i = 1; i <= 10; ++i)
+        std::printf(" %6dms", i * 50);
+    std::printf("\n");
+    // A std::list node is two links and the element.
+    const std::size_t node_size = sizeof(item) + 2 * sizeof(void*);
+    {
+        pl::node_pool pool(node_size);
+        std::list<item, pl::pool_allocator<item>> l{pl::pool_allocator<item>(pool)};
+        spike(l, base, peak, "node_pool + trimmer", true, &pool);
+    }
+    {
+        pl::node_pool pool(node_size);
+        std::list<item, pl::pool_allocator<item>> l{pl::pool_allocator<item>(pool)};
+        spike(l, base, peak, "node_pool, no trim", false, &pool);
+    }
+    {
+        std::list<item> l;
+        spike(l, base, peak, "std::allocator", false, nullptr);
+    }
+}
@@ -0,0 +1,138 @@
+// Emit cost with 1 to 1000 listeners.  observer_list is compared with the
+// two usual alternatives: a vector of callbacks behind a mutex held across
+// the calls, and the same vector copied under the mutex on every emit.  The
+// first table is one emitter with a fixed set of listeners.  The second
+// runs an emitter per hardware thread (at least two) while another thread
+// keeps adding and removing listeners, and reports total emits per second.
+
+#include <p_linked_list/observer_list.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+using callback = std::function<void(std::uint64_t)>;
+
+// Vector of callbacks; emit() holds the lock across the calls, or copies
+// the vector under it first.
+template <bool Copy>
+class locked_list {
+public:
+    std::uint64_t add(callback f) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.emplace_back(next_id_, std::move(f));
+        return next_id_++;
+    }
+
+    bool remove(std::uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = std::find_if(entries_.begin(), entries_.end(), [id](auto& e) { return e.first == id; });
+        if (it == entries_.end())
+            return false;
+        entries_.erase(it);
+        return true;
+    }
+
+    void emit(std::uint64_t x) {
+        if constexpr (Copy) {
+            std::vector<std::pair<std::uint64_t, callback>> copy;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                copy = entries_;
+            }
+            for (auto& e : copy)
+                e.second(x);
+        } else {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& e : entries_)
+                e.second(x);
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::pair<std::uint64_t, callback>> entries_;
+    std::uint64_t next_id_ = 1;
+};
+
+void listener(std::uint64_t x) { bench::keep(x); }
+
+template <class List>
+double emit_ns(std::size_t listeners, std::size_t emits) {
+    List list;
+    for (std::size_t i = 0; i < listeners; ++i)
+        list.add(listener);
+    double t = bench::seconds([&] {
+        for (std::size_t i = 0; i < emits; ++i)
+            list.emit(i);
+    });
+    return t * 1e9 / static_cast<double>(emits);
+}
+
+template <class List>
+double churn_emits_per_second(std::size_t listeners, unsigned emitters, double seconds) {
+    List list;
+    for (std::size_t i = 0; i < listeners; ++i)
+        list.add(listener);
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> total{0};
+    std::vector<std::jthread> threads;
+    for (unsigned t = 0; t < emitters; ++t) {
+        threads.emplace_back([&] {
+            std::uint64_t n = 0;
+            while (!stop.load(std::memory_order_relaxed))
+                list.emit(n++);
+            total.fetch_add(n);
+        });
+    }
+    threads.emplace_back([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto id = list.add(listener);
+            list.remove(id);
+            std::this_thread::yield();
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true);
+    threads.clear();
+    return static_cast<double>(total.load()) / seconds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    using observer = pl::observer_list<std::uint64_t>;
+    using locked = locked_list<false>;
+    using copying = locked_list<true>;
+
+    std::printf("one emitter, ns/emit\n%10s %16s %16s %16s\n", "listeners", "observer_list", "lock held",
+                "copy per emit");
+    for (std::size_t listeners : {1, 10, 100, 1000}) {
+        const std::size_t emits = bench::scaled(20'000'000, s) / listeners + 1;
+        std::printf("%10zu %16.1f %16.1f %16.1f\n", listeners, emit_ns<observer>(listeners, emits),
+                    emit_ns<locked>(listeners, emits), emit_ns<copying>(listeners, emits));
+    }
+
+    const unsigned emitters = std::max(2u, bench::hardware_threads());
+    const double seconds = 0.5 * s;
+    std::printf("\n%u emitters and one add/remove thread, emits/s\n%10s %16s %16s %16s\n", emitters, "listeners",
+                "observer_list", "lock held", "copy per emit");
+    for (std::size_t listeners : {1, 10, 100, 1000}) {
+        std::printf("%10zu %16.3g %16.3g %16.3g\n", listeners,
+                    churn_emits_per_second<observer>(listeners, emitters, seconds),
+                    churn_emits_per_second<locked>(listeners, emitters, seconds),
+                    churn_emits_per_second<copying>(listeners, emitters, seconds));
+    }
+}
@@ -0,0 +1,102 @@
+// poly_list against std::list<std::unique_ptr<Base>>: allocator calls and
+// time to build, and time to traverse with virtual dispatch.
+
+#include <p_linked_list/poly_list.hpp>
+
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+#include "count_allocations.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+struct shape {
+    virtual ~shape() = default;
+    virtual double area() const = 0;
+};
+
+struct circle : shape {
+    explicit circle(double radius) : r(radius) {}
+    double area() const override { return 3.14159 * r * r; }
+    double r;
+};
+
+struct rect : shape {
+    rect(double width, double height) : w(width), h(height) {}
+    double area() const override { return w * h; }
+    double w, h;
+};
+
+struct polygon : shape {
+    explicit polygon(double s) {
+        for (double& x : pts)
+            x = s;
+    }
+    double area() const override { return pts[0] * pts[1] * 0.5; }
+    double pts[12];
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t n = bench::scaled(2'000'000, bench::scale(argc, argv));
+    const int passes = 5;
+    std::vector<unsigned> kinds(n);
+    std::mt19937 rng(3);
+    for (auto& k : kinds)
+        k = rng() % 3;
+
+    std::list<std::unique_ptr<shape>> boxed;
+    bench::allocations.store(0);
+    double t_build_boxed = bench::seconds([&] {
+        for (unsigned k : kinds) {
+            if (k == 0)
+                boxed.push_back(std::make_unique<circle>(1.0));
+            else if (k == 1)
+                boxed.push_back(std::make_unique<rect>(1.0, 2.0));
+            else
+                boxed.push_back(std::make_unique<polygon>(2.0));
+        }
+    });
+    std::size_t alloc_boxed = bench::allocations.load();
+
+    pl::poly_list<shape> inline_list(1 << 20);
+    bench::allocations.store(0);
+    double t_build_inline = bench::seconds([&] {
+        for (unsigned k : kinds) {
+            if (k == 0)
+                inline_list.emplace_back<circle>(1.0);
+            else if (k == 1)
+                inline_list.emplace_back<rect>(1.0, 2.0);
+            else
+                inline_list.emplace_back<polygon>(2.0);
+        }
+    });
+    std::size_t alloc_inline = bench::allocations.load();
+
+    double sum = 0;
+    double t_walk_boxed = bench::seconds([&] {
+        for (int p = 0; p < passes; ++p)
+            for (const auto& s : boxed)
+                sum += s->area();
+    });
+    double t_walk_inline = bench::seconds([&] {
+        for (int p = 0; p < passes; ++p)
+            for (const auto& s : inline_list)
+                sum += s.area();
+    });
+    bench::keep(sum);
+
+    const double per = 1e9 / static_cast<double>(n);
+    std::printf("%zu elements, %d traversal passes\n", n, passes);
+    std::printf("%-22s %12s %14s %16s\n", "", "allocations", "build ns/elem", "traverse ns/elem");
+    std::printf("%-22s %12zu %14.1f %16.2f\n", "list<unique_ptr<Base>>", alloc_boxed, t_build_boxed * per,
+                t_walk_boxed * per / passes);
+    std::printf("%-22s %12zu %14.1f %16.2f\n", "poly_list", alloc_inline, t_build_inline * per,
+                t_walk_inline * per / passes);
+}
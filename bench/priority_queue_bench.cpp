@@ -0,0 +1,100 @@
+// Latency of urgent items under a flood of low-priority work.  Flood
+// producers keep a backlog of low-priority items queued while one producer
+// pushes timestamped urgent items; consumers pop and record how long each
+// urgent item waited.  The same run on a one-lane queue, where urgent items
+// join the back of the FIFO, shows the head-of-line blocking the lanes
+// remove.  Reports p50, p99 and max in microseconds.
+
+#include <p_linked_list/priority_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+constexpr std::uint64_t urgent_bit = std::uint64_t(1) << 63;
+
+std::uint64_t now_ns(bench::clock::time_point origin) {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(bench::clock::now() - origin).count());
+}
+
+struct result {
+    double p50, p99, max;
+};
+
+// Lanes == 1 puts urgent and flood items in the same FIFO.
+template <std::size_t Lanes>
+result run(unsigned flooders, unsigned consumers, std::size_t backlog, std::size_t urgent) {
+    pl::priority_mpmc_queue<std::uint64_t, Lanes> q;
+    constexpr std::size_t low = Lanes - 1;
+    const auto origin = bench::clock::now();
+    std::atomic<bool> stop{false};
+    std::atomic<std::size_t> received{0};
+    std::vector<std::vector<double>> samples(consumers);
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned f = 0; f < flooders; ++f) {
+            threads.emplace_back([&] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    if (q.size_approx(low) < backlog)
+                        q.push(0, low);
+                    else
+                        std::this_thread::yield();
+                }
+            });
+        }
+        for (unsigned c = 0; c < consumers; ++c) {
+            threads.emplace_back([&, c] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    auto v = q.try_pop();
+                    if (!v || !(*v & urgent_bit))
+                        continue;
+                    samples[c].push_back(static_cast<double>(now_ns(origin) - (*v & ~urgent_bit)) / 1e3);
+                    if (received.fetch_add(1) + 1 == urgent)
+                        stop.store(true);
+                }
+            });
+        }
+        // Let the backlog build before sending urgent work.
+        while (q.size_approx(low) < backlog / 2)
+            std::this_thread::yield();
+        for (std::size_t i = 0; i < urgent && !stop.load(); ++i) {
+            q.push(urgent_bit | now_ns(origin), 0);
+            const auto next = bench::clock::now() + std::chrono::microseconds(20);
+            while (bench::clock::now() < next)
+                std::this_thread::yield();
+        }
+    }
+    std::vector<double> all;
+    for (auto& s : samples)
+        all.insert(all.end(), s.begin(), s.end());
+    const double p50 = bench::percentile(all, 50);
+    return {p50, bench::percentile(all, 99), all.empty() ? 0 : all.back()};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t urgent = bench::scaled(20000, s);
+    const std::size_t backlog = 10000;
+    const unsigned hw = bench::hardware_threads();
+    const unsigned flooders = std::max(1u, hw / 4);
+    const unsigned consumers = std::max(1u, hw / 4);
+    std::printf("%zu urgent items, backlog %zu, %u flood producers, %u consumers\n", urgent, backlog, flooders,
+                consumers);
+    std::printf("%-22s %10s %10s %12s\n", "queue", "p50 us", "p99 us", "max us");
+    const result lanes = run<8>(flooders, consumers, backlog, urgent);
+    std::printf("%-22s %10.1f %10.1f %12.1f\n", "8 priority lanes", lanes.p50, lanes.p99, lanes.max);
+    const result fifo = run<1>(flooders, consumers, backlog, urgent);
+    std::printf("%-22s %10.1f %10.1f %12.1f\n", "single FIFO lane", fifo.p50, fifo.p99, fifo.max);
+}
@@ -0,0 +1,102 @@
+// Worst-case latency of a control-loop workload.  Each tick erases one
+// random element through a saved handle, moves another to the back and
+// appends one or two new elements, so the list size swings between a
+// quarter and all of its capacity.  realtime_list is compared with
+// std::list, which allocates and frees a node per element.  Reports per-tick
+// p50, p99, p99.99 and max in nanoseconds, plus the minor page faults taken
+// during the timed ticks.
+
+#include <p_linked_list/realtime_list.hpp>
+
+#include <sys/resource.h>
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+struct sample {
+    std::array<std::uint64_t, 8> data;
+};
+
+long minor_faults() {
+    rusage ru{};
+    ::getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_minflt;
+}
+
+template <class List>
+void report(const char* name, List& l, std::size_t capacity, std::size_t ticks) {
+    // The bookkeeping vectors are written in full up front so their own
+    // first-touch faults stay out of the timed ticks.
+    std::vector<typename List::iterator> handles(capacity);
+    std::vector<double> ns(ticks, 0.0);
+    std::size_t live = 0;
+    std::mt19937_64 rng(1);
+    bool growing = true;
+
+    auto append = [&](std::uint64_t v) {
+        (void)l.push_back(sample{{v}});
+        handles[live++] = std::prev(l.end());
+    };
+    for (std::size_t i = 0; i < capacity / 4; ++i)
+        append(i);
+
+    const long faults = minor_faults();
+    for (std::size_t t = 0; t < ticks; ++t) {
+        if (live + 1 >= capacity)
+            growing = false;
+        else if (live <= capacity / 4)
+            growing = true;
+        const std::size_t k = rng() % live;
+        const std::size_t j = rng() % live;
+        auto t0 = bench::clock::now();
+        l.splice(l.end(), handles[j]);
+        l.erase(handles[k]);
+        handles[k] = handles[--live];
+        append(t);
+        if (growing)
+            append(t);
+        ns[t] = static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(bench::clock::now() - t0).count());
+    }
+    const long faulted = minor_faults() - faults;
+    bench::keep(l.size());
+    const double p50 = bench::percentile(ns, 50);
+    const double p99 = bench::percentile(ns, 99);
+    const double p9999 = bench::percentile(ns, 99.99);
+    std::printf("%-14s %10.0f %10.0f %10.0f %10.0f %12ld\n", name, p50, p99, p9999, ns.back(), faulted);
+}
+
+// std::list::splice takes the source list as well.
+struct std_list : std::list<sample> {
+    void splice(iterator to, iterator pos) { std::list<sample>::splice(to, *this, pos); }
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t capacity = bench::scaled(1'000'000, s);
+    const std::size_t ticks = bench::scaled(4'000'000, s);
+    std::printf("capacity %zu, %zu ticks, %zu-byte elements\n", capacity, ticks, sizeof(sample));
+    std::printf("%-14s %10s %10s %10s %10s %12s\n", "", "p50 ns", "p99 ns", "p99.99 ns", "max ns",
+                "page faults");
+    {
+        pl::realtime_list<sample> l(capacity);
+        report("realtime_list", l, capacity, ticks);
+    }
+    {
+        std_list l;
+        report("std::list", l, capacity, ticks);
+    }
+}
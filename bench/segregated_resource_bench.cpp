@@ -0,0 +1,152 @@
+// segregated_resource against glibc malloc, and against the standard
+// synchronized_pool_resource, replaying allocation traces:
+//
+//   list      build and destroy std::pmr::list<int> of 1M nodes
+//   mixed     random alloc/free with a bounded live set, 16 B to 16 KiB,
+//             weighted towards small sizes
+//   threads   the mixed trace on every hardware thread at once
+//
+// Reports nanoseconds per allocate+deallocate pair.
+
+#include <p_linked_list/segregated_resource.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// glibc malloc behind the pmr interface.
+class malloc_resource : public std::pmr::memory_resource {
+    void* do_allocate(std::size_t n, std::size_t a) override {
+        void* p = a <= alignof(std::max_align_t) ? std::malloc(n) : std::aligned_alloc(a, (n + a - 1) / a * a);
+        if (!p)
+            throw std::bad_alloc();
+        return p;
+    }
+    void do_deallocate(void* p, std::size_t, std::size_t) override { std::free(p); }
+    bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+};
+
+// One trace step: allocate `size` into `slot`, or free `slot` if size is 0.
+struct op {
+    std::uint32_t slot;
+    std::uint32_t size;
+};
+
+std::vector<op> mixed_trace(std::size_t pairs, std::size_t live, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<op> ops;
+    std::vector<std::uint32_t> used, unused;
+    for (std::uint32_t i = 0; i < live; ++i)
+        unused.push_back(i);
+    std::size_t allocs = 0;
+    while (allocs < pairs || !used.empty()) {
+        const bool alloc = allocs < pairs && !unused.empty() && (used.empty() || rng() % 2);
+        if (alloc) {
+            const std::uint32_t slot = unused.back();
+            unused.pop_back();
+            used.push_back(slot);
+            // Mostly node-sized objects, some buffers, a few large blocks.
+            const unsigned kind = rng() % 100;
+            const std::uint32_t size = kind < 80 ? 16 + rng() % 113 : kind < 97 ? 129 + rng() % 896 : 1025 + rng() % 15360;
+            ops.push_back({slot, size});
+            ++allocs;
+        } else {
+            const std::size_t i = rng() % used.size();
+            const std::uint32_t slot = used[i];
+            used[i] = used.back();
+            used.pop_back();
+            unused.push_back(slot);
+            ops.push_back({slot, 0});
+        }
+    }
+    return ops;
+}
+
+void replay(std::pmr::memory_resource* r, const std::vector<op>& ops, std::size_t live) {
+    std::vector<void*> ptr(live);
+    std::vector<std::uint32_t> size(live);
+    for (const op& o : ops) {
+        if (o.size) {
+            ptr[o.slot] = r->allocate(o.size, 8);
+            size[o.slot] = o.size;
+            *static_cast<char*>(ptr[o.slot]) = 1;
+        } else {
+            r->deallocate(ptr[o.slot], size[o.slot], 8);
+        }
+    }
+}
+
+double list_trace(std::pmr::memory_resource* r, std::size_t n) {
+    return bench::seconds([&] {
+        std::pmr::list<int> l(r);
+        for (std::size_t i = 0; i < n; ++i)
+            l.push_back(static_cast<int>(i));
+        bench::keep(l.back());
+    }) / static_cast<double>(n) * 1e9;
+}
+
+double mixed(std::pmr::memory_resource* r, const std::vector<op>& ops, std::size_t live, std::size_t pairs) {
+    return bench::seconds([&] { replay(r, ops, live); }) / static_cast<double>(pairs) * 1e9;
+}
+
+double threaded(std::pmr::memory_resource* r, const std::vector<std::vector<op>>& traces, std::size_t live,
+                std::size_t pairs) {
+    const double t = bench::seconds([&] {
+        std::vector<std::jthread> workers;
+        for (auto& trace : traces)
+            workers.emplace_back([&] { replay(r, trace, live); });
+    });
+    // Wall time per pair of one thread's trace.
+    return t / static_cast<double>(pairs) * 1e9;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t nodes = bench::scaled(1'000'000, s);
+    const std::size_t pairs = bench::scaled(4'000'000, s);
+    const std::size_t live = 20000;
+    const unsigned threads = bench::hardware_threads();
+
+    const auto trace = mixed_trace(pairs, live, 1);
+    std::vector<std::vector<op>> traces;
+    const std::size_t per_thread = std::max<std::size_t>(1, pairs / threads);
+    for (unsigned t = 0; t < threads; ++t)
+        traces.push_back(mixed_trace(per_thread, live, t + 2));
+
+    std::printf("list %zu nodes, mixed %zu pairs (live set %zu), %u threads\n", nodes, pairs, live, threads);
+    std::printf("%-28s %10s %10s %12s\n", "resource", "list ns", "mixed ns", "threads ns");
+    auto row = [&](const char* name, auto make) {
+        double l, m, t;
+        {
+            auto r = make();
+            l = list_trace(r.get(), nodes);
+        }
+        {
+            auto r = make();
+            m = mixed(r.get(), trace, live, pairs);
+        }
+        {
+            auto r = make();
+            t = threaded(r.get(), traces, live, per_thread);
+        }
+        std::printf("%-28s %10.1f %10.1f %12.1f\n", name, l, m, t);
+    };
+    row("glibc malloc", [] { return std::make_unique<malloc_resource>(); });
+    row("segregated_resource", [] { return std::make_unique<pl::segregated_resource>(); });
+    row("synchronized_pool_resource", [] { return std::make_unique<std::pmr::synchronized_pool_resource>(); });
+}
@@ -0,0 +1,164 @@
+// Read throughput of a 16-entry table, 1 to 64 reader threads, while one
+// writer replaces an entry every 100 us.  Each read looks up one key.
+// Compares seqlock_list::find_if with a std::shared_mutex around a vector
+// and with std::atomic<std::shared_ptr<const vector>>, whose loads take a
+// lock or touch a shared reference count.  Reports millions of reads/s.
+
+#include <p_linked_list/seqlock_list.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+struct entry {
+    std::uint32_t key;
+    std::uint32_t value;
+};
+
+constexpr std::uint32_t entries = 16;
+
+class seqlock_table {
+public:
+    seqlock_table() {
+        for (std::uint32_t k = 0; k < entries; ++k)
+            list_.push_back({k, k});
+    }
+    std::optional<std::uint32_t> get(std::uint32_t k) const {
+        auto e = list_.find_if([k](const entry& x) { return x.key == k; });
+        if (!e)
+            return std::nullopt;
+        return e->value;
+    }
+    // One write section, so readers never see the key missing.
+    void set(std::uint32_t k, std::uint32_t v) {
+        auto next = list_.snapshot();
+        for (auto& e : next) {
+            if (e.key == k)
+                e.value = v;
+        }
+        list_.assign(next.begin(), next.end());
+    }
+
+private:
+    pl::seqlock_list<entry, entries> list_;
+};
+
+class rwlock_table {
+public:
+    rwlock_table() {
+        for (std::uint32_t k = 0; k < entries; ++k)
+            v_.push_back({k, k});
+    }
+    std::optional<std::uint32_t> get(std::uint32_t k) const {
+        std::shared_lock lock(m_);
+        for (auto& e : v_) {
+            if (e.key == k)
+                return e.value;
+        }
+        return std::nullopt;
+    }
+    void set(std::uint32_t k, std::uint32_t v) {
+        std::unique_lock lock(m_);
+        for (auto& e : v_) {
+            if (e.key == k)
+                e.value = v;
+        }
+    }
+
+private:
+    mutable std::shared_mutex m_;
+    std::vector<entry> v_;
+};
+
+class shared_ptr_table {
+public:
+    shared_ptr_table() {
+        auto v = std::make_shared<std::vector<entry>>();
+        for (std::uint32_t k = 0; k < entries; ++k)
+            v->push_back({k, k});
+        p_.store(std::move(v));
+    }
+    std::optional<std::uint32_t> get(std::uint32_t k) const {
+        auto v = p_.load();
+        for (auto& e : *v) {
+            if (e.key == k)
+                return e.value;
+        }
+        return std::nullopt;
+    }
+    void set(std::uint32_t k, std::uint32_t v) {
+        auto next = std::make_shared<std::vector<entry>>(*p_.load());
+        for (auto& e : *next) {
+            if (e.key == k)
+                e.value = v;
+        }
+        p_.store(std::move(next));
+    }
+
+private:
+    std::atomic<std::shared_ptr<const std::vector<entry>>> p_;
+};
+
+template <class Table>
+double run(unsigned readers, double seconds) {
+    Table t;
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> reads{0};
+    std::vector<std::jthread> threads;
+    for (unsigned r = 0; r < readers; ++r) {
+        threads.emplace_back([&, r] {
+            std::uint64_t n = 0, hits = 0;
+            std::uint32_t k = r;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < 256; ++i) {
+                    hits += t.get(k++ % entries).has_value();
+                    ++n;
+                }
+            }
+            bench::keep(hits);
+            reads.fetch_add(n);
+        });
+    }
+    threads.emplace_back([&] {
+        std::uint32_t v = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            t.set(v % entries, v);
+            ++v;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+    const auto t0 = bench::clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true);
+    threads.clear();
+    return static_cast<double>(reads.load()) / bench::elapsed(t0) / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const double seconds = 0.5 * s;
+    std::printf("%u entries, one writer every 100 us, %.2f s per run, %u hardware threads\n", entries, seconds,
+                bench::hardware_threads());
+    std::printf("%8s %16s %16s %20s\n", "readers", "seqlock Mreads/s", "rwlock Mreads/s", "shared_ptr Mreads/s");
+    for (unsigned readers : bench::thread_counts(64)) {
+        const double a = run<seqlock_table>(readers, seconds);
+        const double b = run<rwlock_table>(readers, seconds);
+        const double c = run<shared_ptr_table>(readers, seconds);
+        std::printf("%8u %16.1f %16.1f %20.1f\n", readers, a, b, c);
+    }
+}
@@ -0,0 +1,105 @@
+// Applying batches of random keyed updates to a sorted list of n elements:
+// upsert_sorted_batch() against inserting the batch one item at a time with
+// find-then-insert.  Reports ns per applied item for each list and batch
+// size.
+
+#include <p_linked_list/sorted_list.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// The payload is mutable so the per-item baseline can update it through
+// the list's const iterator.
+struct entry {
+    std::uint64_t key;
+    mutable std::uint64_t value;
+};
+
+struct by_key {
+    bool operator()(const entry& a, const entry& b) const { return a.key < b.key; }
+};
+
+using list = pl::sorted_list<entry, by_key>;
+
+void fill(list& l, std::size_t n) {
+    std::vector<entry> init(n);
+    for (std::size_t i = 0; i < n; ++i)
+        init[i] = {2 * i, 0};
+    l.insert_sorted_batch(init.begin(), init.end());
+}
+
+// Half of each batch hits existing keys, half is new.
+std::vector<entry> make_batch(std::size_t b, std::size_t n, std::mt19937_64& rng) {
+    std::vector<entry> batch(b);
+    for (auto& e : batch)
+        e = {rng() % (2 * n), 1};
+    return batch;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t rounds = 8;
+    // Per-item insertion walks the list for every item, so it only runs
+    // while n * b stays affordable.
+    const double per_item_limit = 2e9 * s;
+    std::printf("%10s %8s %18s %18s %10s\n", "n", "batch", "per-item ns/item", "batch ns/item", "speedup");
+    for (std::size_t n : {10'000, 100'000, 1'000'000}) {
+        n = bench::scaled(n, s);
+        for (std::size_t b : {10, 100, 1'000, 10'000, 100'000}) {
+            if (b > 4 * n)
+                continue;
+            std::mt19937_64 rng(n + b);
+            std::vector<std::vector<entry>> batches;
+            for (std::size_t r = 0; r < rounds; ++r)
+                batches.push_back(make_batch(b, n, rng));
+            const double items = static_cast<double>(rounds * b);
+
+            double t_item = -1;
+            if (static_cast<double>(n) * items <= per_item_limit) {
+                list l;
+                fill(l, n);
+                t_item = bench::seconds([&] {
+                    for (auto& batch : batches) {
+                        for (const entry& e : batch) {
+                            auto it = l.find(e);
+                            if (it != l.end())
+                                it->value += e.value;
+                            else
+                                l.insert(e);
+                        }
+                    }
+                });
+                bench::keep(l.size());
+            }
+
+            list l;
+            fill(l, n);
+            double t_batch = bench::seconds([&] {
+                for (auto& batch : batches)
+                    l.upsert_sorted_batch(batch.begin(), batch.end(),
+                                          [](entry& stored, entry&& in) { stored.value += in.value; });
+            });
+            bench::keep(l.size());
+
+            std::printf("%10zu %8zu ", n, b);
+            if (t_item >= 0)
+                std::printf("%18.1f", t_item * 1e9 / items);
+            else
+                std::printf("%18s", "-");
+            std::printf(" %18.1f", t_batch * 1e9 / items);
+            if (t_item >= 0)
+                std::printf(" %10.1f\n", t_item / t_batch);
+            else
+                std::printf(" %10s\n", "-");
+        }
+    }
+}
@@ -0,0 +1,135 @@
+// SpMV and snapshot maintenance on a random square matrix with 8 nonzeros
+// per row.  The first table compares walking the linked rows with SpMV on
+// the CSR snapshot for each thread count.  The second applies k changes of
+// three kinds and compares csr()'s incremental refresh with rebuilding the
+// whole CSR from the linked rows:
+//   values  - update() of existing entries, patched in place;
+//   moves   - an entry erased and another inserted in the same row, so row
+//             lengths stay put;
+//   inserts - new entries, which shift everything after the first grown row.
+// The first few shifts after the snapshot is built also grow its two pairs
+// of arrays, so the table starts after some warm-up inserts.
+
+#include <p_linked_list/sparse_matrix.hpp>
+
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+using matrix = pl::sparse_matrix<double>;
+
+void fill(matrix& m, std::size_t per_row, std::mt19937_64& rng) {
+    for (std::size_t r = 0; r < m.rows(); ++r) {
+        for (std::size_t k = 0; k < per_row; ++k)
+            m.set(r, rng() % m.cols(), 1.0 + static_cast<double>(rng() % 100) / 100);
+    }
+}
+
+void linked_multiply(const matrix& m, const std::vector<double>& x, std::vector<double>& y) {
+    for (std::size_t r = 0; r < m.rows(); ++r) {
+        double sum = 0;
+        for (auto e = m.row_begin(r); e; e = e.next_in_row())
+            sum += e.value() * x[e.col()];
+        y[r] = sum;
+    }
+}
+
+// What a caller without the cached snapshot does after every change.
+struct rebuilt_csr {
+    std::vector<std::size_t> row_ptr, col_idx;
+    std::vector<double> values;
+};
+
+void rebuild(const matrix& m, rebuilt_csr& out) {
+    out.row_ptr.assign(1, 0);
+    out.col_idx.clear();
+    out.values.clear();
+    for (std::size_t r = 0; r < m.rows(); ++r) {
+        for (auto e = m.row_begin(r); e; e = e.next_in_row()) {
+            out.col_idx.push_back(e.col());
+            out.values.push_back(e.value());
+        }
+        out.row_ptr.push_back(out.col_idx.size());
+    }
+}
+
+// Applies k changes of the given kind at random rows.
+void change(matrix& m, const char* kind, std::size_t k, std::mt19937_64& rng) {
+    const std::string_view what = kind;
+    for (std::size_t i = 0; i < k; ++i) {
+        const std::size_t r = rng() % m.rows();
+        auto e = m.row_begin(r);
+        if (what == "values") {
+            if (e)
+                m.update(e, e.value() + 1);
+        } else if (what == "moves") {
+            if (!e)
+                continue;
+            const std::size_t c = rng() % m.cols();
+            if (m.find(r, c))
+                continue;
+            const double v = e.value();
+            m.erase(e);
+            m.set(r, c, v);
+        } else {
+            m.set(r, rng() % m.cols(), 1.0);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t n = bench::scaled(1'000'000, s);
+    const std::size_t per_row = 8;
+    std::mt19937_64 rng(1);
+    matrix m(n, n);
+    fill(m, per_row, rng);
+    std::vector<double> x(n, 1.0), y(n);
+    const double flops = 2.0 * static_cast<double>(m.nonzeros());
+    std::printf("%zu x %zu, %zu nonzeros\n\n", n, n, m.nonzeros());
+
+    const int reps = 5;
+    m.csr();
+    double t_linked = bench::seconds([&] {
+        for (int i = 0; i < reps; ++i)
+            linked_multiply(m, x, y);
+    }) / reps;
+    std::printf("%-16s %10s %10s\n", "SpMV", "ms", "GFLOP/s");
+    std::printf("%-16s %10.2f %10.2f\n", "linked rows", t_linked * 1e3, flops / t_linked / 1e9);
+    for (unsigned threads : bench::thread_counts(bench::hardware_threads())) {
+        double t = bench::seconds([&] {
+            for (int i = 0; i < reps; ++i)
+                m.multiply(x, y, threads);
+        }) / reps;
+        std::printf("csr %2u thread%s  %10.2f %10.2f\n", threads, threads == 1 ? " " : "s", t * 1e3,
+                    flops / t / 1e9);
+    }
+    bench::keep(y[0]);
+
+    // Second rebuild timed, so the baseline reuses warm vectors.
+    rebuilt_csr full;
+    rebuild(m, full);
+    const double t_rebuild = bench::seconds([&] { rebuild(m, full); });
+    std::printf("\nfull CSR rebuild: %.2f ms\n", t_rebuild * 1e3);
+    for (int i = 0; i < 4; ++i) {
+        change(m, "inserts", 1, rng);
+        m.csr();
+    }
+    std::printf("%-8s %8s %16s %12s\n", "changes", "k", "refresh ms", "vs rebuild");
+    for (const char* kind : {"values", "moves", "inserts"}) {
+        for (std::size_t k : {1, 100, 10'000}) {
+            change(m, kind, k, rng);
+            const double t = bench::seconds([&] { m.csr(); });
+            std::printf("%-8s %8zu %16.4f %11.1fx\n", kind, k, t * 1e3, t_rebuild / t);
+        }
+    }
+}
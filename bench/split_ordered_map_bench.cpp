@@ -0,0 +1,102 @@
+// split_ordered_map against a striped-lock std::unordered_map, 1 to 64
+// threads, on a 90% find / 5% insert / 5% erase mix over a preloaded key
+// space.  Reports throughput in Mops/s.
+
+#include <p_linked_list/split_ordered_map.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+class striped_map {
+public:
+    bool insert(std::uint64_t k, std::uint64_t v) {
+        stripe& s = stripe_of(k);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        return s.map.emplace(k, v).second;
+    }
+    std::optional<std::uint64_t> find(std::uint64_t k) {
+        stripe& s = stripe_of(k);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto it = s.map.find(k);
+        if (it == s.map.end())
+            return std::nullopt;
+        return it->second;
+    }
+    bool erase(std::uint64_t k) {
+        stripe& s = stripe_of(k);
+        std::lock_guard<std::mutex> lock(s.mutex);
+        return s.map.erase(k) != 0;
+    }
+
+private:
+    struct alignas(64) stripe {
+        std::mutex mutex;
+        std::unordered_map<std::uint64_t, std::uint64_t> map;
+    };
+    stripe& stripe_of(std::uint64_t k) { return stripes_[std::hash<std::uint64_t>()(k) % stripes_.size()]; }
+    std::array<stripe, 64> stripes_;
+};
+
+template <class Map>
+double run(Map& m, unsigned threads, std::size_t ops, std::uint64_t keys) {
+    std::atomic<bool> go{false};
+    std::vector<std::jthread> workers;
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937_64 rng(t + 1);
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            std::uint64_t hits = 0;
+            for (std::size_t i = 0; i < ops / threads; ++i) {
+                std::uint64_t k = rng() % keys;
+                unsigned op = static_cast<unsigned>(rng() % 100);
+                if (op < 90)
+                    hits += m.find(k).has_value();
+                else if (op < 95)
+                    m.insert(k, k);
+                else
+                    m.erase(k);
+            }
+            bench::keep(hits);
+        });
+    }
+    auto t0 = bench::clock::now();
+    go.store(true, std::memory_order_release);
+    workers.clear();
+    return static_cast<double>(ops) / bench::elapsed(t0) / 1e6;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const std::size_t ops = bench::scaled(4'000'000, s);
+    const std::uint64_t keys = bench::scaled(1'000'000, s);
+    std::printf("%zu ops, %llu keys, %u hardware threads\n", ops, static_cast<unsigned long long>(keys),
+                bench::hardware_threads());
+    std::printf("%8s %22s %22s\n", "threads", "split_ordered Mops/s", "striped-lock Mops/s");
+    for (unsigned threads : bench::thread_counts(64)) {
+        pl::split_ordered_map<std::uint64_t, std::uint64_t> a;
+        striped_map b;
+        for (std::uint64_t k = 0; k < keys; k += 2) {
+            a.insert(k, k);
+            b.insert(k, k);
+        }
+        double ra = run(a, threads, ops, keys);
+        double rb = run(b, threads, ops, keys);
+        std::printf("%8u %22.2f %22.2f\n", threads, ra, rb);
+    }
+}
@@ -0,0 +1,115 @@
+// Sliding one-second window, 10 ms buckets, fed at 10^4 to 10^7 events per
+// second of event time.  time_window keeps count, sum, mean, min and max up
+// to date; the baseline keeps the events in a std::list, drops expired ones
+// from the front and recomputes all five on each query.  Reports ns per
+// event pushed and ns per query.
+
+#include <p_linked_list/time_window.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using ns = std::chrono::nanoseconds;
+
+struct aggregates {
+    std::size_t count;
+    double sum, mean, min, max;
+};
+
+class naive_window {
+public:
+    explicit naive_window(ns window) : window_(window) {}
+
+    void push(clock_type::time_point t, double v) {
+        events_.emplace_back(t, v);
+        newest_ = t;
+    }
+
+    aggregates query() {
+        while (!events_.empty() && events_.front().first <= newest_ - window_)
+            events_.pop_front();
+        aggregates a{0, 0, 0, 0, 0};
+        for (auto& [t, v] : events_) {
+            if (a.count++ == 0)
+                a.min = a.max = v;
+            a.sum += v;
+            a.min = std::min(a.min, v);
+            a.max = std::max(a.max, v);
+        }
+        a.mean = a.count ? a.sum / static_cast<double>(a.count) : 0;
+        return a;
+    }
+
+private:
+    ns window_;
+    clock_type::time_point newest_{};
+    std::list<std::pair<clock_type::time_point, double>> events_;
+};
+
+aggregates query(const pl::time_window<double>& w) {
+    return {w.count(), w.sum(), w.mean(), w.min().value_or(0), w.max().value_or(0)};
+}
+
+struct result {
+    double push_ns, query_ns;
+};
+
+// Pushes `events` at `rate` per second of event time, querying every
+// `query_every` events.
+template <class Push, class Query>
+result run(std::size_t events, double rate, std::size_t query_every, Push push, Query q) {
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> value(0, 100);
+    const double step = 1e9 / rate;
+    const clock_type::time_point t0{};
+    double push_time = 0, query_time = 0;
+    std::size_t queries = 0;
+    for (std::size_t done = 0; done < events;) {
+        const std::size_t batch = std::min(query_every, events - done);
+        auto start = bench::clock::now();
+        for (std::size_t i = 0; i < batch; ++i, ++done)
+            push(t0 + ns(static_cast<std::int64_t>(static_cast<double>(done) * step)), value(rng));
+        push_time += bench::elapsed(start);
+        start = bench::clock::now();
+        bench::keep(q().sum);
+        query_time += bench::elapsed(start);
+        ++queries;
+    }
+    return {push_time / static_cast<double>(events) * 1e9, query_time / static_cast<double>(queries) * 1e9};
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const ns window = std::chrono::seconds(1);
+    const ns bucket = std::chrono::milliseconds(10);
+    std::printf("1 s window, 10 ms buckets, one query per 1000 events\n");
+    std::printf("%12s %10s | %14s %14s | %14s %14s\n", "events/s", "events", "window push ns", "window query ns",
+                "list push ns", "list query ns");
+    for (double rate : {1e4, 1e5, 1e6, 1e7}) {
+        // Three seconds of event time, capped so the baseline stays quick.
+        const std::size_t events = bench::scaled(static_cast<std::size_t>(std::min(3 * rate, 3e6)), s);
+        pl::time_window<double> w(window, bucket);
+        const result a = run(
+            events, rate, 1000, [&](clock_type::time_point t, double v) { w.push(t, v); },
+            [&] { return query(w); });
+        naive_window n(window);
+        const result b = run(
+            events, rate, 1000, [&](clock_type::time_point t, double v) { n.push(t, v); }, [&] { return n.query(); });
+        std::printf("%12.0f %10zu | %14.1f %14.1f | %14.1f %14.1f\n", rate, events, a.push_ns, a.query_ns, b.push_ns,
+                    b.query_ns);
+    }
+}
@@ -0,0 +1,76 @@
+// Fork-join scaling of work_stealing_pool: recursive fib with a serial
+// cutoff, and parallel quicksort of random integers that forks both halves
+// above a size cutoff.  Reports seconds and speedup over the serial code
+// for 1 thread up to every hardware thread.
+
+#include <p_linked_list/work_stealing.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "bench.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+long fib_serial(int n) { return n < 2 ? n : fib_serial(n - 1) + fib_serial(n - 2); }
+
+long fib(pl::work_stealing_pool& pool, int n) {
+    if (n < 20)
+        return fib_serial(n);
+    long a = 0, b = 0;
+    pl::parallel_invoke(pool, [&] { a = fib(pool, n - 1); }, [&] { b = fib(pool, n - 2); });
+    return a + b;
+}
+
+using iter = std::vector<std::uint32_t>::iterator;
+
+void quicksort(pl::work_stealing_pool& pool, iter first, iter last) {
+    if (last - first < 8192) {
+        std::sort(first, last);
+        return;
+    }
+    const std::uint32_t pivot = first[(last - first) / 2];
+    iter lo = std::partition(first, last, [pivot](std::uint32_t x) { return x < pivot; });
+    iter hi = std::partition(lo, last, [pivot](std::uint32_t x) { return x == pivot; });
+    pl::parallel_invoke(pool, [&] { quicksort(pool, first, lo); }, [&] { quicksort(pool, hi, last); });
+}
+
+std::vector<std::uint32_t> random_values(std::size_t n) {
+    std::mt19937 rng(1);
+    std::vector<std::uint32_t> v(n);
+    for (auto& x : v)
+        x = rng();
+    return v;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const double s = bench::scale(argc, argv);
+    const int fib_n = s >= 1 ? 40 : s >= 0.1 ? 36 : 32;
+    const std::size_t sort_n = bench::scaled(20'000'000, s);
+    const auto input = random_values(sort_n);
+
+    const double fib_base = bench::seconds([&] { bench::keep(fib_serial(fib_n)); });
+    std::vector<std::uint32_t> v = input;
+    const double sort_base = bench::seconds([&] { std::sort(v.begin(), v.end()); });
+
+    std::printf("fib(%d), quicksort of %zu values, %u hardware threads\n", fib_n, sort_n, bench::hardware_threads());
+    std::printf("serial: fib %.3f s, std::sort %.3f s\n", fib_base, sort_base);
+    std::printf("%8s %10s %10s %12s %12s\n", "threads", "fib s", "speedup", "quicksort s", "speedup");
+    for (unsigned threads : bench::thread_counts(bench::hardware_threads())) {
+        pl::work_stealing_pool pool(threads);
+        long r = 0;
+        const double tf = bench::seconds([&] { r = fib(pool, fib_n); });
+        bench::keep(r);
+        v = input;
+        const double ts = bench::seconds([&] { quicksort(pool, v.begin(), v.end()); });
+        if (!std::is_sorted(v.begin(), v.end()))
+            std::printf("quicksort produced unsorted output\n");
+        std::printf("%8u %10.3f %10.2f %12.3f %12.2f\n", threads, tf, fib_base / tf, ts, sort_base / ts);
+    }
+}
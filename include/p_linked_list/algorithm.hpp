@@ -0,0 +1,158 @@
+// Relinking list algorithms.
+//
+// Every algorithm here rearranges nodes with splice() only, so elements are
+// never copied, moved or reallocated and iterators to them stay valid.  They
+// work on any list type with std::list's splice interface.  Removed elements
+// can be spliced into a caller-supplied list instead of being destroyed, so a
+// node can be recycled without going back to the allocator.
+
+#ifndef P_LINKED_LIST_ALGORITHM_HPP
+#define P_LINKED_LIST_ALGORITHM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+
+namespace p_linked_list {
+
+// Moves every element for which `pred` is false behind those for which it is
+// true, preserving relative order in both groups.  Returns the first element
+// of the false group (or end()).
+template <class List, class Pred>
+typename List::iterator stable_partition(List& l, Pred pred) {
+    auto it = l.begin();
+    auto boundary = l.end();
+    for (std::size_t n = l.size(); n != 0; --n) {
+        auto cur = it++;
+        if (!pred(*cur)) {
+            l.splice(l.end(), l, cur);
+            if (boundary == l.end())
+                boundary = cur;
+        }
+    }
+    return boundary;
+}
+
+// Relinking makes the stable version as cheap as any other, so partition()
+// is stable as well.
+template <class List, class Pred>
+typename List::iterator partition(List& l, Pred pred) {
+    return stable_partition(l, pred);
+}
+
+// Splices all but the first of each run of equivalent adjacent elements into
+// `removed` and returns how many were removed.
+template <class List, class BinaryPred = std::equal_to<>>
+std::size_t unique(List& l, List& removed, BinaryPred eq = BinaryPred()) {
+    std::size_t count = 0;
+    auto it = l.begin();
+    if (it == l.end())
+        return 0;
+    for (auto next = std::next(it); next != l.end(); next = std::next(it)) {
+        if (eq(*it, *next)) {
+            removed.splice(removed.end(), l, next);
+            ++count;
+        } else {
+            it = next;
+        }
+    }
+    return count;
+}
+
+// Splices every element satisfying `pred` into `removed` and returns how
+// many were removed.
+template <class List, class Pred>
+std::size_t remove_if(List& l, List& removed, Pred pred) {
+    std::size_t count = 0;
+    for (auto it = l.begin(); it != l.end();) {
+        auto cur = it++;
+        if (pred(*cur)) {
+            removed.splice(removed.end(), l, cur);
+            ++count;
+        }
+    }
+    return count;
+}
+
+// Makes `middle` the first element.  O(1) for std::list-style splicing of a
+// whole range within the same list.
+template <class List>
+void rotate(List& l, typename List::iterator middle) {
+    l.splice(l.end(), l, l.begin(), middle);
+}
+
+template <class List>
+void reverse(List& l) {
+    if (l.empty())
+        return;
+    auto last = std::prev(l.end());
+    while (l.begin() != last)
+        l.splice(std::next(last), l, l.begin());
+}
+
+// Rearranges `l` so the element at position `n` is the one that would be
+// there if the list were sorted, with no element before it greater and none
+// after it smaller.  Expected O(size()); returns an iterator to that element,
+// or end() if n >= size().  The scratch lists share l's allocator, so nodes
+// only ever move between lists that can splice them.  If `comp` throws,
+// every element is back in `l`, in unspecified order.
+template <class List, class Compare = std::less<>>
+typename List::iterator nth_element(List& l, std::size_t n, Compare comp = Compare()) {
+    if (n >= l.size())
+        return l.end();
+
+    const auto alloc = l.get_allocator();
+    List left(alloc), right(alloc), work(alloc), lo(alloc), eq(alloc), hi(alloc);
+    work.splice(work.end(), l);
+    std::uint64_t rng = 0x9e3779b97f4a7c15ull ^ work.size();
+
+    try {
+        for (;;) {
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            auto pivot_it = std::next(work.begin(), static_cast<std::ptrdiff_t>(rng % work.size()));
+            const auto& pivot = *pivot_it;
+            eq.splice(eq.end(), work, pivot_it);
+
+            while (!work.empty()) {
+                auto cur = work.begin();
+                if (comp(*cur, pivot))
+                    lo.splice(lo.end(), work, cur);
+                else if (comp(pivot, *cur))
+                    hi.splice(hi.end(), work, cur);
+                else
+                    eq.splice(eq.end(), work, cur);
+            }
+
+            if (n < lo.size()) {
+                right.splice(right.begin(), hi);
+                right.splice(right.begin(), eq);
+                work.splice(work.end(), lo);
+            } else if (n < lo.size() + eq.size()) {
+                auto nth = std::next(eq.begin(), static_cast<std::ptrdiff_t>(n - lo.size()));
+                l.splice(l.end(), left);
+                l.splice(l.end(), lo);
+                l.splice(l.end(), eq);
+                l.splice(l.end(), hi);
+                l.splice(l.end(), right);
+                return nth;
+            } else {
+                n -= lo.size() + eq.size();
+                left.splice(left.end(), lo);
+                left.splice(left.end(), eq);
+                work.splice(work.end(), hi);
+            }
+        }
+    } catch (...) {
+        for (List* part : {&left, &lo, &eq, &work, &hi, &right})
+            l.splice(l.end(), *part);
+        throw;
+    }
+}
+
+} // namespace p_linked_list
+
+#endif
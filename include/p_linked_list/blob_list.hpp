@@ -0,0 +1,137 @@
+// Doubly linked list of byte strings stored inline in their nodes.
+//
+// A node is its links, a length and then the bytes themselves, allocated
+// together when the element is inserted.  A string therefore costs one
+// allocation instead of a node plus a heap buffer, and the bytes sit next to
+// the links that lead to them.  Element size is fixed at insertion; elements
+// are read through std::string_view or std::span views into the node.
+
+#ifndef P_LINKED_LIST_BLOB_LIST_HPP
+#define P_LINKED_LIST_BLOB_LIST_HPP
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+
+namespace p_linked_list {
+
+class blob_list {
+    struct link {
+        link* prev;
+        link* next;
+    };
+
+    struct node : link {
+        std::size_t size;
+
+        char* data() noexcept { return reinterpret_cast<char*>(this + 1); }
+    };
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = std::string_view;
+
+        iterator() = default;
+
+        std::string_view operator*() const { return {as_node()->data(), as_node()->size}; }
+        std::span<std::byte> bytes() const {
+            return {reinterpret_cast<std::byte*>(as_node()->data()), as_node()->size};
+        }
+        std::size_t size() const { return as_node()->size; }
+
+        iterator& operator++() { l_ = l_->next; return *this; }
+        iterator operator++(int) { iterator t = *this; ++*this; return t; }
+        iterator& operator--() { l_ = l_->prev; return *this; }
+        iterator operator--(int) { iterator t = *this; --*this; return t; }
+        friend bool operator==(iterator a, iterator b) { return a.l_ == b.l_; }
+        friend bool operator!=(iterator a, iterator b) { return a.l_ != b.l_; }
+
+    private:
+        friend class blob_list;
+        explicit iterator(link* l) : l_(l) {}
+        node* as_node() const { return static_cast<node*>(l_); }
+        link* l_ = nullptr;
+    };
+
+    explicit blob_list(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : mr_(mr) {
+        head_.prev = head_.next = &head_;
+    }
+
+    blob_list(const blob_list&) = delete;
+    blob_list& operator=(const blob_list&) = delete;
+
+    ~blob_list() { clear(); }
+
+    iterator insert(iterator pos, std::string_view s) { return insert(pos, s.data(), s.size()); }
+    iterator insert(iterator pos, std::span<const std::byte> b) {
+        return insert(pos, reinterpret_cast<const char*>(b.data()), b.size());
+    }
+
+    // Inserts an element of `n` uninitialized bytes; fill it through bytes().
+    iterator insert_uninitialized(iterator pos, std::size_t n) { return insert(pos, nullptr, n); }
+
+    void push_back(std::string_view s) { insert(end(), s); }
+    void push_front(std::string_view s) { insert(begin(), s); }
+    void push_back(std::span<const std::byte> b) { insert(end(), b); }
+    void push_front(std::span<const std::byte> b) { insert(begin(), b); }
+
+    iterator erase(iterator pos) {
+        link* l = pos.l_;
+        link* next = l->next;
+        l->prev->next = next;
+        next->prev = l->prev;
+        node* n = static_cast<node*>(l);
+        mr_->deallocate(n, sizeof(node) + n->size, alignof(node));
+        --size_;
+        return iterator(next);
+    }
+
+    void pop_front() { erase(begin()); }
+    void pop_back() { erase(iterator(head_.prev)); }
+
+    void clear() {
+        while (!empty())
+            pop_front();
+    }
+
+    std::string_view front() const { return *begin(); }
+    std::string_view back() const { return *iterator(head_.prev); }
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t size() const noexcept { return size_; }
+
+    iterator begin() const { return iterator(head_.next); }
+    iterator end() const { return iterator(const_cast<link*>(&head_)); }
+
+private:
+    iterator insert(iterator pos, const char* src, std::size_t n) {
+        void* mem = mr_->allocate(sizeof(node) + n, alignof(node));
+        node* nd = ::new (mem) node;
+        nd->size = n;
+        if (src && n)
+            std::memcpy(nd->data(), src, n);
+        link* next = pos.l_;
+        nd->prev = next->prev;
+        nd->next = next;
+        next->prev->next = nd;
+        next->prev = nd;
+        ++size_;
+        return iterator(nd);
+    }
+
+    std::pmr::memory_resource* mr_;
+    link head_;
+    std::size_t size_ = 0;
+};
+
+} // namespace p_linked_list
+
+#endif
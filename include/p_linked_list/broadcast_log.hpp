@@ -0,0 +1,217 @@
+// Single-writer, multi-reader append-only log.
+//
+// The log is a linked list of fixed-size segments.  One writer appends and
+// publishes a sequence number; any number of readers each own a cursor and
+// follow the tail independently, so every reader sees every item without
+// per-reader copies or locks on the read path.  A segment is destroyed once
+// every cursor has moved past it, which the writer checks whenever it links
+// a new segment.
+//
+// A cursor reads through pointers into the log; the pointer returned by
+// next() stays valid until that cursor's following call.  wait_next() blocks
+// on the published sequence number (std::atomic::wait) when the cursor has
+// caught up, and the writer only issues a wake-up when a reader is asleep.
+// The log does not apply back-pressure: a stalled reader keeps every segment
+// after its position alive.
+
+#ifndef P_LINKED_LIST_BROADCAST_LOG_HPP
+#define P_LINKED_LIST_BROADCAST_LOG_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace p_linked_list {
+
+template <class T, std::size_t SegmentSize = 1024>
+class broadcast_log {
+    struct segment {
+        std::atomic<segment*> next{nullptr};
+        alignas(T) unsigned char storage[SegmentSize * sizeof(T)];
+
+        T* slot(std::size_t i) noexcept { return std::launder(reinterpret_cast<T*>(storage) + i); }
+    };
+
+public:
+    class cursor {
+    public:
+        cursor(const cursor&) = delete;
+        cursor& operator=(const cursor&) = delete;
+
+        ~cursor() { log_.unsubscribe(this); }
+
+        // Returns the next item, or nullptr if the reader has caught up.
+        const T* next() {
+            std::uint64_t p = pos_.load(std::memory_order_relaxed);
+            if (p >= (log_.published_.load(std::memory_order_acquire) & ~closed_bit))
+                return nullptr;
+            if (p - base_ == SegmentSize) {
+                seg_ = seg_->next.load(std::memory_order_acquire);
+                base_ += SegmentSize;
+            }
+            const T* v = seg_->slot(static_cast<std::size_t>(p - base_));
+            pos_.store(p + 1, std::memory_order_release);
+            return v;
+        }
+
+        // Like next(), but blocks until an item arrives.  Returns nullptr
+        // once the log is closed and this cursor has read everything.
+        const T* wait_next() {
+            for (;;) {
+                if (const T* v = next())
+                    return v;
+                std::uint64_t p = pos_.load(std::memory_order_relaxed);
+                if (log_.published_.load(std::memory_order_acquire) & closed_bit)
+                    return next();
+                log_.sleeping_.store(true);
+                log_.published_.wait(p);
+            }
+        }
+
+        std::uint64_t position() const noexcept { return pos_.load(std::memory_order_relaxed); }
+
+    private:
+        friend class broadcast_log;
+        explicit cursor(broadcast_log& log) : log_(log) {}
+
+        broadcast_log& log_;
+        segment* seg_ = nullptr;
+        std::uint64_t base_ = 0;
+        std::atomic<std::uint64_t> pos_{0};
+    };
+
+    broadcast_log() : head_(new segment), tail_(head_) {}
+
+    broadcast_log(const broadcast_log&) = delete;
+    broadcast_log& operator=(const broadcast_log&) = delete;
+
+    // All cursors must be destroyed first.
+    ~broadcast_log() {
+        std::uint64_t end = published_.load(std::memory_order_relaxed) & ~closed_bit;
+        for (segment* s = head_; s;) {
+            segment* next = s->next.load(std::memory_order_relaxed);
+            std::uint64_t n = std::min<std::uint64_t>(end - head_base_, SegmentSize);
+            for (std::size_t i = 0; i < n; ++i)
+                s->slot(i)->~T();
+            head_base_ += SegmentSize;
+            delete s;
+            s = next;
+        }
+        delete spare_;
+    }
+
+    // Returns a new cursor positioned at the current tail, or at the oldest
+    // retained item when `from_oldest` is set.
+    std::unique_ptr<cursor> subscribe(bool from_oldest = false) {
+        std::unique_ptr<cursor> c(new cursor(*this));
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        std::uint64_t pos = from_oldest ? head_base_ : published();
+        segment* s = head_;
+        std::uint64_t base = head_base_;
+        segment* next;
+        while (pos >= base + SegmentSize && (next = s->next.load(std::memory_order_acquire))) {
+            s = next;
+            base += SegmentSize;
+        }
+        c->seg_ = s;
+        c->base_ = base;
+        c->pos_.store(pos, std::memory_order_relaxed);
+        cursors_.push_back(c.get());
+        return c;
+    }
+
+    // Writer only.
+    template <class... Args>
+    void emplace(Args&&... args) {
+        std::uint64_t p = write_pos_;
+        if (p - tail_base_ == SegmentSize) {
+            segment* s = spare_ ? std::exchange(spare_, nullptr) : new segment;
+            std::lock_guard<std::mutex> lock(registry_mutex_);
+            tail_->next.store(s, std::memory_order_release);
+            tail_ = s;
+            tail_base_ += SegmentSize;
+            reclaim_locked();
+        }
+        ::new (tail_->storage + (p - tail_base_) * sizeof(T)) T(std::forward<Args>(args)...);
+        write_pos_ = p + 1;
+        published_.store(p + 1);  // emplace after close() is not allowed
+        if (sleeping_.load() && sleeping_.exchange(false))
+            published_.notify_all();
+    }
+
+    void push(const T& v) { emplace(v); }
+    void push(T&& v) { emplace(std::move(v)); }
+
+    // Writer only: wakes blocked readers once they have drained the log.
+    void close() {
+        published_.fetch_or(closed_bit);
+        published_.notify_all();
+    }
+
+    // Writer only: frees segments every cursor has passed.
+    void reclaim() {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        reclaim_locked();
+    }
+
+    std::uint64_t published() const noexcept {
+        return published_.load(std::memory_order_acquire) & ~closed_bit;
+    }
+
+private:
+    void unsubscribe(cursor* c) {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        cursors_.erase(std::find(cursors_.begin(), cursors_.end(), c));
+    }
+
+    // A cursor at position p may still hold the segment ending at p, so a
+    // segment goes only when every cursor is strictly beyond its end.
+    void reclaim_locked() {
+        std::uint64_t min_pos = write_pos_ + 1;
+        for (cursor* c : cursors_)
+            min_pos = std::min(min_pos, c->pos_.load(std::memory_order_acquire));
+        while (head_ != tail_ && min_pos > head_base_ + SegmentSize) {
+            segment* s = head_;
+            head_ = s->next.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < SegmentSize; ++i)
+                s->slot(i)->~T();
+            head_base_ += SegmentSize;
+            s->next.store(nullptr, std::memory_order_relaxed);
+            if (spare_)
+                delete s;
+            else
+                spare_ = s;
+        }
+    }
+
+    // The top bit of published_ marks the log closed, so closing also
+    // changes the value blocked readers wait on.
+    static constexpr std::uint64_t closed_bit = std::uint64_t(1) << 63;
+
+    // A reader sets sleeping_ before it blocks and the writer clears it when
+    // it wakes them, so a burst of pushes costs one wake-up, not one per
+    // item.  Both sides use sequentially consistent operations: either the
+    // writer sees the flag, or the reader's wait sees the new value.
+    alignas(64) std::atomic<std::uint64_t> published_{0};
+    std::atomic<bool> sleeping_{false};
+
+    // Writer state; head_ and the cursor list are shared under the mutex.
+    alignas(64) std::mutex registry_mutex_;
+    std::vector<cursor*> cursors_;
+    segment* head_;
+    std::uint64_t head_base_ = 0;
+    segment* tail_;
+    std::uint64_t tail_base_ = 0;
+    std::uint64_t write_pos_ = 0;
+    segment* spare_ = nullptr;
+};
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,396 @@
+// Chain of reference-counted byte slices for zero-copy I/O.
+//
+// A buffer_chain is a circular doubly linked list of slices, each naming a
+// range of a shared, reference-counted buffer.  Appending or prepending
+// another chain is a splice, and splitting hands whole slices to the new
+// chain and shares the one straddling the cut, so neither copies payload.
+// write_to() and read_from() build iovec arrays directly from the slices
+// for writev/readv; bytes are only gathered into contiguous memory when
+// asked for with coalesce() or copy_to().
+//
+// Buffers are shared between chains (clone(), split()) and released when
+// the last slice referencing them goes away.  New bytes are written into a
+// buffer's spare tail only while the chain holds its sole reference.
+//
+// split() still walks to the slice containing the cut, so it is O(slices
+// before the cut), not O(1); relinking those slices costs nothing extra.
+
+#ifndef P_LINKED_LIST_BUFFER_CHAIN_HPP
+#define P_LINKED_LIST_BUFFER_CHAIN_HPP
+
+#include <limits.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace p_linked_list {
+
+class buffer_chain {
+    struct buffer {
+        std::atomic<std::size_t> refs{1};
+        std::size_t capacity;
+
+        char* data() noexcept { return reinterpret_cast<char*>(this + 1); }
+
+        static buffer* create(std::size_t capacity) {
+            void* mem = ::operator new(sizeof(buffer) + capacity);
+            buffer* b = ::new (mem) buffer;
+            b->capacity = capacity;
+            return b;
+        }
+
+        buffer* retain() noexcept {
+            refs.fetch_add(1, std::memory_order_relaxed);
+            return this;
+        }
+
+        void release() noexcept {
+            if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                this->~buffer();
+                ::operator delete(this);
+            }
+        }
+    };
+
+    struct link {
+        link* prev;
+        link* next;
+    };
+
+    struct slice : link {
+        buffer* buf;
+        std::size_t offset;
+        std::size_t length;
+
+        char* data() const noexcept { return buf->data() + offset; }
+    };
+
+public:
+    static constexpr std::size_t default_buffer_size = 4096;
+
+    buffer_chain() noexcept { reset(); }
+
+    buffer_chain(buffer_chain&& other) noexcept {
+        reset();
+        take(other);
+    }
+
+    buffer_chain& operator=(buffer_chain&& other) noexcept {
+        if (this != &other) {
+            clear();
+            take(other);
+        }
+        return *this;
+    }
+
+    buffer_chain(const buffer_chain&) = delete;
+    buffer_chain& operator=(const buffer_chain&) = delete;
+
+    ~buffer_chain() { clear(); }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t slice_count() const noexcept { return slices_; }
+
+    // Copies `bytes` in, filling the last buffer's spare tail first.
+    void append(std::string_view bytes) {
+        while (!bytes.empty()) {
+            std::size_t room = tail_room();
+            if (room == 0) {
+                push_slice(head_.prev, buffer::create(std::max(default_buffer_size, bytes.size())), 0, 0);
+                room = tail_room();
+            }
+            slice* last = static_cast<slice*>(head_.prev);
+            std::size_t n = std::min(room, bytes.size());
+            std::memcpy(last->data() + last->length, bytes.data(), n);
+            last->length += n;
+            size_ += n;
+            bytes.remove_prefix(n);
+        }
+    }
+
+    // Moves all of `other` to the end of this chain in O(1).
+    void append(buffer_chain&& other) noexcept { splice(&head_, other); }
+
+    // Moves all of `other` to the front of this chain in O(1).
+    void prepend(buffer_chain&& other) noexcept { splice(head_.next, other); }
+
+    // Returns a chain sharing every buffer with this one.
+    buffer_chain clone() const {
+        buffer_chain out;
+        for (const link* l = head_.next; l != &head_; l = l->next) {
+            auto* s = static_cast<const slice*>(l);
+            out.push_slice(out.head_.prev, s->buf->retain(), s->offset, s->length);
+            out.size_ += s->length;
+        }
+        return out;
+    }
+
+    // Removes the first `n` bytes and returns them as a chain.  Whole slices
+    // are relinked; a slice straddling the cut is shared by both chains.
+    buffer_chain split(std::size_t n) {
+        buffer_chain out;
+        n = std::min(n, size_);
+        while (n) {
+            auto* s = static_cast<slice*>(head_.next);
+            if (s->length <= n) {
+                unlink(s);
+                size_ -= s->length;
+                --slices_;
+                relink(out.head_.prev, s);
+                out.size_ += s->length;
+                ++out.slices_;
+                n -= s->length;
+            } else {
+                out.push_slice(out.head_.prev, s->buf->retain(), s->offset, n);
+                out.size_ += n;
+                s->offset += n;
+                s->length -= n;
+                size_ -= n;
+                n = 0;
+            }
+        }
+        return out;
+    }
+
+    void trim_front(std::size_t n) {
+        n = std::min(n, size_);
+        while (n) {
+            auto* s = static_cast<slice*>(head_.next);
+            if (s->length <= n) {
+                n -= s->length;
+                size_ -= s->length;
+                drop(s);
+            } else {
+                s->offset += n;
+                s->length -= n;
+                size_ -= n;
+                n = 0;
+            }
+        }
+    }
+
+    // Gathers up to `n` bytes starting at `offset` into `dst`.
+    std::size_t copy_to(char* dst, std::size_t n, std::size_t offset = 0) const {
+        std::size_t copied = 0;
+        for (const link* l = head_.next; l != &head_ && copied < n; l = l->next) {
+            auto* s = static_cast<const slice*>(l);
+            if (offset >= s->length) {
+                offset -= s->length;
+                continue;
+            }
+            std::size_t k = std::min(s->length - offset, n - copied);
+            std::memcpy(dst + copied, s->data() + offset, k);
+            copied += k;
+            offset = 0;
+        }
+        return copied;
+    }
+
+    // Makes the chain a single slice and returns a view of it.
+    std::string_view coalesce() {
+        if (slices_ > 1) {
+            buffer* b = buffer::create(size_);
+            copy_to(b->data(), size_);
+            std::size_t total = size_;
+            clear();
+            push_slice(&head_, b, 0, total);
+            size_ = total;
+        }
+        if (empty())
+            return {};
+        auto* s = static_cast<slice*>(head_.next);
+        return {s->data(), s->length};
+    }
+
+    std::string to_string() const {
+        std::string out(size_, '\0');
+        copy_to(out.data(), size_);
+        return out;
+    }
+
+    // Calls f(std::string_view) for every slice in order.
+    template <class F>
+    void for_each_slice(F&& f) const {
+        for (const link* l = head_.next; l != &head_; l = l->next) {
+            auto* s = static_cast<const slice*>(l);
+            f(std::string_view(s->data(), s->length));
+        }
+    }
+
+    // Writes the chain with writev and consumes what was written.  Returns
+    // the byte count, or -1 with errno set if nothing could be written.
+    ssize_t write_to(int fd) {
+        ssize_t total = 0;
+        iovec iov[iov_batch];
+        while (!empty()) {
+            int cnt = 0;
+            for (link* l = head_.next; l != &head_ && cnt < iov_batch; l = l->next) {
+                auto* s = static_cast<slice*>(l);
+                iov[cnt].iov_base = s->data();
+                iov[cnt].iov_len = s->length;
+                ++cnt;
+            }
+            ssize_t w = ::writev(fd, iov, cnt);
+            if (w < 0)
+                return total ? total : -1;
+            trim_front(static_cast<std::size_t>(w));
+            total += w;
+            std::size_t offered = 0;
+            for (int i = 0; i < cnt; ++i)
+                offered += iov[i].iov_len;
+            if (static_cast<std::size_t>(w) < offered)
+                break;
+        }
+        return total;
+    }
+
+    // Reads up to `max` bytes with one readv into the spare tail of the last
+    // buffer and a fresh buffer, appending what arrives.  Returns the byte
+    // count, 0 at end of file, or -1 with errno set.  `max` of 0 fails with
+    // EINVAL rather than returning a 0 that would read as end of file.
+    ssize_t read_from(int fd, std::size_t max = default_buffer_size) {
+        if (max == 0) {
+            errno = EINVAL;
+            return -1;
+        }
+        iovec iov[2];
+        int cnt = 0;
+        std::size_t room = std::min(tail_room(), max);
+        if (room) {
+            auto* last = static_cast<slice*>(head_.prev);
+            iov[cnt].iov_base = last->data() + last->length;
+            iov[cnt].iov_len = room;
+            ++cnt;
+        }
+        buffer* fresh = nullptr;
+        if (room < max) {
+            fresh = buffer::create(std::max(default_buffer_size, max - room));
+            iov[cnt].iov_base = fresh->data();
+            iov[cnt].iov_len = max - room;
+            ++cnt;
+        }
+        ssize_t r = ::readv(fd, iov, cnt);
+        if (r <= 0) {
+            if (fresh)
+                fresh->release();
+            return r;
+        }
+        std::size_t got = static_cast<std::size_t>(r);
+        std::size_t into_tail = std::min(got, room);
+        if (into_tail)
+            static_cast<slice*>(head_.prev)->length += into_tail;
+        if (got > into_tail)
+            push_slice(head_.prev, fresh, 0, got - into_tail);
+        else if (fresh)
+            fresh->release();
+        size_ += got;
+        return r;
+    }
+
+    void clear() noexcept {
+        while (head_.next != &head_)
+            drop(static_cast<slice*>(head_.next));
+        size_ = 0;
+    }
+
+private:
+    static constexpr int iov_batch = IOV_MAX < 64 ? IOV_MAX : 64;
+
+    void reset() noexcept {
+        head_.prev = head_.next = &head_;
+        size_ = 0;
+        slices_ = 0;
+    }
+
+    void take(buffer_chain& other) noexcept {
+        if (other.head_.next == &other.head_)
+            return;
+        head_.next = other.head_.next;
+        head_.prev = other.head_.prev;
+        head_.next->prev = &head_;
+        head_.prev->next = &head_;
+        size_ = other.size_;
+        slices_ = other.slices_;
+        other.reset();
+    }
+
+    // Bytes that can be appended in place to the last slice.
+    std::size_t tail_room() const noexcept {
+        if (head_.prev == &head_)
+            return 0;
+        auto* s = static_cast<const slice*>(head_.prev);
+        if (s->buf->refs.load(std::memory_order_acquire) != 1)
+            return 0;
+        return s->buf->capacity - s->offset - s->length;
+    }
+
+    // Links a new slice after `pos`; the slice adopts the reference to `b`.
+    void push_slice(link* pos, buffer* b, std::size_t offset, std::size_t length) {
+        slice* s;
+        try {
+            s = new slice;
+        } catch (...) {
+            b->release();
+            throw;
+        }
+        s->buf = b;
+        s->offset = offset;
+        s->length = length;
+        relink(pos, s);
+        ++slices_;
+    }
+
+    static void relink(link* pos, link* s) noexcept {
+        s->prev = pos;
+        s->next = pos->next;
+        pos->next->prev = s;
+        pos->next = s;
+    }
+
+    static void unlink(link* s) noexcept {
+        s->prev->next = s->next;
+        s->next->prev = s->prev;
+    }
+
+    void drop(slice* s) noexcept {
+        unlink(s);
+        --slices_;
+        s->buf->release();
+        delete s;
+    }
+
+    // Moves all of `other` in front of `pos`.
+    void splice(link* pos, buffer_chain& other) noexcept {
+        if (&other == this || other.head_.next == &other.head_)
+            return;
+        link* first = other.head_.next;
+        link* last = other.head_.prev;
+        link* before = pos->prev;
+        before->next = first;
+        first->prev = before;
+        last->next = pos;
+        pos->prev = last;
+        size_ += other.size_;
+        slices_ += other.slices_;
+        other.reset();
+    }
+
+    link head_;
+    std::size_t size_ = 0;
+    std::size_t slices_ = 0;
+};
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,150 @@
+// Parallel loader from delimited text into a list.
+//
+// The input is split into one byte range per thread, each range starting just
+// after a delimiter.  Every thread parses its range into a private sublist
+// and the sublists are spliced together in input order, which is O(threads).
+// All sublists allocate from one memory_resource so splicing between them is
+// legal; a std::pmr::synchronized_pool_resource gives each thread its own
+// pools and allocates nodes in bulk chunks.
+//
+// load_delimited_file() maps the file with mmap rather than reading it.
+
+#ifndef P_LINKED_LIST_BULK_LOAD_HPP
+#define P_LINKED_LIST_BULK_LOAD_HPP
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <exception>
+#include <list>
+#include <memory_resource>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace p_linked_list {
+
+struct load_options {
+    unsigned threads = 0;  // 0 means std::thread::hardware_concurrency()
+    char delimiter = '\n';
+};
+
+namespace detail {
+
+template <class T>
+struct is_optional : std::false_type {};
+template <class T>
+struct is_optional<std::optional<T>> : std::true_type {};
+
+template <class T, class Parse>
+void parse_range(std::string_view data, char delim, Parse& parse, std::pmr::list<T>& out) {
+    while (!data.empty()) {
+        std::size_t end = data.find(delim);
+        std::string_view record = data.substr(0, end);
+        using result = std::invoke_result_t<Parse&, std::string_view>;
+        if constexpr (is_optional<result>::value) {
+            if (auto v = parse(record))
+                out.push_back(std::move(*v));
+        } else {
+            out.push_back(parse(record));
+        }
+        if (end == std::string_view::npos)
+            break;
+        data.remove_prefix(end + 1);
+    }
+}
+
+} // namespace detail
+
+// Parses every delimiter-terminated record of `data` with `parse` and
+// returns the results in input order.  `parse` takes a std::string_view and
+// returns T, or std::optional<T> to skip records.  It is called concurrently.
+template <class T, class Parse>
+std::pmr::list<T> load_delimited(std::string_view data, Parse parse,
+                                 std::pmr::memory_resource* mr, load_options opts = {}) {
+    unsigned threads = opts.threads ? opts.threads : std::max(1u, std::thread::hardware_concurrency());
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, data.size() / 4096 + 1));
+
+    std::vector<std::size_t> bounds(threads + 1, data.size());
+    bounds[0] = 0;
+    for (unsigned i = 1; i < threads; ++i) {
+        std::size_t pos = std::max(bounds[i - 1], data.size() / threads * i);
+        std::size_t d = pos == 0 ? 0 : data.find(opts.delimiter, pos - 1);
+        bounds[i] = d == std::string_view::npos ? data.size() : d + (pos == 0 ? 0 : 1);
+    }
+
+    std::vector<std::pmr::list<T>> parts;
+    parts.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i)
+        parts.emplace_back(mr);
+    std::vector<std::exception_ptr> errors(threads);
+    // jthreads, so threads already started are joined if a later spawn throws.
+    std::vector<std::jthread> workers;
+    workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        workers.emplace_back([&, i] {
+            try {
+                Parse local = parse;
+                detail::parse_range<T>(data.substr(bounds[i], bounds[i + 1] - bounds[i]),
+                                       opts.delimiter, local, parts[i]);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    for (auto& w : workers)
+        w.join();
+    for (auto& e : errors) {
+        if (e)
+            std::rethrow_exception(e);
+    }
+
+    std::pmr::list<T> out(mr);
+    for (auto& p : parts)
+        out.splice(out.end(), p);
+    return out;
+}
+
+template <class T, class Parse>
+std::pmr::list<T> load_delimited_file(const char* path, Parse parse,
+                                      std::pmr::memory_resource* mr, load_options opts = {}) {
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::system_error(errno, std::generic_category(), path);
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        int err = errno;
+        ::close(fd);
+        throw std::system_error(err, std::generic_category(), path);
+    }
+    std::size_t len = static_cast<std::size_t>(st.st_size);
+    if (len == 0) {
+        ::close(fd);
+        return std::pmr::list<T>(mr);
+    }
+    void* map = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    int err = errno;
+    ::close(fd);
+    if (map == MAP_FAILED)
+        throw std::system_error(err, std::generic_category(), path);
+    ::madvise(map, len, MADV_SEQUENTIAL);
+
+    struct unmapper {
+        void* p;
+        std::size_t n;
+        ~unmapper() { ::munmap(p, n); }
+    } guard{map, len};
+    return load_delimited<T>(std::string_view(static_cast<const char*>(map), len), std::move(parse), mr, opts);
+}
+
+} // namespace p_linked_list
+
+#endif
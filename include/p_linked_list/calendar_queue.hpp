@@ -0,0 +1,235 @@
+// Calendar queue for discrete-event simulation (R. Brown, CACM 1988).
+//
+// Events are hashed by time into an array of "day" buckets that wraps every
+// year (bucket_count * width).  Each bucket is a linked list kept sorted by
+// time, so dequeue walks forward from the current day and takes the first
+// head that belongs to this year; with a well-chosen width each bucket
+// holds a handful of events and both operations are O(1) on average.
+//
+// The bucket count doubles or halves as the queue grows past 2x or shrinks
+// below 1/2 of it, and each resize re-estimates the width from the spacing of
+// the earliest events.  The queue also counts the days dequeue skips and the
+// nodes enqueue walks; when either averages more than a few per operation
+// the width is re-estimated at the same bucket count, so the calendar
+// follows changes in event density even when its size is steady.
+// Resizing relinks the existing nodes; nodes are recycled through a free
+// list, so steady-state operation does not allocate.
+//
+// Days are computed as integers from the time, which keeps the enqueue and
+// dequeue views of bucket boundaries identical.  Equal times dequeue in
+// insertion order.  Until the first dequeue the scan starts at the earliest
+// pushed time, which may be negative; after that, times must not precede the
+// last dequeued time.
+
+#ifndef P_LINKED_LIST_CALENDAR_QUEUE_HPP
+#define P_LINKED_LIST_CALENDAR_QUEUE_HPP
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace p_linked_list {
+
+template <class T>
+class calendar_queue {
+public:
+    explicit calendar_queue(double initial_width = 1.0) : width_(initial_width), buckets_(2, nullptr) {}
+
+    calendar_queue(const calendar_queue&) = delete;
+    calendar_queue& operator=(const calendar_queue&) = delete;
+
+    void push(double time, T value) {
+        assert(!dequeued_ || time >= last_time_);
+        if (!dequeued_ && (size_ == 0 || time < last_time_)) {
+            last_time_ = time;
+            current_day_ = day_of(time);
+        }
+        node* n = free_;
+        if (n) {
+            free_ = n->next;
+            n->value = std::move(value);
+        } else {
+            n = &storage_.emplace_back(std::move(value));
+        }
+        n->time = time;
+        n->seq = next_seq_++;
+        insert(n);
+        ++size_;
+        if (!resizing_ && size_ > 2 * buckets_.size())
+            resize(buckets_.size() * 2);
+        else
+            account();
+    }
+
+    // Removes and returns the earliest event.  The queue must not be empty.
+    std::pair<double, T> pop() {
+        node* n = pop_node();
+        std::pair<double, T> out(n->time, std::move(n->value));
+        n->next = free_;
+        free_ = n;
+        if (!resizing_ && buckets_.size() > 2 && size_ < buckets_.size() / 2)
+            resize(buckets_.size() / 2);
+        else
+            account();
+        return out;
+    }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t bucket_count() const noexcept { return buckets_.size(); }
+    double bucket_width() const noexcept { return width_; }
+
+private:
+    struct node {
+        explicit node(T v) : value(std::move(v)) {}
+
+        node* next = nullptr;
+        double time = 0;
+        std::uint64_t seq = 0;
+        T value;
+    };
+
+    std::int64_t day_of(double t) const noexcept { return static_cast<std::int64_t>(std::floor(t / width_)); }
+    std::size_t bucket_of(std::int64_t day) const noexcept {
+        return static_cast<std::size_t>(static_cast<std::uint64_t>(day) & (buckets_.size() - 1));
+    }
+
+    static bool before(const node* a, const node* b) noexcept {
+        return a->time < b->time || (a->time == b->time && a->seq < b->seq);
+    }
+
+    void insert(node* n) {
+        node** link = &buckets_[bucket_of(day_of(n->time))];
+        while (*link && !before(n, *link)) {
+            link = &(*link)->next;
+            ++cost_;
+        }
+        n->next = *link;
+        *link = n;
+    }
+
+    node* pop_node() {
+        const std::size_t nb = buckets_.size();
+        for (std::size_t k = 0; k < nb; ++k, ++current_day_, ++cost_) {
+            node*& head = buckets_[bucket_of(current_day_)];
+            if (head && day_of(head->time) <= current_day_)
+                return unlink_head(head);
+        }
+        // Nothing within a year: jump straight to the earliest event.
+        node** best = nullptr;
+        for (auto& head : buckets_) {
+            if (head && (!best || before(head, *best)))
+                best = &head;
+        }
+        current_day_ = day_of((*best)->time);
+        return unlink_head(*best);
+    }
+
+    // Re-estimates the width once a window of operations has cost more
+    // than max_average_cost steps each.
+    void account() {
+        if (++ops_ < window_ops)
+            return;
+        if (!resizing_ && cost_ > max_average_cost * ops_) {
+            // Relink only if the estimate moved enough to matter, so a
+            // workload that is inherently costly does not relink every window.
+            resizing_ = true;
+            double w = estimate_width();
+            resizing_ = false;
+            if (std::isfinite(w) && w > 0 && (w < width_ / 2 || w > width_ * 2))
+                resize(buckets_.size(), w);
+        }
+        ops_ = 0;
+        cost_ = 0;
+    }
+
+    node* unlink_head(node*& head) {
+        node* n = head;
+        head = n->next;
+        --size_;
+        last_time_ = n->time;
+        dequeued_ = true;
+        return n;
+    }
+
+    // Relinks every node into `new_count` buckets of width `w`, by default
+    // estimated from the spacing of the earliest events.
+    void resize(std::size_t new_count, double w = 0) {
+        resizing_ = true;
+        if (w == 0)
+            w = estimate_width();
+        if (std::isfinite(w) && w > 0)
+            width_ = w;
+
+        std::vector<node*> old(new_count, nullptr);
+        old.swap(buckets_);
+        for (node* head : old) {
+            while (head) {
+                node* next = head->next;
+                insert(head);
+                head = next;
+            }
+        }
+        current_day_ = day_of(last_time_);
+        resizing_ = false;
+        ops_ = 0;
+        cost_ = 0;
+    }
+
+    double estimate_width() {
+        const std::size_t samples = size_ < 25 ? size_ : 25;
+        if (samples < 2)
+            return width_;
+        std::int64_t saved_day = current_day_;
+        double saved_last = last_time_;
+        bool saved_dequeued = dequeued_;
+        std::vector<node*> taken;
+        taken.reserve(samples);
+        for (std::size_t i = 0; i < samples; ++i)
+            taken.push_back(pop_node());
+
+        double total = taken.back()->time - taken.front()->time;
+        double avg = total / static_cast<double>(samples - 1);
+        double sum = 0;
+        std::size_t count = 0;
+        for (std::size_t i = 1; i < samples; ++i) {
+            double gap = taken[i]->time - taken[i - 1]->time;
+            if (gap <= 2 * avg) {
+                sum += gap;
+                ++count;
+            }
+        }
+
+        for (node* n : taken)
+            insert(n);
+        size_ += samples;
+        current_day_ = saved_day;
+        last_time_ = saved_last;
+        dequeued_ = saved_dequeued;
+        return count ? 3 * sum / static_cast<double>(count) : width_;
+    }
+
+    static constexpr std::size_t window_ops = 1024;
+    static constexpr std::size_t max_average_cost = 4;
+
+    double width_;
+    std::vector<node*> buckets_;
+    std::deque<node> storage_;
+    node* free_ = nullptr;
+    std::size_t size_ = 0;
+    std::uint64_t next_seq_ = 0;
+    std::int64_t current_day_ = 0;
+    double last_time_ = 0;
+    bool dequeued_ = false;
+    bool resizing_ = false;
+    std::size_t ops_ = 0;
+    std::size_t cost_ = 0;
+};
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,154 @@
+// Persistent catenable list (Okasaki's catenable list).
+//
+// A list is a tree whose root holds the first element and whose children,
+// in order, are the lists that follow it.  Concatenation hangs the second
+// list off the first one's root, so push_front, push_back and concat are
+// O(1) and front() is O(1).  pop_front() relinks the root's children into a
+// chain; that is O(1) amortized when each version is consumed once, as in a
+// pipeline, but popping the same old version repeatedly can cost up to its
+// root's child count each time.
+//
+// Lists are immutable values: every operation returns a new list and shares
+// structure with its inputs.  Nodes are reference counted (atomically, so
+// versions may be shared across threads) and released iteratively, so very
+// long lists do not recurse on destruction.  Concatenation copies the root
+// element of the left operand, so T should be cheap to copy.
+
+#ifndef P_LINKED_LIST_CAT_LIST_HPP
+#define P_LINKED_LIST_CAT_LIST_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace p_linked_list {
+
+template <class T>
+class cat_list {
+    struct cell;
+
+    struct node {
+        node(T h, std::size_t s, cell* c) : head(std::move(h)), size(s), children(c) {}
+
+        std::atomic<std::size_t> refs{1};
+        const T head;
+        const std::size_t size;  // elements in this subtree
+        cell* const children;    // newest child first
+    };
+
+    struct cell {
+        cell(node* v, cell* n) : value(v), next(n) {}
+
+        std::atomic<std::size_t> refs{1};
+        node* const value;
+        cell* const next;
+    };
+
+public:
+    cat_list() = default;
+    explicit cat_list(T x) : root_(new node(std::move(x), 1, nullptr)) {}
+
+    cat_list(const cat_list& other) noexcept : root_(retain(other.root_)) {}
+    cat_list(cat_list&& other) noexcept : root_(std::exchange(other.root_, nullptr)) {}
+    cat_list& operator=(cat_list other) noexcept {
+        std::swap(root_, other.root_);
+        return *this;
+    }
+    ~cat_list() { release(root_, nullptr); }
+
+    bool empty() const noexcept { return root_ == nullptr; }
+    std::size_t size() const noexcept { return root_ ? root_->size : 0; }
+    const T& front() const { return root_->head; }
+
+    friend cat_list concat(const cat_list& a, const cat_list& b) {
+        if (!a.root_)
+            return b;
+        if (!b.root_)
+            return a;
+        return cat_list(link(a.root_, b.root_));
+    }
+
+    friend cat_list operator+(const cat_list& a, const cat_list& b) { return concat(a, b); }
+
+    cat_list push_front(T x) const { return concat(cat_list(std::move(x)), *this); }
+    cat_list push_back(T x) const { return concat(*this, cat_list(std::move(x))); }
+
+    cat_list pop_front() const {
+        if (!root_->children)
+            return cat_list();
+        std::vector<node*> kids;
+        for (cell* c = root_->children; c; c = c->next)
+            kids.push_back(c->value);
+        // kids is newest first; link oldest-to-newest as a right fold.
+        node* acc = retain(kids.front());
+        for (std::size_t i = 1; i < kids.size(); ++i) {
+            node* linked = link(kids[i], acc);
+            release(acc, nullptr);
+            acc = linked;
+        }
+        return cat_list(acc);
+    }
+
+    // Calls f on every element in order.
+    template <class F>
+    void for_each(F&& f) const {
+        std::vector<const node*> stack;
+        if (root_)
+            stack.push_back(root_);
+        while (!stack.empty()) {
+            const node* n = stack.back();
+            stack.pop_back();
+            f(n->head);
+            for (cell* c = n->children; c; c = c->next)
+                stack.push_back(c->value);
+        }
+    }
+
+private:
+    explicit cat_list(node* n) noexcept : root_(n) {}
+
+    template <class P>
+    static P* retain(P* p) noexcept {
+        if (p)
+            p->refs.fetch_add(1, std::memory_order_relaxed);
+        return p;
+    }
+
+    // Returns a copy of `t` with `s` appended as its last child.
+    static node* link(const node* t, node* s) {
+        cell* c = new cell(retain(s), retain(t->children));
+        return new node(t->head, t->size + s->size, c);
+    }
+
+    static void release(node* n, cell* c) noexcept {
+        std::vector<node*> nodes;
+        std::vector<cell*> cells;
+        auto drop = [&](auto* p, auto& pending) {
+            if (p && p->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                pending.push_back(p);
+        };
+        drop(n, nodes);
+        drop(c, cells);
+        while (!nodes.empty() || !cells.empty()) {
+            if (!nodes.empty()) {
+                node* x = nodes.back();
+                nodes.pop_back();
+                drop(x->children, cells);
+                delete x;
+            } else {
+                cell* x = cells.back();
+                cells.pop_back();
+                drop(x->value, nodes);
+                drop(x->next, cells);
+                delete x;
+            }
+        }
+    }
+
+    node* root_ = nullptr;
+};
+
+} // namespace p_linked_list
+
+#endif
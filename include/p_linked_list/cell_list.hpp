@@ -0,0 +1,323 @@
+// Cell lists for short-range neighbour search in particle simulations.
+//
+// The box is divided into a 3-D grid of cells no smaller than the cutoff
+// radius, and each cell keeps a linked list of its particles in plain index
+// arrays: head[cell], next[particle] and prev[particle].  All neighbours of
+// a particle within the cutoff are then in its own cell or one of the 26
+// around it.
+//
+// update() recomputes every particle's cell but relinks only those that
+// crossed a cell boundary, each in O(1) thanks to the prev links.  When more
+// than a set fraction of particles moved, it falls back to rebuild().  That
+// is a counting sort by cell: per-thread histograms, a prefix sum and a
+// scatter, followed by linking each cell's run.  It leaves every cell's list
+// in ascending particle order.
+//
+// for_each_pair() visits each pair within the cutoff once by scanning every
+// cell against itself and the 13 neighbours of its forward half-shell.  The
+// box is not periodic; particles outside it are binned into the edge cells.
+
+#ifndef P_LINKED_LIST_CELL_LIST_HPP
+#define P_LINKED_LIST_CELL_LIST_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace p_linked_list {
+
+template <class T = double>
+class cell_list {
+public:
+    using vec = std::array<T, 3>;
+
+    static constexpr std::uint32_t none = 0xffffffffu;
+
+    // Cells are at least `cutoff` wide along every axis.
+    cell_list(const vec& box_min, const vec& box_max, T cutoff) : min_(box_min), cutoff_(cutoff) {
+        if (!(cutoff > 0))
+            throw std::invalid_argument("cell_list: cutoff must be positive");
+        std::size_t cells = 1;
+        for (int a = 0; a < 3; ++a) {
+            T extent = box_max[a] - box_min[a];
+            if (!(extent > 0))
+                throw std::invalid_argument("cell_list: empty box");
+            dims_[a] = std::max<std::size_t>(1, static_cast<std::size_t>(std::floor(extent / cutoff)));
+            inv_width_[a] = static_cast<T>(dims_[a]) / extent;
+            cells *= dims_[a];
+        }
+        if (cells >= none)
+            throw std::length_error("cell_list: too many cells");
+        head_.assign(cells, none);
+    }
+
+    cell_list(const cell_list&) = delete;
+    cell_list& operator=(const cell_list&) = delete;
+
+    // Fraction of particles that may change cell before update() rebuilds.
+    void set_rebuild_fraction(double f) noexcept { rebuild_fraction_ = f; }
+
+    // Bins every particle from scratch with a parallel counting sort
+    // (threads 0 means std::thread::hardware_concurrency()).
+    void rebuild(std::span<const vec> positions, unsigned threads = 1) {
+        if (positions.size() >= none)
+            throw std::length_error("cell_list: too many particles");
+        const std::size_t n = positions.size();
+        const std::size_t cells = head_.size();
+        cell_.resize(n);
+        next_.resize(n);
+        prev_.resize(n);
+        threads = thread_count(threads, n);
+
+        std::vector<std::size_t> bounds(threads + 1);
+        for (unsigned t = 0; t <= threads; ++t)
+            bounds[t] = n * t / threads;
+
+        // Per-thread histograms, laid out cell-major so the prefix sum below
+        // gives each thread its own stable range within every cell.
+        std::vector<std::uint32_t> counts(cells * threads, 0);
+        parallel(threads, [&](unsigned t) {
+            for (std::size_t i = bounds[t]; i < bounds[t + 1]; ++i) {
+                std::uint32_t c = cell_of(positions[i]);
+                cell_[i] = c;
+                ++counts[std::size_t(c) * threads + t];
+            }
+        });
+        std::vector<std::uint32_t> start(cells + 1);
+        std::uint32_t sum = 0;
+        for (std::size_t c = 0; c < cells; ++c) {
+            start[c] = sum;
+            for (unsigned t = 0; t < threads; ++t) {
+                std::uint32_t k = counts[c * threads + t];
+                counts[c * threads + t] = sum;
+                sum += k;
+            }
+        }
+        start[cells] = sum;
+
+        order_.resize(n);
+        parallel(threads, [&](unsigned t) {
+            for (std::size_t i = bounds[t]; i < bounds[t + 1]; ++i)
+                order_[counts[std::size_t(cell_[i]) * threads + t]++] = static_cast<std::uint32_t>(i);
+        });
+
+        parallel(threads, [&](unsigned t) {
+            const std::size_t c0 = cells * t / threads;
+            const std::size_t c1 = cells * (t + 1) / threads;
+            for (std::size_t c = c0; c < c1; ++c) {
+                std::uint32_t prev = none;
+                head_[c] = start[c] < start[c + 1] ? order_[start[c]] : none;
+                for (std::uint32_t k = start[c]; k < start[c + 1]; ++k) {
+                    std::uint32_t i = order_[k];
+                    prev_[i] = prev;
+                    if (prev != none)
+                        next_[prev] = i;
+                    prev = i;
+                }
+                if (prev != none)
+                    next_[prev] = none;
+            }
+        });
+        last_moved_ = n;
+    }
+
+    // Rebins after the particles moved; returns the number that changed
+    // cell.  A change in particle count forces a rebuild().
+    std::size_t update(std::span<const vec> positions, unsigned threads = 1) {
+        if (positions.size() != cell_.size()) {
+            rebuild(positions, threads);
+            return positions.size();
+        }
+        const std::size_t n = positions.size();
+        threads = thread_count(threads, n);
+        moved_.resize(threads);
+        parallel(threads, [&](unsigned t) {
+            auto& m = moved_[t];
+            m.clear();
+            for (std::size_t i = n * t / threads; i < n * (t + 1) / threads; ++i) {
+                std::uint32_t c = cell_of(positions[i]);
+                if (c != cell_[i])
+                    m.push_back({static_cast<std::uint32_t>(i), c});
+            }
+        });
+        std::size_t total = 0;
+        for (auto& m : moved_)
+            total += m.size();
+        if (static_cast<double>(total) > rebuild_fraction_ * static_cast<double>(n)) {
+            rebuild(positions, threads);
+            last_moved_ = total;
+            return total;
+        }
+        for (auto& m : moved_) {
+            for (auto [i, c] : m) {
+                unlink(i);
+                link_front(i, c);
+            }
+        }
+        last_moved_ = total;
+        return total;
+    }
+
+    // Calls f(i, j) once for every unordered pair of particles at most the
+    // cutoff apart, in no particular order.
+    template <class F>
+    void for_each_pair(std::span<const vec> positions, F f) const {
+        const T cut2 = cutoff_ * cutoff_;
+        for (std::size_t z = 0; z < dims_[2]; ++z)
+            for (std::size_t y = 0; y < dims_[1]; ++y)
+                for (std::size_t x = 0; x < dims_[0]; ++x) {
+                    const std::size_t c = index(x, y, z);
+                    for (std::uint32_t i = head_[c]; i != none; i = next_[i])
+                        for (std::uint32_t j = next_[i]; j != none; j = next_[j])
+                            visit(positions, i, j, cut2, f);
+                    for (const auto& o : half_shell) {
+                        const std::ptrdiff_t nx = std::ptrdiff_t(x) + o[0];
+                        const std::ptrdiff_t ny = std::ptrdiff_t(y) + o[1];
+                        const std::ptrdiff_t nz = std::ptrdiff_t(z) + o[2];
+                        if (nx < 0 || ny < 0 || nz < 0 || nx >= std::ptrdiff_t(dims_[0]) ||
+                            ny >= std::ptrdiff_t(dims_[1]) || nz >= std::ptrdiff_t(dims_[2]))
+                            continue;
+                        const std::size_t d = index(std::size_t(nx), std::size_t(ny), std::size_t(nz));
+                        for (std::uint32_t i = head_[c]; i != none; i = next_[i])
+                            for (std::uint32_t j = head_[d]; j != none; j = next_[j])
+                                visit(positions, i, j, cut2, f);
+                    }
+                }
+    }
+
+    // Calls f(j) for every particle j != i at most the cutoff from i.
+    template <class F>
+    void for_each_neighbour(std::span<const vec> positions, std::uint32_t i, F f) const {
+        const T cut2 = cutoff_ * cutoff_;
+        const std::uint32_t c = cell_[i];
+        const std::size_t x = c % dims_[0];
+        const std::size_t y = c / dims_[0] % dims_[1];
+        const std::size_t z = c / (dims_[0] * dims_[1]);
+        for (std::ptrdiff_t dz = -1; dz <= 1; ++dz)
+            for (std::ptrdiff_t dy = -1; dy <= 1; ++dy)
+                for (std::ptrdiff_t dx = -1; dx <= 1; ++dx) {
+                    const std::ptrdiff_t nx = std::ptrdiff_t(x) + dx;
+                    const std::ptrdiff_t ny = std::ptrdiff_t(y) + dy;
+                    const std::ptrdiff_t nz = std::ptrdiff_t(z) + dz;
+                    if (nx < 0 || ny < 0 || nz < 0 || nx >= std::ptrdiff_t(dims_[0]) ||
+                        ny >= std::ptrdiff_t(dims_[1]) || nz >= std::ptrdiff_t(dims_[2]))
+                        continue;
+                    const std::size_t d = index(std::size_t(nx), std::size_t(ny), std::size_t(nz));
+                    for (std::uint32_t j = head_[d]; j != none; j = next_[j])
+                        if (j != i && distance2(positions[i], positions[j]) <= cut2)
+                            f(j);
+                }
+    }
+
+    // Per-cell list access: iterate with `for (i = head(c); i != none; i = next(i))`.
+    std::uint32_t head(std::size_t cell) const noexcept { return head_[cell]; }
+    std::uint32_t next(std::uint32_t i) const noexcept { return next_[i]; }
+    std::uint32_t cell(std::uint32_t i) const noexcept { return cell_[i]; }
+
+    std::size_t cell_count() const noexcept { return head_.size(); }
+    std::array<std::size_t, 3> dims() const noexcept { return dims_; }
+    std::size_t last_moved() const noexcept { return last_moved_; }
+
+private:
+    // Forward half of the 26 neighbour offsets: each unordered pair of
+    // adjacent cells appears once.
+    static constexpr std::array<std::array<int, 3>, 13> half_shell{{
+        {1, 0, 0}, {-1, 1, 0}, {0, 1, 0}, {1, 1, 0},
+        {-1, -1, 1}, {0, -1, 1}, {1, -1, 1}, {-1, 0, 1}, {0, 0, 1},
+        {1, 0, 1}, {-1, 1, 1}, {0, 1, 1}, {1, 1, 1},
+    }};
+
+    std::size_t index(std::size_t x, std::size_t y, std::size_t z) const noexcept {
+        return (z * dims_[1] + y) * dims_[0] + x;
+    }
+
+    std::uint32_t cell_of(const vec& p) const noexcept {
+        std::size_t k[3];
+        for (int a = 0; a < 3; ++a) {
+            T f = std::floor((p[a] - min_[a]) * inv_width_[a]);
+            k[a] = f < 0 ? 0 : std::min(static_cast<std::size_t>(f), dims_[a] - 1);
+        }
+        return static_cast<std::uint32_t>(index(k[0], k[1], k[2]));
+    }
+
+    static T distance2(const vec& a, const vec& b) noexcept {
+        T dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+        return dx * dx + dy * dy + dz * dz;
+    }
+
+    template <class F>
+    static void visit(std::span<const vec> positions, std::uint32_t i, std::uint32_t j, T cut2, F& f) {
+        if (distance2(positions[i], positions[j]) <= cut2)
+            f(i, j);
+    }
+
+    void unlink(std::uint32_t i) noexcept {
+        if (prev_[i] != none)
+            next_[prev_[i]] = next_[i];
+        else
+            head_[cell_[i]] = next_[i];
+        if (next_[i] != none)
+            prev_[next_[i]] = prev_[i];
+    }
+
+    void link_front(std::uint32_t i, std::uint32_t c) noexcept {
+        cell_[i] = c;
+        prev_[i] = none;
+        next_[i] = head_[c];
+        if (head_[c] != none)
+            prev_[head_[c]] = i;
+        head_[c] = i;
+    }
+
+    static unsigned thread_count(unsigned threads, std::size_t n) {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        return static_cast<unsigned>(std::min<std::size_t>(threads, n / min_per_thread + 1));
+    }
+
+    template <class F>
+    static void parallel(unsigned threads, F f) {
+        if (threads == 1) {
+            f(0u);
+            return;
+        }
+        std::vector<std::jthread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t)
+            workers.emplace_back([&f, t] { f(t); });
+        f(0u);
+        for (auto& w : workers)
+            w.join();
+    }
+
+    static constexpr std::size_t min_per_thread = 1 << 14;
+
+    vec min_;
+    std::array<T, 3> inv_width_;
+    std::array<std::size_t, 3> dims_;
+    T cutoff_;
+    double rebuild_fraction_ = 0.1;
+    std::size_t last_moved_ = 0;
+
+    std::vector<std::uint32_t> head_;
+    std::vector<std::uint32_t> next_;
+    std::vector<std::uint32_t> prev_;
+    std::vector<std::uint32_t> cell_;
+    std::vector<std::uint32_t> order_;
+
+    struct move {
+        std::uint32_t particle;
+        std::uint32_t cell;
+    };
+    std::vector<std::vector<move>> moved_;
+};
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,453 @@
+// Go-style channels over linked queues, with multi-channel select.
+//
+// A channel<T> holds a linked FIFO of buffered values plus two intrusive
+// linked queues of blocked senders and receivers.  Capacity 0 gives an
+// unbuffered (rendezvous) channel, where a value passes directly from sender
+// to receiver; capacity channel<T>::unbounded never blocks senders.
+//
+// Every blocking operation, including select(), parks on a single parker:
+// one atomic word waited on with std::atomic::wait.  A select enqueues one
+// waiter per case, all pointing at the same parker; whichever counterpart
+// first claims the parker (a compare-exchange) completes that case, and the
+// others find it claimed and skip it.  Nothing polls.  Wakers finish a
+// parker while holding the channel lock, and a woken thread retakes that lock
+// before returning, so the parker never dies under a notify in progress.
+//
+// Sending on a closed channel throws channel_closed; receiving from one
+// yields std::nullopt once its buffer is drained.
+
+#ifndef P_LINKED_LIST_CHANNEL_HPP
+#define P_LINKED_LIST_CHANNEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace p_linked_list {
+
+class channel_closed : public std::logic_error {
+public:
+    channel_closed() : std::logic_error("send on closed channel") {}
+};
+
+namespace detail {
+
+struct parker {
+    static constexpr int waiting = 0;
+    static constexpr int claimed = 1;
+    static constexpr int done = 2;
+
+    std::atomic<int> state{waiting};
+    std::size_t fired = 0;
+    bool closed = false;
+
+    bool claim() noexcept {
+        int expected = waiting;
+        return state.compare_exchange_strong(expected, claimed, std::memory_order_acq_rel);
+    }
+
+    void finish(std::size_t index, bool was_closed) noexcept {
+        fired = index;
+        closed = was_closed;
+        state.store(done, std::memory_order_release);
+        state.notify_one();
+    }
+
+    void park() noexcept {
+        for (int s; (s = state.load(std::memory_order_acquire)) != done;)
+            state.wait(s, std::memory_order_acquire);
+    }
+};
+
+struct waiter {
+    waiter* prev = nullptr;
+    waiter* next = nullptr;
+    parker* owner = nullptr;
+    std::size_t index = 0;
+    void* slot = nullptr;  // T* for senders, std::optional<T>* for receivers
+    bool linked = false;
+};
+
+// Intrusive FIFO of waiters.
+struct waiter_queue {
+    waiter* head = nullptr;
+    waiter* tail = nullptr;
+
+    void push(waiter* w) noexcept {
+        w->prev = tail;
+        w->next = nullptr;
+        if (tail)
+            tail->next = w;
+        else
+            head = w;
+        tail = w;
+        w->linked = true;
+    }
+
+    void remove(waiter* w) noexcept {
+        if (!w->linked)
+            return;
+        if (w->prev)
+            w->prev->next = w->next;
+        else
+            head = w->next;
+        if (w->next)
+            w->next->prev = w->prev;
+        else
+            tail = w->prev;
+        w->linked = false;
+    }
+
+    // Pops waiters until one can be claimed; returns it or nullptr.
+    waiter* claim_front() noexcept {
+        while (waiter* w = head) {
+            remove(w);
+            if (w->owner->claim())
+                return w;
+        }
+        return nullptr;
+    }
+};
+
+} // namespace detail
+
+class channel_base {
+public:
+    channel_base() = default;
+    channel_base(const channel_base&) = delete;
+    channel_base& operator=(const channel_base&) = delete;
+
+protected:
+    friend class select_case;
+
+    std::mutex mutex_;
+};
+
+// One arm of a select(); see send_case and recv_case.
+class select_case {
+public:
+    virtual ~select_case() = default;
+
+protected:
+    template <class... Cases>
+    friend std::size_t select(Cases&... cases);
+    template <class... Cases>
+    friend std::optional<std::size_t> try_select(Cases&... cases);
+
+    std::mutex* mutex() noexcept { return &base().mutex_; }
+
+    virtual channel_base& base() noexcept = 0;
+    // Completes the case immediately if possible; the channel is locked.
+    virtual bool try_now() = 0;
+    virtual void arm(detail::waiter& w) = 0;
+    virtual void disarm(detail::waiter& w) noexcept = 0;
+    virtual void finish_closed() {}
+};
+
+template <class T>
+class channel : public channel_base {
+public:
+    static constexpr std::size_t unbounded = std::numeric_limits<std::size_t>::max();
+
+    // `capacity` 0 makes an unbuffered channel.
+    explicit channel(std::size_t capacity = 0) : capacity_(capacity) {}
+
+    ~channel() {
+        while (node* n = head_) {
+            head_ = n->next;
+            delete n;
+        }
+    }
+
+    void send(T value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (try_send_locked(value))
+            return;
+        detail::parker p;
+        detail::waiter w;
+        w.owner = &p;
+        w.slot = &value;
+        senders_.push(&w);
+        lock.unlock();
+        p.park();
+        lock.lock();
+        if (p.closed)
+            throw channel_closed();
+    }
+
+    // Blocks until a value arrives; std::nullopt once closed and drained.
+    std::optional<T> recv() {
+        std::optional<T> out;
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (try_recv_locked(out))
+            return out;
+        detail::parker p;
+        detail::waiter w;
+        w.owner = &p;
+        w.slot = &out;
+        receivers_.push(&w);
+        lock.unlock();
+        p.park();
+        lock.lock();
+        return out;
+    }
+
+    bool try_send(T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return try_send_locked(value);
+    }
+
+    // Returns false if nothing is ready; otherwise sets `out` (std::nullopt
+    // meaning closed).
+    bool try_recv(std::optional<T>& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return try_recv_locked(out);
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_)
+            return;
+        closed_ = true;
+        while (detail::waiter* w = receivers_.claim_front()) {
+            static_cast<std::optional<T>*>(w->slot)->reset();
+            w->owner->finish(w->index, false);
+        }
+        while (detail::waiter* w = senders_.claim_front())
+            w->owner->finish(w->index, true);
+    }
+
+    std::size_t size() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+    std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+    template <class>
+    friend class send_case;
+    template <class>
+    friend class recv_case;
+
+    struct node {
+        node* next;
+        T value;
+    };
+
+    void push_buffer(T&& v) { link_back(new node{nullptr, std::move(v)}); }
+
+    void link_back(node* n) noexcept {
+        n->next = nullptr;
+        if (tail_)
+            tail_->next = n;
+        else
+            head_ = n;
+        tail_ = n;
+        ++count_;
+    }
+
+    std::unique_ptr<node> unlink_front() noexcept {
+        node* n = head_;
+        head_ = n->next;
+        if (!head_)
+            tail_ = nullptr;
+        --count_;
+        return std::unique_ptr<node>(n);
+    }
+
+    bool try_send_locked(T& value) {
+        if (closed_)
+            throw channel_closed();
+        if (detail::waiter* w = receivers_.claim_front()) {
+            *static_cast<std::optional<T>*>(w->slot) = std::move(value);
+            w->owner->finish(w->index, false);
+            return true;
+        }
+        if (count_ < capacity_) {
+            push_buffer(std::move(value));
+            return true;
+        }
+        return false;
+    }
+
+    bool try_recv_locked(std::optional<T>& out) {
+        if (count_) {
+            std::unique_ptr<node> n = unlink_front();
+            out = std::move(n->value);
+            // Room was made: admit one blocked sender into the buffer,
+            // reusing the node just taken so nothing is allocated after
+            // the sender has been claimed.
+            if (detail::waiter* w = senders_.claim_front()) {
+                n->value = std::move(*static_cast<T*>(w->slot));
+                link_back(n.release());
+                w->owner->finish(w->index, false);
+            }
+            return true;
+        }
+        if (detail::waiter* w = senders_.claim_front()) {
+            out = std::move(*static_cast<T*>(w->slot));
+            w->owner->finish(w->index, false);
+            return true;
+        }
+        if (closed_) {
+            out.reset();
+            return true;
+        }
+        return false;
+    }
+
+    std::size_t capacity_;
+    node* head_ = nullptr;
+    node* tail_ = nullptr;
+    std::size_t count_ = 0;
+    bool closed_ = false;
+    detail::waiter_queue senders_;
+    detail::waiter_queue receivers_;
+};
+
+template <class T>
+class send_case : public select_case {
+public:
+    send_case(channel<T>& ch, T value) : ch_(ch), value_(std::move(value)) {}
+
+private:
+    channel_base& base() noexcept override { return ch_; }
+    bool try_now() override { return ch_.try_send_locked(value_); }
+    void arm(detail::waiter& w) override {
+        w.slot = &value_;
+        ch_.senders_.push(&w);
+    }
+    void disarm(detail::waiter& w) noexcept override { ch_.senders_.remove(&w); }
+    void finish_closed() override { throw channel_closed(); }
+
+    channel<T>& ch_;
+    T value_;
+};
+
+template <class T>
+class recv_case : public select_case {
+public:
+    explicit recv_case(channel<T>& ch) : ch_(ch) {}
+
+    // The received value, or std::nullopt if the channel was closed.
+    std::optional<T> value;
+
+private:
+    channel_base& base() noexcept override { return ch_; }
+    bool try_now() override { return ch_.try_recv_locked(value); }
+    void arm(detail::waiter& w) override {
+        w.slot = &value;
+        ch_.receivers_.push(&w);
+    }
+    void disarm(detail::waiter& w) noexcept override { ch_.receivers_.remove(&w); }
+
+    channel<T>& ch_;
+};
+
+namespace detail {
+
+// Locks the distinct channels of a select in address order.
+template <std::size_t N>
+class select_lock {
+public:
+    explicit select_lock(const std::array<std::mutex*, N>& mutexes) : mutexes_(mutexes) {
+        std::sort(mutexes_.begin(), mutexes_.end(), std::less<std::mutex*>());
+        count_ = static_cast<std::size_t>(std::unique(mutexes_.begin(), mutexes_.end()) - mutexes_.begin());
+        lock();
+    }
+
+    ~select_lock() {
+        if (locked_)
+            unlock();
+    }
+
+    void lock() {
+        for (std::size_t i = 0; i < count_; ++i)
+            mutexes_[i]->lock();
+        locked_ = true;
+    }
+
+    void unlock() noexcept {
+        for (std::size_t i = count_; i-- > 0;)
+            mutexes_[i]->unlock();
+        locked_ = false;
+    }
+
+private:
+    std::array<std::mutex*, N> mutexes_;
+    std::size_t count_ = 0;
+    bool locked_ = false;
+};
+
+// Rotates the polling start so no case is favoured when several are ready.
+inline std::size_t select_start(std::size_t n) noexcept {
+    thread_local std::uint64_t rng = reinterpret_cast<std::uintptr_t>(&rng) | 1;
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return static_cast<std::size_t>(rng % n);
+}
+
+} // namespace detail
+
+// Completes one ready case and returns its index, blocking until one is.
+template <class... Cases>
+std::size_t select(Cases&... cases) {
+    constexpr std::size_t n = sizeof...(Cases);
+    static_assert(n > 0, "select needs at least one case");
+    std::array<select_case*, n> cs{&cases...};
+    detail::select_lock<n> lock({cases.mutex()...});
+
+    const std::size_t start = detail::select_start(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t i = (start + k) % n;
+        if (cs[i]->try_now())
+            return i;
+    }
+
+    detail::parker p;
+    std::array<detail::waiter, n> ws;
+    for (std::size_t i = 0; i < n; ++i) {
+        ws[i].owner = &p;
+        ws[i].index = i;
+        cs[i]->arm(ws[i]);
+    }
+    lock.unlock();
+    p.park();
+    lock.lock();
+    for (std::size_t i = 0; i < n; ++i)
+        cs[i]->disarm(ws[i]);
+    lock.unlock();
+    if (p.closed)
+        cs[p.fired]->finish_closed();
+    return p.fired;
+}
+
+// Like select(), but returns std::nullopt instead of blocking (Go's default).
+template <class... Cases>
+std::optional<std::size_t> try_select(Cases&... cases) {
+    constexpr std::size_t n = sizeof...(Cases);
+    std::array<select_case*, n> cs{&cases...};
+    detail::select_lock<n> lock({cases.mutex()...});
+    const std::size_t start = detail::select_start(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t i = (start + k) % n;
+        if (cs[i]->try_now())
+            return i;
+    }
+    return std::nullopt;
+}
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,343 @@
+// Exact-cover solver using Knuth's Dancing Links (Algorithm X).
+//
+// The matrix is a torus of circular doubly linked lists: each column header
+// heads a vertical list of the rows that cover it, and the cells of a row
+// form a horizontal ring.  Covering a column unlinks it and every row that
+// touches it in O(cells); uncovering relinks them in exact reverse order,
+// because an unlinked node still remembers its neighbours.  The search
+// always branches on the column with the fewest remaining rows.
+//
+// Links are 32-bit indices into one vector of nodes, which makes a node 24
+// bytes and the whole matrix a flat copyable array.  solve() with several
+// threads uses this: it expands the first levels of the search tree into
+// prefixes, and each thread works on its own copy of the matrix, replaying
+// a prefix, searching below it and backtracking out again.  All threads
+// stop once any of them finds a solution.
+//
+// Columns [0, primary) must be covered exactly once; columns
+// [primary, primary + secondary) at most once.
+
+#ifndef P_LINKED_LIST_EXACT_COVER_HPP
+#define P_LINKED_LIST_EXACT_COVER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <initializer_list>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace p_linked_list {
+
+class exact_cover {
+public:
+    explicit exact_cover(std::size_t primary, std::size_t secondary = 0) {
+        const std::size_t columns = primary + secondary;
+        if (columns >= max_nodes)
+            throw std::length_error("exact_cover: too many columns");
+        m_.nodes.resize(columns + 1);
+        m_.size.assign(columns + 1, 0);
+        seen_.assign(columns, false);
+        for (std::uint32_t c = 0; c <= columns; ++c) {
+            node& n = m_.nodes[c];
+            n.u = n.d = n.col = c;
+            n.row = no_row;
+            n.l = n.r = c;
+        }
+        // Only the root and the primary columns form the header ring; a
+        // secondary header links to itself and is never chosen.
+        for (std::uint32_t c = 0; c <= primary; ++c) {
+            m_.nodes[c].r = c == primary ? 0 : c + 1;
+            m_.nodes[c].l = c == 0 ? static_cast<std::uint32_t>(primary) : c - 1;
+        }
+    }
+
+    // Adds a row covering the given distinct columns; returns its id, which
+    // is what solutions report.  A column out of range throws
+    // std::out_of_range and a repeated one std::invalid_argument.
+    std::size_t add_row(std::span<const std::size_t> columns) {
+        if (columns.empty())
+            throw std::invalid_argument("exact_cover: empty row");
+        if (m_.nodes.size() + columns.size() > max_nodes)
+            throw std::length_error("exact_cover: too many cells");
+        // Validate before linking anything, so a bad row leaves no trace.  A
+        // repeated column would be linked twice and unlinked twice by cover.
+        std::size_t checked = 0;
+        for (; checked < columns.size(); ++checked) {
+            const std::size_t c = columns[checked];
+            if (c >= seen_.size() || seen_[c])
+                break;
+            seen_[c] = true;
+        }
+        for (std::size_t k = 0; k < checked; ++k)
+            seen_[columns[k]] = false;
+        if (checked < columns.size()) {
+            if (columns[checked] >= seen_.size())
+                throw std::out_of_range("exact_cover: column out of range");
+            throw std::invalid_argument("exact_cover: repeated column");
+        }
+        const std::uint32_t first = static_cast<std::uint32_t>(m_.nodes.size());
+        const std::uint32_t row = static_cast<std::uint32_t>(rows_++);
+        for (std::size_t k = 0; k < columns.size(); ++k) {
+            const std::uint32_t c = static_cast<std::uint32_t>(columns[k] + 1);
+            const std::uint32_t i = first + static_cast<std::uint32_t>(k);
+            node n;
+            n.col = c;
+            n.row = row;
+            n.u = m_.nodes[c].u;
+            n.d = c;
+            n.l = k == 0 ? i : i - 1;
+            n.r = first;
+            m_.nodes.push_back(n);
+            m_.nodes[n.u].d = i;
+            m_.nodes[c].u = i;
+            ++m_.size[c];
+            if (k) {
+                m_.nodes[i - 1].r = i;
+                m_.nodes[first].l = i;
+            }
+        }
+        return row;
+    }
+
+    std::size_t add_row(std::initializer_list<std::size_t> columns) {
+        return add_row(std::span<const std::size_t>(columns.begin(), columns.size()));
+    }
+
+    std::size_t rows() const noexcept { return rows_; }
+
+    // Returns one solution as row ids, or std::nullopt if there is none.
+    // `threads` > 1 searches subtrees in parallel on copies of the matrix
+    // (0 means std::thread::hardware_concurrency()).
+    std::optional<std::vector<std::size_t>> solve(unsigned threads = 1) {
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        std::optional<std::vector<std::size_t>> result;
+        auto take_first = [&](std::span<const std::uint32_t> path) {
+            result = row_ids(path);
+            return false;
+        };
+        if (threads == 1) {
+            std::vector<std::uint32_t> path;
+            m_.search(path, take_first, nullptr);
+            return result;
+        }
+
+        std::vector<std::vector<std::uint32_t>> prefixes = split(threads);
+        std::atomic<std::size_t> next{0};
+        std::atomic<bool> stop{false};
+        std::mutex result_mutex;
+        std::exception_ptr error;
+        auto work = [&] {
+            try {
+                matrix local = m_;
+                std::vector<std::uint32_t> path;
+                auto report = [&](std::span<const std::uint32_t> p) {
+                    std::lock_guard<std::mutex> lock(result_mutex);
+                    if (!result)
+                        result = row_ids(p);
+                    stop.store(true, std::memory_order_relaxed);
+                    return false;
+                };
+                for (std::size_t i; !stop.load(std::memory_order_relaxed) &&
+                                    (i = next.fetch_add(1, std::memory_order_relaxed)) < prefixes.size();) {
+                    path = prefixes[i];
+                    for (std::uint32_t r : path)
+                        local.select(r);
+                    local.search(path, report, &stop);
+                    for (std::size_t k = prefixes[i].size(); k-- > 0;)
+                        local.unselect(prefixes[i][k]);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(result_mutex);
+                if (!error)
+                    error = std::current_exception();
+                stop.store(true, std::memory_order_relaxed);
+            }
+        };
+        std::vector<std::jthread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned t = 1; t < threads; ++t)
+            workers.emplace_back(work);
+        work();
+        for (auto& w : workers)
+            w.join();
+        if (error)
+            std::rethrow_exception(error);
+        return result;
+    }
+
+    // Calls f(std::span<const std::size_t> rows) for each solution until it
+    // returns false; returns the number of solutions visited.
+    template <class F>
+    std::size_t for_each_solution(F f) {
+        std::size_t count = 0;
+        std::vector<std::uint32_t> path;
+        auto emit = [&](std::span<const std::uint32_t> p) {
+            ++count;
+            std::vector<std::size_t> ids = row_ids(p);
+            return static_cast<bool>(f(std::span<const std::size_t>(ids)));
+        };
+        m_.search(path, emit, nullptr);
+        return count;
+    }
+
+    std::size_t count_solutions(std::size_t limit = std::numeric_limits<std::size_t>::max()) {
+        std::size_t count = 0;
+        std::vector<std::uint32_t> path;
+        auto emit = [&](std::span<const std::uint32_t>) { return ++count < limit; };
+        m_.search(path, emit, nullptr);
+        return count;
+    }
+
+private:
+    static constexpr std::size_t max_nodes = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint32_t no_row = std::numeric_limits<std::uint32_t>::max();
+
+    struct node {
+        std::uint32_t l, r, u, d;
+        std::uint32_t col;
+        std::uint32_t row;
+    };
+
+    struct matrix {
+        std::vector<node> nodes;           // [0] root, [1, columns] headers, then cells
+        std::vector<std::uint32_t> size;   // rows remaining per column
+
+        void cover(std::uint32_t c) noexcept {
+            nodes[nodes[c].r].l = nodes[c].l;
+            nodes[nodes[c].l].r = nodes[c].r;
+            for (std::uint32_t i = nodes[c].d; i != c; i = nodes[i].d) {
+                for (std::uint32_t j = nodes[i].r; j != i; j = nodes[j].r) {
+                    nodes[nodes[j].d].u = nodes[j].u;
+                    nodes[nodes[j].u].d = nodes[j].d;
+                    --size[nodes[j].col];
+                }
+            }
+        }
+
+        void uncover(std::uint32_t c) noexcept {
+            for (std::uint32_t i = nodes[c].u; i != c; i = nodes[i].u) {
+                for (std::uint32_t j = nodes[i].l; j != i; j = nodes[j].l) {
+                    ++size[nodes[j].col];
+                    nodes[nodes[j].d].u = j;
+                    nodes[nodes[j].u].d = j;
+                }
+            }
+            nodes[nodes[c].r].l = c;
+            nodes[nodes[c].l].r = c;
+        }
+
+        // Takes the row of cell r into the partial solution.
+        void select(std::uint32_t r) noexcept {
+            cover(nodes[r].col);
+            for (std::uint32_t j = nodes[r].r; j != r; j = nodes[j].r)
+                cover(nodes[j].col);
+        }
+
+        void unselect(std::uint32_t r) noexcept {
+            for (std::uint32_t j = nodes[r].l; j != r; j = nodes[j].l)
+                uncover(nodes[j].col);
+            uncover(nodes[r].col);
+        }
+
+        // Primary column with the fewest rows, or 0 if all are covered.
+        std::uint32_t choose() const noexcept {
+            std::uint32_t best = 0;
+            std::uint32_t best_size = std::numeric_limits<std::uint32_t>::max();
+            for (std::uint32_t c = nodes[0].r; c != 0; c = nodes[c].r) {
+                if (size[c] < best_size) {
+                    best = c;
+                    best_size = size[c];
+                    if (best_size <= 1)
+                        break;
+                }
+            }
+            return best;
+        }
+
+        // Extends `path` depth-first; emit(path) returns false to stop.
+        // Returns false once stopped.
+        template <class Emit>
+        bool search(std::vector<std::uint32_t>& path, Emit& emit, const std::atomic<bool>* stop) {
+            if (stop && stop->load(std::memory_order_relaxed))
+                return false;
+            const std::uint32_t c = choose();
+            if (c == 0)
+                return emit(std::span<const std::uint32_t>(path));
+            if (size[c] == 0)
+                return true;
+            cover(c);
+            bool go = true;
+            for (std::uint32_t r = nodes[c].d; go && r != c; r = nodes[r].d) {
+                path.push_back(r);
+                for (std::uint32_t j = nodes[r].r; j != r; j = nodes[j].r)
+                    cover(nodes[j].col);
+                go = search(path, emit, stop);
+                for (std::uint32_t j = nodes[r].l; j != r; j = nodes[j].l)
+                    uncover(nodes[j].col);
+                path.pop_back();
+            }
+            uncover(c);
+            return go;
+        }
+    };
+
+    std::vector<std::size_t> row_ids(std::span<const std::uint32_t> path) const {
+        std::vector<std::size_t> ids;
+        ids.reserve(path.size());
+        for (std::uint32_t r : path)
+            ids.push_back(m_.nodes[r].row);
+        std::sort(ids.begin(), ids.end());
+        return ids;
+    }
+
+    // Expands the search tree until there are enough live prefixes to keep
+    // `threads` threads busy, or the tree runs out of depth.
+    std::vector<std::vector<std::uint32_t>> split(unsigned threads) {
+        std::vector<std::vector<std::uint32_t>> level(1);
+        for (std::size_t depth = 0; depth < max_split_depth && level.size() < threads * prefixes_per_thread;
+             ++depth) {
+            std::vector<std::vector<std::uint32_t>> deeper;
+            bool grew = false;
+            for (const auto& prefix : level) {
+                for (std::uint32_t r : prefix)
+                    m_.select(r);
+                const std::uint32_t c = m_.choose();
+                if (c == 0) {
+                    deeper.push_back(prefix);  // already a solution
+                } else {
+                    for (std::uint32_t r = m_.nodes[c].d; r != c; r = m_.nodes[r].d) {
+                        deeper.push_back(prefix);
+                        deeper.back().push_back(r);
+                        grew = true;
+                    }
+                }
+                for (std::size_t k = prefix.size(); k-- > 0;)
+                    m_.unselect(prefix[k]);
+            }
+            level.swap(deeper);
+            if (!grew)
+                break;
+        }
+        return level;
+    }
+
+    static constexpr std::size_t max_split_depth = 6;
+    static constexpr std::size_t prefixes_per_thread = 8;
+
+    matrix m_;
+    std::size_t rows_ = 0;
+    std::vector<bool> seen_;  // scratch for add_row(), all false between calls
+};
+
+} // namespace p_linked_list
+
+#endif
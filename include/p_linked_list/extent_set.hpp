@@ -0,0 +1,334 @@
+// Coalescing set of half-open extents [start, end), for free-space and ID
+// range tracking.
+//
+// Extents are nodes of a skip list ordered by start, so locating the extent
+// around a key is O(log n) expected, and the bottom level is a plain sorted
+// linked list for iteration and neighbour access.  insert() merges the new
+// range with every extent it overlaps or touches, and erase() trims or splits
+// the extents it cuts.
+//
+// Each skip link also records the largest extent length among the nodes it
+// jumps over.  first_fit() can then skip any span that has no large enough
+// extent and find the lowest-addressed fit in O(log n).  Best fit uses a
+// separate ordered index of (length, start).  Link maxima are repaired
+// bottom-up along the search path after every change, O(1) expected per
+// level, stopping at the first level whose maximum comes out unchanged.
+
+#ifndef P_LINKED_LIST_EXTENT_SET_HPP
+#define P_LINKED_LIST_EXTENT_SET_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <set>
+#include <type_traits>
+#include <utility>
+
+namespace p_linked_list {
+
+template <class Key = std::uint64_t>
+class extent_set {
+    static_assert(std::is_unsigned_v<Key>);
+
+    static constexpr int max_level = 16;  // p = 1/4: ample for 2^32 extents
+
+    struct node;
+
+    struct link {
+        node* to;
+        Key max_len;  // longest extent in (this node, to]
+    };
+
+    // Links follow the header, so it is aligned for them: with 32-bit keys
+    // the header alone would leave them misaligned.
+    struct alignas(link) node {
+        Key start;
+        Key end;
+        int height;
+
+        link* links() noexcept { return reinterpret_cast<link*>(this + 1); }
+        Key length() const noexcept { return end - start; }
+    };
+
+public:
+    struct extent {
+        Key start;
+        Key end;
+
+        Key length() const noexcept { return end - start; }
+        friend bool operator==(const extent&, const extent&) = default;
+    };
+
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = extent;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = extent;
+
+        iterator() = default;
+
+        extent operator*() const noexcept { return {n_->start, n_->end}; }
+        iterator& operator++() noexcept { n_ = n_->links()[0].to; return *this; }
+        iterator operator++(int) noexcept { iterator t = *this; ++*this; return t; }
+        friend bool operator==(iterator a, iterator b) noexcept { return a.n_ == b.n_; }
+        friend bool operator!=(iterator a, iterator b) noexcept { return a.n_ != b.n_; }
+
+    private:
+        friend class extent_set;
+        explicit iterator(node* n) : n_(n) {}
+        node* n_ = nullptr;
+    };
+
+    explicit extent_set(std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : mr_(mr), by_size_(mr) {
+        head_ = make_node(0, 0, max_level);
+    }
+
+    extent_set(const extent_set&) = delete;
+    extent_set& operator=(const extent_set&) = delete;
+
+    ~extent_set() {
+        for (node* n = head_; n;) {
+            node* next = n->links()[0].to;
+            free_node(n);
+            n = next;
+        }
+    }
+
+    // Adds [start, end), merging with overlapping and adjacent extents.  The
+    // merged extent reuses the node of the extent it absorbs first, so only
+    // the nodes past that one are freed.
+    void insert(Key start, Key end) {
+        if (start >= end)
+            return;
+        node* p = last_at_or_before(start);
+        node* target = p != head_ && p->end >= start ? p : nullptr;
+        node* s = p->links()[0].to;
+        if (!target && s && s->start <= end) {
+            // Extending the successor downwards keeps it after p.
+            target = s;
+            s = s->links()[0].to;
+        }
+        Key new_end = target ? std::max(target->end, end) : end;
+        while (s && s->start <= new_end) {
+            new_end = std::max(new_end, s->end);
+            node* next = s->links()[0].to;
+            erase_node(s);
+            s = next;
+        }
+        if (target)
+            set_bounds(target, std::min(target->start, start), new_end);
+        else
+            insert_node(start, new_end);
+    }
+
+    // Removes [start, end), trimming or splitting the extents it overlaps.
+    void erase(Key start, Key end) {
+        if (start >= end)
+            return;
+        node* p = last_at_or_before(start);
+        if (p != head_ && p->end > start) {
+            const Key old_end = p->end;
+            if (p->start < start) {
+                set_bounds(p, p->start, start);
+                if (old_end > end)
+                    insert_node(end, old_end);
+            } else if (old_end > end) {
+                set_bounds(p, end, old_end);
+            } else {
+                erase_node(p);
+            }
+        }
+        p = last_at_or_before(start);
+        for (node* s = p->links()[0].to; s && s->start < end; s = p->links()[0].to) {
+            if (s->end > end) {
+                set_bounds(s, end, s->end);
+                break;
+            }
+            erase_node(s);
+        }
+    }
+
+    // The extent containing `key`, if any.
+    std::optional<extent> find(Key key) const {
+        node* p = last_at_or_before(key);
+        if (p != head_ && key < p->end)
+            return extent{p->start, p->end};
+        return std::nullopt;
+    }
+
+    bool contains(Key key) const { return find(key).has_value(); }
+
+    // Lowest-addressed extent at least `length` long.
+    std::optional<extent> first_fit(Key length) const {
+        node* x = head_;
+        for (int i = max_level - 1; i >= 0; --i) {
+            while (x->links()[i].to && x->links()[i].max_len < length)
+                x = x->links()[i].to;
+        }
+        node* n = x->links()[0].to;
+        if (!n)
+            return std::nullopt;
+        return extent{n->start, n->end};
+    }
+
+    // Shortest extent at least `length` long, lowest-addressed among equals.
+    std::optional<extent> best_fit(Key length) const {
+        auto it = by_size_.lower_bound({length, Key(0)});
+        if (it == by_size_.end())
+            return std::nullopt;
+        return extent{it->second, static_cast<Key>(it->second + it->first)};
+    }
+
+    // Removes `length` units from the front of the first-fit (or best-fit)
+    // extent and returns their start.
+    std::optional<Key> allocate_first_fit(Key length) { return take(first_fit(length), length); }
+    std::optional<Key> allocate_best_fit(Key length) { return take(best_fit(length), length); }
+
+    std::size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+    Key total_length() const noexcept { return total_; }
+
+    iterator begin() const noexcept { return iterator(head_->links()[0].to); }
+    iterator end() const noexcept { return iterator(nullptr); }
+
+private:
+    std::optional<Key> take(std::optional<extent> e, Key length) {
+        if (!e || length == 0)
+            return std::nullopt;
+        erase(e->start, e->start + length);
+        return e->start;
+    }
+
+    node* make_node(Key start, Key end, int height) {
+        void* mem = mr_->allocate(sizeof(node) + height * sizeof(link), alignof(node));
+        node* n = ::new (mem) node{start, end, height};
+        for (int i = 0; i < height; ++i)
+            ::new (static_cast<void*>(n->links() + i)) link{nullptr, 0};
+        return n;
+    }
+
+    void free_node(node* n) noexcept {
+        mr_->deallocate(n, sizeof(node) + n->height * sizeof(link), alignof(node));
+    }
+
+    int random_height() noexcept {
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 7;
+        rng_ ^= rng_ << 17;
+        return std::min(max_level, 1 + std::countr_zero(rng_ | (std::uint64_t(1) << 62)) / 2);
+    }
+
+    node* last_at_or_before(Key key) const noexcept {
+        node* x = head_;
+        for (int i = max_level - 1; i >= 0; --i) {
+            while (x->links()[i].to && x->links()[i].to->start <= key)
+                x = x->links()[i].to;
+        }
+        return x;
+    }
+
+    // Fills update[i] with the last node at level i whose start is below key.
+    void path(Key key, node** update) const noexcept {
+        node* x = head_;
+        for (int i = max_level - 1; i >= 0; --i) {
+            while (x->links()[i].to && x->links()[i].to->start < key)
+                x = x->links()[i].to;
+            update[i] = x;
+        }
+    }
+
+    void recompute(node* x, int i) noexcept {
+        link& l = x->links()[i];
+        if (i == 0) {
+            l.max_len = l.to ? l.to->length() : 0;
+            return;
+        }
+        Key m = 0;
+        for (node* y = x; y != l.to; y = y->links()[i - 1].to)
+            m = std::max(m, y->links()[i - 1].max_len);
+        l.max_len = m;
+    }
+
+    // Repairs link maxima along a search path, bottom-up.  Links below
+    // `relinked` levels changed shape and are always recomputed; above that,
+    // only update[i]'s link spans the change, so once its maximum comes out
+    // unchanged no higher level can change either.  `fresh` is a newly
+    // linked node whose own links must be computed first.
+    void repair(node** update, int relinked, node* fresh = nullptr) noexcept {
+        for (int i = 0; i < max_level; ++i) {
+            if (fresh && i < fresh->height)
+                recompute(fresh, i);
+            const Key old = update[i]->links()[i].max_len;
+            recompute(update[i], i);
+            if (i >= relinked && update[i]->links()[i].max_len == old)
+                break;
+        }
+    }
+
+    void insert_node(Key start, Key end) {
+        node* update[max_level];
+        path(start, update);
+        by_size_.insert({end - start, start});
+        node* n;
+        try {
+            n = make_node(start, end, random_height());
+        } catch (...) {
+            by_size_.erase({end - start, start});
+            throw;
+        }
+        for (int i = 0; i < n->height; ++i) {
+            n->links()[i].to = update[i]->links()[i].to;
+            update[i]->links()[i].to = n;
+        }
+        repair(update, n->height, n);
+        ++count_;
+        total_ += end - start;
+    }
+
+    void erase_node(node* n) noexcept {
+        node* update[max_level];
+        path(n->start, update);
+        for (int i = 0; i < n->height; ++i)
+            update[i]->links()[i].to = n->links()[i].to;
+        repair(update, n->height);
+        by_size_.erase({n->length(), n->start});
+        --count_;
+        total_ -= n->length();
+        free_node(n);
+    }
+
+    // Changes a node's bounds without moving it past its neighbours.  The
+    // size index entry is re-keyed in place, without allocating.
+    void set_bounds(node* n, Key start, Key end) noexcept {
+        if (start == n->start && end == n->end)
+            return;
+        auto entry = by_size_.extract({n->length(), n->start});
+        entry.value() = {static_cast<Key>(end - start), start};
+        by_size_.insert(std::move(entry));
+        total_ = total_ - n->length() + (end - start);
+        n->start = start;
+        n->end = end;
+        node* update[max_level];
+        path(start, update);
+        repair(update, 0);
+    }
+
+    std::pmr::memory_resource* mr_;
+    node* head_ = nullptr;
+    std::pmr::set<std::pair<Key, Key>> by_size_;  // (length, start)
+    std::size_t count_ = 0;
+    Key total_ = 0;
+    std::uint64_t rng_ = 0x9e3779b97f4a7c15ull;
+};
+
+} // namespace p_linked_list
+
+#endif
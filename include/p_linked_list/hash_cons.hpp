@@ -0,0 +1,157 @@
+// Hash-consed immutable cons-lists.
+//
+// Every (head, tail) pair is interned exactly once per factory, so two lists
+// with equal contents are the same node.  Equality is a pointer compare and
+// lists that share a suffix share its storage.
+
+#ifndef P_LINKED_LIST_HASH_CONS_HPP
+#define P_LINKED_LIST_HASH_CONS_HPP
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <unordered_set>
+#include <utility>
+
+namespace p_linked_list {
+
+template <class T, class Hash = std::hash<T>, class KeyEqual = std::equal_to<T>>
+class hash_cons {
+public:
+    struct node {
+        node(T h, const node* t, std::size_t hv)
+            : head(std::move(h)), tail(t), size(t ? t->size + 1 : 1), hash(hv) {}
+
+        const T head;
+        const node* const tail;
+        const std::size_t size;
+        const std::size_t hash;
+    };
+
+    // Handle to an interned list.  Copying is a pointer copy; the nodes are
+    // owned by the factory and stay valid for its lifetime.
+    class list {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const T*;
+            using reference = const T&;
+
+            iterator() = default;
+            explicit iterator(const node* n) : n_(n) {}
+
+            reference operator*() const { return n_->head; }
+            pointer operator->() const { return &n_->head; }
+            iterator& operator++() { n_ = n_->tail; return *this; }
+            iterator operator++(int) { iterator t = *this; ++*this; return t; }
+            friend bool operator==(iterator a, iterator b) { return a.n_ == b.n_; }
+            friend bool operator!=(iterator a, iterator b) { return a.n_ != b.n_; }
+
+        private:
+            const node* n_ = nullptr;
+        };
+
+        list() = default;
+        explicit list(const node* n) : n_(n) {}
+
+        bool empty() const noexcept { return n_ == nullptr; }
+        std::size_t size() const noexcept { return n_ ? n_->size : 0; }
+        const T& head() const { return n_->head; }
+        list tail() const { return list(n_->tail); }
+        const node* get() const noexcept { return n_; }
+
+        iterator begin() const { return iterator(n_); }
+        iterator end() const { return iterator(); }
+
+        friend bool operator==(list a, list b) { return a.n_ == b.n_; }
+        friend bool operator!=(list a, list b) { return a.n_ != b.n_; }
+
+    private:
+        const node* n_ = nullptr;
+    };
+
+    struct stats_type {
+        std::size_t cons_calls = 0;  // nodes requested through cons()
+        std::size_t nodes = 0;       // nodes actually allocated
+
+        // Bytes a non-shared representation would have spent on top of ours.
+        std::size_t bytes_saved() const { return (cons_calls - nodes) * sizeof(node); }
+    };
+
+    explicit hash_cons(const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual())
+        : hash_(hash), table_(0, node_hash{}, node_equal{eq}) {}
+
+    hash_cons(const hash_cons&) = delete;
+    hash_cons& operator=(const hash_cons&) = delete;
+
+    static list nil() { return list(); }
+
+    // Returns the unique list whose head is `head` and whose tail is `tail`.
+    // `tail` must come from this factory.
+    list cons(T head, list tail) {
+        ++stats_.cons_calls;
+        const std::size_t hv = combine(hash_(head), tail.get());
+        probe p{&head, tail.get(), hv};
+        auto it = table_.find(p);
+        if (it != table_.end())
+            return list(*it);
+        const node* n = &nodes_.emplace_back(std::move(head), tail.get(), hv);
+        table_.insert(n);
+        ++stats_.nodes;
+        return list(n);
+    }
+
+    // Builds the list [first, last) back to front, sharing any suffix that is
+    // already interned.
+    template <class BidirIt>
+    list from_range(BidirIt first, BidirIt last) {
+        list l;
+        while (last != first)
+            l = cons(*--last, l);
+        return l;
+    }
+
+    const stats_type& stats() const noexcept { return stats_; }
+    std::size_t node_count() const noexcept { return nodes_.size(); }
+
+private:
+    struct probe {
+        const T* head;
+        const node* tail;
+        std::size_t hash;
+    };
+
+    struct node_hash {
+        using is_transparent = void;
+        std::size_t operator()(const node* n) const noexcept { return n->hash; }
+        std::size_t operator()(const probe& p) const noexcept { return p.hash; }
+    };
+
+    struct node_equal {
+        using is_transparent = void;
+        KeyEqual eq;
+        bool operator()(const node* a, const node* b) const { return a == b; }
+        bool operator()(const probe& p, const node* n) const {
+            return p.hash == n->hash && p.tail == n->tail && eq(*p.head, n->head);
+        }
+        bool operator()(const node* n, const probe& p) const { return (*this)(p, n); }
+    };
+
+    static std::size_t combine(std::size_t h, const node* tail) noexcept {
+        std::size_t t = tail ? tail->hash : 0;
+        return h ^ (t + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2));
+    }
+
+    Hash hash_;
+    std::deque<node> nodes_;
+    std::unordered_set<const node*, node_hash, node_equal> table_;
+    stats_type stats_;
+};
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,118 @@
+// Node locality analysis for live linked lists.
+//
+// analyze_locality() walks a list and looks only at the addresses of its
+// nodes, never their contents.  For each hop from one node to the next it
+// records the address stride and whether the hop leaves the current cache
+// line or page.  From those it estimates how many hops a traversal would
+// miss in cache, and recommends compaction when that estimate is high.
+//
+// The miss model assumes a cold cache (a list much larger than the cache,
+// walked once).  A hop that stays within its line is a hit.  So is a short
+// forward hop, or one that repeats the previous stride within a page, since
+// hardware prefetchers follow both.  Every other hop counts as a miss.
+// Page crossings are reported separately because they also cost TLB
+// lookups.
+//
+// The walk stops after options.max_hops hops, so a call costs a bounded
+// amount of pointer chasing and can run on production lists.  Sampling the
+// front of a list is representative when fragmentation is spread evenly;
+// for lists that age from the back, pass an iterator further in.
+
+#ifndef P_LINKED_LIST_LOCALITY_HPP
+#define P_LINKED_LIST_LOCALITY_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace p_linked_list {
+
+struct locality_options {
+    std::size_t max_hops = 4096;     // 0 walks the whole list
+    std::size_t cache_line = 64;
+    std::size_t page = 4096;
+    std::size_t prefetch_lines = 2;  // forward strides up to this many lines are treated as hits
+    double compact_threshold = 0.25; // estimated miss rate that triggers a recommendation
+    std::size_t min_hops = 64;       // fewer hops than this never trigger one
+};
+
+struct locality_report {
+    std::size_t hops = 0;
+    std::size_t backward_hops = 0;     // next node at a lower address
+    std::size_t cross_line_hops = 0;
+    std::size_t cross_page_hops = 0;
+    std::size_t estimated_misses = 0;
+
+    // stride_log2[k] counts hops whose absolute stride in bytes has bit
+    // width k, so bucket k covers [2^(k-1), 2^k).
+    std::array<std::size_t, 65> stride_log2{};
+
+    bool recommend_compaction = false;
+
+    double cross_line_fraction() const noexcept { return ratio(cross_line_hops); }
+    double cross_page_fraction() const noexcept { return ratio(cross_page_hops); }
+    double estimated_miss_rate() const noexcept { return ratio(estimated_misses); }
+
+private:
+    double ratio(std::size_t n) const noexcept {
+        return hops ? static_cast<double>(n) / static_cast<double>(hops) : 0.0;
+    }
+};
+
+// Analyzes [first, last).  `address` maps an iterator to the address of its
+// node; the default uses the element, which sits at a fixed offset in its
+// node for std::list and the lists in this library.
+template <class It, class Address>
+locality_report analyze_locality(It first, It last, const locality_options& options, Address address) {
+    locality_report r;
+    if (first == last)
+        return r;
+    const std::uintptr_t line = options.cache_line;
+    const std::uintptr_t page = options.page;
+    const std::uintptr_t prefetch = options.prefetch_lines * line;
+
+    std::uintptr_t prev = reinterpret_cast<std::uintptr_t>(address(first));
+    std::intptr_t prev_stride = 0;
+    for (++first; first != last && (options.max_hops == 0 || r.hops < options.max_hops); ++first) {
+        const std::uintptr_t cur = reinterpret_cast<std::uintptr_t>(address(first));
+        const std::intptr_t stride = static_cast<std::intptr_t>(cur - prev);
+        const std::uintptr_t distance = stride < 0 ? prev - cur : cur - prev;
+        ++r.hops;
+        ++r.stride_log2[static_cast<std::size_t>(std::bit_width(distance))];
+        if (stride < 0)
+            ++r.backward_hops;
+
+        const bool cross_line = cur / line != prev / line;
+        const bool cross_page = cur / page != prev / page;
+        r.cross_line_hops += cross_line;
+        r.cross_page_hops += cross_page;
+        if (cross_line) {
+            const bool short_forward = stride > 0 && distance <= prefetch;
+            const bool steady = stride == prev_stride && !cross_page;
+            if (!short_forward && !steady)
+                ++r.estimated_misses;
+        }
+        prev = cur;
+        prev_stride = stride;
+    }
+    r.recommend_compaction =
+        r.hops >= options.min_hops && r.estimated_miss_rate() > options.compact_threshold;
+    return r;
+}
+
+template <class It>
+locality_report analyze_locality(It first, It last, const locality_options& options = {}) {
+    return analyze_locality(first, last, options,
+                            [](const It& it) { return static_cast<const void*>(std::addressof(*it)); });
+}
+
+template <class List>
+locality_report analyze_locality(const List& list, const locality_options& options = {}) {
+    return analyze_locality(list.begin(), list.end(), options);
+}
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,332 @@
+// Fixed-size node pool that gives idle memory back to the OS.
+//
+// Nodes are carved from slab-aligned mmap regions.  Every slab tracks how
+// many of its nodes are live, and partially used slabs are binned by
+// occupancy so allocation always draws from the fullest one; nearly empty
+// slabs are left alone and drain.  Fully free slabs are returned by trim(),
+// either unmapped or, for the few kept as a reserve, emptied with
+// madvise(MADV_DONTNEED).  trim() can be called on demand or periodically by
+// a pool_trimmer.
+//
+// Live nodes are never moved, so a slab with even one live node stays put.
+//
+// The pool is internally locked so a background trimmer can run alongside
+// allocating threads.  pool_allocator adapts it for node-based containers.
+
+#ifndef P_LINKED_LIST_NODE_POOL_HPP
+#define P_LINKED_LIST_NODE_POOL_HPP
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace p_linked_list {
+
+struct trim_policy {
+    std::size_t keep_empty_slabs = 1;  // free slabs kept mapped (but madvised)
+};
+
+class node_pool {
+public:
+    struct stats_type {
+        std::size_t slabs = 0;
+        std::size_t empty_slabs = 0;
+        std::size_t nodes_in_use = 0;
+        std::size_t mapped_bytes = 0;
+        std::size_t resident_bytes = 0;  // mapped minus madvised ranges
+    };
+
+    explicit node_pool(std::size_t node_size, std::size_t slab_size = 64 * 1024)
+        : slab_size_(slab_size), page_size_(static_cast<std::size_t>(::sysconf(_SC_PAGESIZE))) {
+        node_size_ = node_size < sizeof(void*) ? sizeof(void*) : node_size;
+        node_size_ = (node_size_ + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        first_offset_ = (sizeof(slab) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+        capacity_ = static_cast<std::uint32_t>((slab_size_ - first_offset_) / node_size_);
+        if (slab_size_ < page_size_ || (slab_size_ & (slab_size_ - 1)) || capacity_ == 0)
+            throw std::bad_alloc();
+        for (auto& l : lists_)
+            l.prev = l.next = &l;
+    }
+
+    node_pool(const node_pool&) = delete;
+    node_pool& operator=(const node_pool&) = delete;
+
+    ~node_pool() {
+        for (auto& l : lists_) {
+            while (l.next != &l)
+                unmap(unlink(l.next));
+        }
+    }
+
+    std::size_t node_size() const noexcept { return node_size_; }
+
+    void* allocate() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slab* s = nullptr;
+        for (std::size_t b = bin_count; b-- > 0;) {
+            if (lists_[b].next != &lists_[b]) {
+                s = lists_[b].next;
+                break;
+            }
+        }
+        if (!s) {
+            if (empty_list().next != &empty_list()) {
+                s = empty_list().next;
+                --empty_count_;
+                if (s->madvised) {
+                    resident_slabs_bytes_ += slab_size_ - page_size_;
+                    s->madvised = false;
+                }
+            } else {
+                s = map();
+            }
+        }
+        void* p;
+        if (s->free_list) {
+            p = s->free_list;
+            s->free_list = *static_cast<void**>(p);
+        } else {
+            p = s->bump;
+            s->bump += node_size_;
+        }
+        ++s->used;
+        ++in_use_;
+        rebin(s);
+        return p;
+    }
+
+    void deallocate(void* p) noexcept {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slab* s = slab_of(p);
+        *static_cast<void**>(p) = s->free_list;
+        s->free_list = p;
+        --s->used;
+        --in_use_;
+        rebin(s);
+    }
+
+    // Releases free slabs beyond policy.keep_empty_slabs and madvises the
+    // rest.  Returns the number of bytes handed back to the OS.
+    std::size_t trim(const trim_policy& policy = trim_policy()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::size_t released = 0;
+        while (empty_count_ > policy.keep_empty_slabs) {
+            slab* s = unlink(empty_list().prev);
+            --empty_count_;
+            released += s->madvised ? page_size_ : slab_size_;
+            unmap(s);
+        }
+        for (slab* s = empty_list().next; s != &empty_list(); s = s->next) {
+            if (s->madvised)
+                continue;
+            // The first page holds the header and stays resident.
+            ::madvise(reinterpret_cast<char*>(s) + page_size_, slab_size_ - page_size_, MADV_DONTNEED);
+            s->madvised = true;
+            resident_slabs_bytes_ -= slab_size_ - page_size_;
+            released += slab_size_ - page_size_;
+        }
+        return released;
+    }
+
+    stats_type stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_type st;
+        st.slabs = slab_count_;
+        st.empty_slabs = empty_count_;
+        st.nodes_in_use = in_use_;
+        st.mapped_bytes = slab_count_ * slab_size_;
+        st.resident_bytes = resident_slabs_bytes_;
+        return st;
+    }
+
+private:
+    // Partially used slabs are split over bin_count occupancy bins, followed
+    // by the full list and the empty list.
+    static constexpr std::size_t bin_count = 4;
+    static constexpr std::uint32_t full_bin = bin_count;
+    static constexpr std::uint32_t empty_bin = bin_count + 1;
+    static constexpr std::uint32_t no_bin = bin_count + 2;
+
+    struct slab {
+        slab* prev;
+        slab* next;
+        void* free_list;
+        char* bump;
+        std::uint32_t used;
+        std::uint32_t bin;
+        bool madvised;
+    };
+
+    slab* slab_of(void* p) const noexcept {
+        return reinterpret_cast<slab*>(reinterpret_cast<std::uintptr_t>(p) & ~(slab_size_ - 1));
+    }
+
+    slab& empty_list() noexcept { return lists_[empty_bin]; }
+
+    std::uint32_t bin_for(const slab* s) const noexcept {
+        if (s->used == 0)
+            return empty_bin;
+        if (s->used == capacity_)
+            return full_bin;
+        return static_cast<std::uint32_t>(static_cast<std::size_t>(s->used) * bin_count / capacity_);
+    }
+
+    void rebin(slab* s) {
+        std::uint32_t b = bin_for(s);
+        if (b == s->bin)
+            return;
+        unlink(s);
+        s->bin = b;
+        if (b == empty_bin) {
+            // Reset to bump allocation so a madvised slab never reads its
+            // zeroed free list.
+            s->free_list = nullptr;
+            s->bump = reinterpret_cast<char*>(s) + first_offset_;
+            ++empty_count_;
+        }
+        push_front(&lists_[b], s);
+    }
+
+    static void push_front(slab* head, slab* s) {
+        s->prev = head;
+        s->next = head->next;
+        head->next->prev = s;
+        head->next = s;
+    }
+
+    static slab* unlink(slab* s) {
+        if (s->prev) {
+            s->prev->next = s->next;
+            s->next->prev = s->prev;
+        }
+        s->prev = s->next = nullptr;
+        return s;
+    }
+
+    slab* map() {
+        void* raw = ::mmap(nullptr, slab_size_ * 2, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+            throw std::bad_alloc();
+        std::uintptr_t base = reinterpret_cast<std::uintptr_t>(raw);
+        std::uintptr_t aligned = (base + slab_size_ - 1) & ~(slab_size_ - 1);
+        if (aligned != base)
+            ::munmap(raw, aligned - base);
+        std::size_t tail = base + slab_size_ * 2 - (aligned + slab_size_);
+        if (tail)
+            ::munmap(reinterpret_cast<void*>(aligned + slab_size_), tail);
+
+        slab* s = ::new (reinterpret_cast<void*>(aligned)) slab;
+        s->prev = s->next = nullptr;
+        s->free_list = nullptr;
+        s->bump = reinterpret_cast<char*>(aligned) + first_offset_;
+        s->used = 0;
+        s->bin = no_bin;
+        s->madvised = false;
+        ++slab_count_;
+        resident_slabs_bytes_ += slab_size_;
+        return s;
+    }
+
+    void unmap(slab* s) noexcept {
+        resident_slabs_bytes_ -= s->madvised ? page_size_ : slab_size_;
+        --slab_count_;
+        ::munmap(s, slab_size_);
+    }
+
+    std::size_t slab_size_;
+    std::size_t page_size_;
+    std::size_t node_size_;
+    std::size_t first_offset_;
+    std::uint32_t capacity_;
+
+    mutable std::mutex mutex_;
+    slab lists_[bin_count + 2];
+    std::size_t empty_count_ = 0;
+    std::size_t slab_count_ = 0;
+    std::size_t in_use_ = 0;
+    std::size_t resident_slabs_bytes_ = 0;
+};
+
+// Calls pool.trim(policy) every `interval` until destroyed.
+class pool_trimmer {
+public:
+    pool_trimmer(node_pool& pool, std::chrono::milliseconds interval,
+                 trim_policy policy = trim_policy())
+        : thread_([this, &pool, interval, policy] {
+              std::unique_lock<std::mutex> lock(mutex_);
+              while (!cv_.wait_for(lock, interval, [this] { return stop_; })) {
+                  lock.unlock();
+                  pool.trim(policy);
+                  lock.lock();
+              }
+          }) {}
+
+    pool_trimmer(const pool_trimmer&) = delete;
+    pool_trimmer& operator=(const pool_trimmer&) = delete;
+
+    ~pool_trimmer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+// Standard allocator drawing single objects that fit from a node_pool, e.g.
+// std::list<T, pool_allocator<T>>.  Anything else goes to operator new.
+template <class T>
+class pool_allocator {
+public:
+    using value_type = T;
+
+    explicit pool_allocator(node_pool& pool) noexcept : pool_(&pool) {}
+    template <class U>
+    pool_allocator(const pool_allocator<U>& other) noexcept : pool_(other.pool()) {}
+
+    T* allocate(std::size_t n) {
+        if (fits(n))
+            return static_cast<T*>(pool_->allocate());
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        if (fits(n))
+            pool_->deallocate(p);
+        else
+            ::operator delete(p);
+    }
+
+    node_pool* pool() const noexcept { return pool_; }
+
+    template <class U>
+    friend bool operator==(const pool_allocator& a, const pool_allocator<U>& b) noexcept {
+        return a.pool() == b.pool();
+    }
+
+private:
+    bool fits(std::size_t n) const noexcept {
+        return n == 1 && sizeof(T) <= pool_->node_size() && alignof(T) <= alignof(std::max_align_t);
+    }
+
+    node_pool* pool_;
+};
+
+} // namespace p_linked_list
+
+#endif
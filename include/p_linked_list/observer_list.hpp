@@ -0,0 +1,198 @@
+// Listener list whose emission path takes no locks.
+//
+// Listeners are nodes of a singly linked list.  add() pushes a node at the
+// head with a compare-exchange, so it never waits for emitters or removers.
+// emit() registers in the current epoch, walks the list with acquire loads
+// and calls every listener not marked removed.  It copies nothing and locks
+// nothing.
+//
+// remove() marks the node first, so emissions that start afterwards skip it.
+// It then unlinks the node under a mutex that only removers take, and
+// retires it.  A retired node is freed only after every emitter that might
+// still be standing on it has finished.  Emitters register in one of two
+// epoch counters, and retired nodes wait until the epoch they were retired
+// in has flipped and drained.  Reclamation is opportunistic, from remove(),
+// add() and the tail of emit() via try_lock, and it never waits.  A listener
+// may therefore remove itself, or any other listener, from inside a callback.
+//
+// Listeners run newest first.  One added during an emission may or may not
+// be called by it; one removed during an emission may still be running in
+// another thread when remove() returns.
+
+#ifndef P_LINKED_LIST_OBSERVER_LIST_HPP
+#define P_LINKED_LIST_OBSERVER_LIST_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace p_linked_list {
+
+template <class... Args>
+class observer_list {
+public:
+    using callback = std::function<void(Args...)>;
+    using id = std::uint64_t;
+
+    observer_list() = default;
+
+    observer_list(const observer_list&) = delete;
+    observer_list& operator=(const observer_list&) = delete;
+
+    // No emission may be running.
+    ~observer_list() {
+        for (node* n = head_.load(std::memory_order_relaxed); n;) {
+            node* next = n->next.load(std::memory_order_relaxed);
+            delete n;
+            n = next;
+        }
+        free_retired(retired_[0]);
+        free_retired(retired_[1]);
+    }
+
+    // Registers `f`; returns the id that remove() takes.
+    id add(callback f) {
+        node* n = new node(std::move(f), next_id_.fetch_add(1, std::memory_order_relaxed));
+        node* h = head_.load(std::memory_order_relaxed);
+        do {
+            n->next.store(h, std::memory_order_relaxed);
+        } while (!head_.compare_exchange_weak(h, n, std::memory_order_release, std::memory_order_relaxed));
+        size_.fetch_add(1, std::memory_order_relaxed);
+        if (has_garbage_.load(std::memory_order_relaxed))
+            try_reclaim();
+        return n->key;
+    }
+
+    // Unregisters a listener; returns false if `listener` is not present.
+    bool remove(id listener) {
+        std::lock_guard<std::mutex> lock(remove_mutex_);
+        node* n = head_.load(std::memory_order_acquire);
+        node* prev = nullptr;
+        while (n && n->key != listener) {
+            prev = n;
+            n = n->next.load(std::memory_order_acquire);
+        }
+        if (!n)
+            return false;
+        n->removed.store(true, std::memory_order_relaxed);
+        node* next = n->next.load(std::memory_order_relaxed);
+        if (!prev) {
+            node* expected = n;
+            if (!head_.compare_exchange_strong(expected, next, std::memory_order_acq_rel,
+                                               std::memory_order_acquire)) {
+                // New heads were pushed meanwhile; n is now further in.
+                prev = expected;
+                while (prev->next.load(std::memory_order_acquire) != n)
+                    prev = prev->next.load(std::memory_order_acquire);
+            }
+        }
+        if (prev)
+            prev->next.store(next, std::memory_order_release);
+        // n keeps its next pointer so an emitter standing on it can move on.
+        const unsigned e = epoch_.load(std::memory_order_relaxed);
+        n->retired_next = retired_[e];
+        retired_[e] = n;
+        has_garbage_.store(true, std::memory_order_relaxed);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        reclaim_locked();
+        return true;
+    }
+
+    // Calls every listener with `args`.
+    void emit(Args... args) {
+        const unsigned e = enter();
+        struct leave_guard {
+            observer_list& list;
+            unsigned epoch;
+            ~leave_guard() { list.leave(epoch); }
+        } guard{*this, e};
+        for (node* n = head_.load(std::memory_order_acquire); n; n = n->next.load(std::memory_order_acquire)) {
+            if (!n->removed.load(std::memory_order_acquire))
+                n->fn(args...);
+        }
+    }
+
+    std::size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+    bool empty() const noexcept { return size() == 0; }
+
+    // Frees retired nodes whose grace period has passed, if the remover
+    // mutex is free.
+    void try_reclaim() {
+        std::unique_lock<std::mutex> lock(remove_mutex_, std::try_to_lock);
+        if (lock.owns_lock())
+            reclaim_locked();
+    }
+
+private:
+    struct node {
+        node(callback f, id k) : fn(std::move(f)), key(k) {}
+
+        callback fn;
+        id key;
+        std::atomic<node*> next{nullptr};
+        std::atomic<bool> removed{false};
+        node* retired_next = nullptr;
+    };
+
+    // Registers in the current epoch, retrying if it flips in between so a
+    // reclaimer never misses an emitter that can still see old nodes.
+    unsigned enter() noexcept {
+        for (;;) {
+            unsigned e = epoch_.load();
+            readers_[e].fetch_add(1);
+            if (epoch_.load() == e)
+                return e;
+            readers_[e].fetch_sub(1);
+        }
+    }
+
+    void leave(unsigned e) noexcept {
+        readers_[e].fetch_sub(1, std::memory_order_release);
+        if (has_garbage_.load(std::memory_order_relaxed)) {
+            std::unique_lock<std::mutex> lock(remove_mutex_, std::try_to_lock);
+            if (lock.owns_lock())
+                reclaim_locked();
+        }
+    }
+
+    // Nodes retired in the other epoch were unlinked before the flip to the
+    // current one; once that epoch's emitters have drained nobody can reach
+    // them.  Flipping again is allowed only then, so at most two epochs are
+    // ever live.
+    void reclaim_locked() noexcept {
+        const unsigned e = epoch_.load(std::memory_order_relaxed);
+        const unsigned other = e ^ 1;
+        if (readers_[other].load(std::memory_order_acquire) != 0)
+            return;
+        free_retired(std::exchange(retired_[other], nullptr));
+        if (retired_[e])
+            epoch_.store(other);
+        else
+            has_garbage_.store(false, std::memory_order_relaxed);
+    }
+
+    static void free_retired(node* n) noexcept {
+        while (n) {
+            node* next = n->retired_next;
+            delete n;
+            n = next;
+        }
+    }
+
+    std::atomic<node*> head_{nullptr};
+    std::atomic<unsigned> epoch_{0};
+    std::atomic<std::int64_t> readers_[2] = {};
+    std::atomic<std::uint64_t> next_id_{1};
+    std::atomic<std::size_t> size_{0};
+    std::atomic<bool> has_garbage_{false};
+
+    std::mutex remove_mutex_;
+    node* retired_[2] = {nullptr, nullptr};
+};
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,182 @@
+// Heterogeneous list of objects derived from a common base.
+//
+// Each element is constructed directly behind its link header in a single
+// bump-allocated block, so a derived object costs one allocation (usually
+// none, since blocks are carved from a larger arena) and one pointer hop,
+// instead of a node plus a separate unique_ptr target.  Elements are reached
+// through Base& for virtual dispatch, or by exact type through get_if() and
+// visit().
+//
+// Memory of removed elements is reclaimed by clear() or destruction, not
+// individually; the list suits build-then-traverse workloads.
+
+#ifndef P_LINKED_LIST_POLY_LIST_HPP
+#define P_LINKED_LIST_POLY_LIST_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace p_linked_list {
+
+template <class Base>
+class poly_list {
+    template <class D>
+    struct type_tag {
+        static constexpr char id = 0;
+    };
+
+    struct node {
+        node* next;
+        Base* obj;
+        const void* type;
+        void (*destroy)(node*);
+    };
+
+    template <class D>
+    static constexpr std::size_t payload_offset() {
+        return (sizeof(node) + alignof(D) - 1) / alignof(D) * alignof(D);
+    }
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Base;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Base*;
+        using reference = Base&;
+
+        iterator() = default;
+
+        reference operator*() const { return *n_->obj; }
+        pointer operator->() const { return n_->obj; }
+        iterator& operator++() { n_ = n_->next; return *this; }
+        iterator operator++(int) { iterator t = *this; ++*this; return t; }
+        friend bool operator==(iterator a, iterator b) { return a.n_ == b.n_; }
+        friend bool operator!=(iterator a, iterator b) { return a.n_ != b.n_; }
+
+        // Returns the element as D if its dynamic type is exactly D.
+        template <class D>
+        D* get_if() const {
+            if (n_->type != &type_tag<D>::id)
+                return nullptr;
+            return std::launder(reinterpret_cast<D*>(reinterpret_cast<char*>(n_) + payload_offset<D>()));
+        }
+
+    private:
+        friend class poly_list;
+        explicit iterator(node* n) : n_(n) {}
+        node* n_ = nullptr;
+    };
+
+    explicit poly_list(std::size_t block_size = 64 * 1024,
+                       std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+        : arena_(block_size, upstream) {}
+
+    poly_list(const poly_list&) = delete;
+    poly_list& operator=(const poly_list&) = delete;
+
+    ~poly_list() { destroy_all(); }
+
+    template <class D, class... Args>
+    D& emplace_back(Args&&... args) {
+        node* n = make<D>(std::forward<Args>(args)...);
+        if (tail_)
+            tail_->next = n;
+        else
+            head_ = n;
+        tail_ = n;
+        return *static_cast<D*>(n->obj);
+    }
+
+    template <class D, class... Args>
+    D& emplace_front(Args&&... args) {
+        node* n = make<D>(std::forward<Args>(args)...);
+        n->next = head_;
+        head_ = n;
+        if (!tail_)
+            tail_ = n;
+        return *static_cast<D*>(n->obj);
+    }
+
+    // Destroys the first element.  Its storage is not reused until clear().
+    void pop_front() {
+        node* n = head_;
+        head_ = n->next;
+        if (!head_)
+            tail_ = nullptr;
+        n->destroy(n);
+        --size_;
+    }
+
+    // Destroys every element and releases all arena blocks.
+    void clear() {
+        destroy_all();
+        arena_.release();
+    }
+
+    Base& front() { return *head_->obj; }
+    Base& back() { return *tail_->obj; }
+    bool empty() const noexcept { return head_ == nullptr; }
+    std::size_t size() const noexcept { return size_; }
+
+    iterator begin() const { return iterator(head_); }
+    iterator end() const { return iterator(); }
+
+    // Calls f with each element as its exact type when that type is one of
+    // Ds, and as Base& otherwise.
+    template <class... Ds, class F>
+    void visit(F&& f) const {
+        for (iterator it = begin(); it != end(); ++it) {
+            bool done = ((try_visit<Ds>(it, f)) || ...);
+            if (!done)
+                f(*it);
+        }
+    }
+
+private:
+    template <class D, class F>
+    static bool try_visit(iterator it, F& f) {
+        if (D* d = it.template get_if<D>()) {
+            f(*d);
+            return true;
+        }
+        return false;
+    }
+
+    template <class D, class... Args>
+    node* make(Args&&... args) {
+        static_assert(std::is_base_of_v<Base, D>, "element type must derive from Base");
+        constexpr std::size_t align = alignof(D) > alignof(node) ? alignof(D) : alignof(node);
+        void* mem = arena_.allocate(payload_offset<D>() + sizeof(D), align);
+        D* obj = ::new (static_cast<char*>(mem) + payload_offset<D>()) D(std::forward<Args>(args)...);
+        node* n = ::new (mem) node{nullptr, obj, &type_tag<D>::id, [](node* self) {
+            std::launder(reinterpret_cast<D*>(reinterpret_cast<char*>(self) + payload_offset<D>()))->~D();
+        }};
+        ++size_;
+        return n;
+    }
+
+    void destroy_all() noexcept {
+        for (node* n = head_; n;) {
+            node* next = n->next;
+            n->destroy(n);
+            n = next;
+        }
+        head_ = tail_ = nullptr;
+        size_ = 0;
+    }
+
+    std::pmr::monotonic_buffer_resource arena_;
+    node* head_ = nullptr;
+    node* tail_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace p_linked_list
+
+#endif
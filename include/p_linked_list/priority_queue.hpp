@@ -0,0 +1,242 @@
+// Strict-priority MPMC queue built from lock-free linked lanes.
+//
+// Each priority has its own Michael-Scott queue, and a bitmap records which
+// lanes may be non-empty, so pop() finds the most urgent lane with one load
+// and a count-trailing-zeros.  Lower-priority work therefore never sits in
+// front of urgent work.
+//
+// Nodes are type-stable: they live in geometrically growing segments, are
+// recycled through a lock-free free list and are only released with the
+// queue.  Links are 32-bit node indices paired with a 32-bit tag in one
+// 64-bit word, which is what defeats ABA (as in the original MS paper).
+// Values are read before the node is won, so T must be trivially copyable;
+// queue pointers or handles to larger jobs.
+//
+// With aging enabled, every aging_period-th pop serves lanes round-robin
+// instead of strictly by priority, so a steady flood of urgent work cannot
+// starve the lower lanes indefinitely.
+
+#ifndef P_LINKED_LIST_PRIORITY_QUEUE_HPP
+#define P_LINKED_LIST_PRIORITY_QUEUE_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+namespace p_linked_list {
+
+template <class T, std::size_t Lanes = 8>
+class priority_mpmc_queue {
+    static_assert(Lanes >= 1 && Lanes <= 64, "lane bitmap is one 64-bit word");
+    static_assert(std::is_trivially_copyable_v<T>, "values are read racily and must be trivially copyable");
+
+public:
+    // `aging_period` of 0 disables aging.
+    explicit priority_mpmc_queue(std::size_t aging_period = 0) : aging_period_(aging_period) {
+        for (auto& s : segments_)
+            s.store(nullptr, std::memory_order_relaxed);
+        for (auto& l : lanes_) {
+            std::uint32_t dummy = allocate_node();
+            l.head.store(pack(dummy, 0));
+            l.tail.store(pack(dummy, 0));
+        }
+    }
+
+    priority_mpmc_queue(const priority_mpmc_queue&) = delete;
+    priority_mpmc_queue& operator=(const priority_mpmc_queue&) = delete;
+
+    ~priority_mpmc_queue() {
+        for (auto& s : segments_)
+            delete[] s.load(std::memory_order_relaxed);
+    }
+
+    // Enqueues `value` at `priority`, 0 being the most urgent; throws
+    // std::out_of_range if priority >= Lanes.
+    void push(T value, std::size_t priority) {
+        if (priority >= Lanes)
+            throw std::out_of_range("priority_mpmc_queue::push: priority out of range");
+        lane& l = lanes_[priority];
+        std::uint32_t n = allocate_node();
+        node& nd = at(n);
+        nd.value.store(value, std::memory_order_relaxed);
+        std::uint64_t old = nd.next.load(std::memory_order_relaxed);
+        nd.next.store(pack(nil, tag(old) + 1), std::memory_order_relaxed);
+
+        std::uint64_t tail;
+        for (;;) {
+            tail = l.tail.load();
+            std::uint64_t next = at(index(tail)).next.load();
+            if (tail != l.tail.load())
+                continue;
+            if (index(next) == nil) {
+                if (at(index(tail)).next.compare_exchange_weak(next, pack(n, tag(next) + 1)))
+                    break;
+            } else {
+                l.tail.compare_exchange_weak(tail, pack(index(next), tag(tail) + 1));
+            }
+        }
+        l.tail.compare_exchange_strong(tail, pack(n, tag(tail) + 1));
+        l.size.fetch_add(1, std::memory_order_relaxed);
+        nonempty_.fetch_or(std::uint64_t(1) << priority);
+    }
+
+    // Dequeues from the most urgent non-empty lane (or the aging lane).
+    // Stores the lane in *priority when given.
+    std::optional<T> try_pop(std::size_t* priority = nullptr) {
+        bool aging = aging_period_ && pops_.fetch_add(1, std::memory_order_relaxed) % aging_period_ == 0;
+        std::uint64_t bits = nonempty_.load();
+        while (bits) {
+            std::size_t p;
+            if (aging) {
+                std::uint64_t start = rr_.fetch_add(1, std::memory_order_relaxed) % Lanes;
+                std::uint64_t above = bits & (~std::uint64_t(0) << start);
+                p = static_cast<std::size_t>(std::countr_zero(above ? above : bits));
+                aging = false;
+            } else {
+                p = static_cast<std::size_t>(std::countr_zero(bits));
+            }
+            if (auto v = pop_lane(lanes_[p])) {
+                if (priority)
+                    *priority = p;
+                return v;
+            }
+            // The lane looked empty: clear its bit, then re-check so a push
+            // that raced with the clear is not hidden.
+            const std::uint64_t bit = std::uint64_t(1) << p;
+            nonempty_.fetch_and(~bit);
+            if (!lane_empty(lanes_[p]))
+                nonempty_.fetch_or(bit);
+            bits = nonempty_.load() & ~bit;
+        }
+        return std::nullopt;
+    }
+
+    std::size_t size_approx(std::size_t priority) const noexcept {
+        auto s = static_cast<std::ptrdiff_t>(lanes_[priority].size.load(std::memory_order_relaxed));
+        return s < 0 ? 0 : static_cast<std::size_t>(s);
+    }
+
+    // Lane bits are cleared lazily by failed pops, so a set bit is only a
+    // hint; check the lanes it points at.
+    bool empty() const noexcept {
+        for (std::uint64_t bits = nonempty_.load(); bits; bits &= bits - 1) {
+            if (!lane_empty(lanes_[static_cast<std::size_t>(std::countr_zero(bits))]))
+                return false;
+        }
+        return true;
+    }
+
+private:
+    static constexpr std::uint32_t nil = 0xffffffffu;
+    static constexpr std::size_t first_segment_bits = 6;
+    static constexpr std::size_t segment_count = 26;
+    static constexpr std::uint64_t max_nodes = ((std::uint64_t(1) << segment_count) - 1) << first_segment_bits;
+
+    struct node {
+        std::atomic<std::uint64_t> next{nil};
+        std::atomic<T> value{};
+    };
+
+    struct alignas(64) lane {
+        alignas(64) std::atomic<std::uint64_t> head{0};
+        alignas(64) std::atomic<std::uint64_t> tail{0};
+        std::atomic<std::ptrdiff_t> size{0};
+    };
+
+    static std::uint64_t pack(std::uint32_t idx, std::uint64_t t) noexcept { return (t << 32) | idx; }
+    static std::uint32_t index(std::uint64_t p) noexcept { return static_cast<std::uint32_t>(p); }
+    static std::uint64_t tag(std::uint64_t p) noexcept { return (p >> 32) & 0xffffffffu; }
+
+    // Segment k holds indices [64 * (2^k - 1), 64 * (2^(k+1) - 1)).
+    node& at(std::uint32_t i) noexcept {
+        std::uint64_t biased = std::uint64_t(i) + (std::uint64_t(1) << first_segment_bits);
+        std::size_t seg = static_cast<std::size_t>(std::bit_width(biased)) - first_segment_bits - 1;
+        return segments_[seg].load(std::memory_order_acquire)
+            [biased - (std::uint64_t(1) << (seg + first_segment_bits))];
+    }
+    const node& at(std::uint32_t i) const noexcept { return const_cast<priority_mpmc_queue*>(this)->at(i); }
+
+    std::uint32_t allocate_node() {
+        for (;;) {
+            std::uint64_t head = free_.load();
+            std::uint32_t i = index(head);
+            if (i == nil)
+                break;
+            std::uint64_t next = at(i).next.load();
+            if (free_.compare_exchange_weak(head, pack(index(next), tag(head) + 1)))
+                return i;
+        }
+        std::uint64_t i = next_fresh_.fetch_add(1, std::memory_order_relaxed);
+        if (i >= max_nodes)
+            throw std::bad_alloc();
+        std::uint64_t biased = i + (std::uint64_t(1) << first_segment_bits);
+        std::size_t seg = static_cast<std::size_t>(std::bit_width(biased)) - first_segment_bits - 1;
+        if (!segments_[seg].load(std::memory_order_acquire)) {
+            auto* fresh = new node[std::size_t(1) << (seg + first_segment_bits)];
+            node* expected = nullptr;
+            if (!segments_[seg].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel))
+                delete[] fresh;
+        }
+        return static_cast<std::uint32_t>(i);
+    }
+
+    void free_node(std::uint32_t i) {
+        node& nd = at(i);
+        std::uint64_t old = nd.next.load(std::memory_order_relaxed);
+        std::uint64_t head = free_.load();
+        do {
+            std::uint64_t link = pack(index(head), tag(old) + 1);
+            nd.next.store(link);
+            old = link;
+        } while (!free_.compare_exchange_weak(head, pack(i, tag(head) + 1)));
+    }
+
+    std::optional<T> pop_lane(lane& l) {
+        for (;;) {
+            std::uint64_t head = l.head.load();
+            std::uint64_t tail = l.tail.load();
+            std::uint64_t next = at(index(head)).next.load();
+            if (head != l.head.load())
+                continue;
+            if (index(head) == index(tail)) {
+                if (index(next) == nil)
+                    return std::nullopt;
+                l.tail.compare_exchange_weak(tail, pack(index(next), tag(tail) + 1));
+                continue;
+            }
+            T value = at(index(next)).value.load(std::memory_order_relaxed);
+            if (l.head.compare_exchange_weak(head, pack(index(next), tag(head) + 1))) {
+                l.size.fetch_sub(1, std::memory_order_relaxed);
+                free_node(index(head));
+                return value;
+            }
+        }
+    }
+
+    bool lane_empty(const lane& l) const noexcept {
+        for (;;) {
+            std::uint64_t head = l.head.load();
+            std::uint64_t next = at(index(head)).next.load();
+            if (head == l.head.load())
+                return index(next) == nil;
+        }
+    }
+
+    lane lanes_[Lanes];
+    alignas(64) std::atomic<std::uint64_t> nonempty_{0};
+    std::atomic<std::uint64_t> pops_{0};
+    std::atomic<std::uint64_t> rr_{0};
+    const std::size_t aging_period_;
+    alignas(64) std::atomic<std::uint64_t> free_{nil};
+    std::atomic<std::uint64_t> next_fresh_{0};
+    std::atomic<node*> segments_[segment_count];
+};
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,219 @@
+// Fixed-capacity doubly linked list for hard real-time code.
+//
+// All node storage is mapped at construction, written once so every page is
+// resident, and optionally locked with mlock(), so later operations never
+// call the allocator or take a page fault.  Construction is the only step
+// that can fail or block; it throws std::bad_alloc or std::system_error.
+//
+// Nodes are linked by 32-bit indices through a sentinel at the end of the
+// node array.  Every operation after construction is O(1), noexcept and
+// branch-light: inserts take the head of a free list, erases push onto it.
+// When the list is full, push_* return false and emplace() returns end();
+// nothing is evicted or grown.  clear() is O(1) for trivially destructible T
+// and otherwise destroys each element.
+
+#ifndef P_LINKED_LIST_REALTIME_LIST_HPP
+#define P_LINKED_LIST_REALTIME_LIST_HPP
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace p_linked_list {
+
+struct realtime_options {
+    bool lock_memory = false;  // mlock() the node storage
+};
+
+template <class T>
+class realtime_list {
+    static_assert(std::is_nothrow_destructible_v<T>);
+
+    struct node {
+        std::uint32_t prev;
+        std::uint32_t next;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T& value() noexcept { return *std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+
+        T& operator*() const noexcept { return nodes_[i_].value(); }
+        T* operator->() const noexcept { return &nodes_[i_].value(); }
+        iterator& operator++() noexcept { i_ = nodes_[i_].next; return *this; }
+        iterator operator++(int) noexcept { iterator t = *this; ++*this; return t; }
+        iterator& operator--() noexcept { i_ = nodes_[i_].prev; return *this; }
+        iterator operator--(int) noexcept { iterator t = *this; --*this; return t; }
+        friend bool operator==(iterator a, iterator b) noexcept { return a.i_ == b.i_; }
+        friend bool operator!=(iterator a, iterator b) noexcept { return a.i_ != b.i_; }
+
+    private:
+        friend class realtime_list;
+        iterator(node* nodes, std::uint32_t i) noexcept : nodes_(nodes), i_(i) {}
+        node* nodes_ = nullptr;
+        std::uint32_t i_ = 0;
+    };
+
+    explicit realtime_list(std::size_t capacity, realtime_options options = {}) : capacity_(capacity) {
+        if (capacity >= 0xffffffffu)
+            throw std::bad_alloc();
+        const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        bytes_ = ((capacity + 1) * sizeof(node) + page - 1) / page * page;
+        int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_POPULATE
+        flags |= MAP_POPULATE;
+#endif
+        void* mem = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (mem == MAP_FAILED)
+            throw std::bad_alloc();
+        // MAP_POPULATE is only a hint; writing each page makes it resident
+        // and private before any real-time code runs.
+        for (std::size_t off = 0; off < bytes_; off += page)
+            static_cast<volatile unsigned char*>(mem)[off] = 0;
+        if (options.lock_memory && ::mlock(mem, bytes_) != 0) {
+            int err = errno;
+            ::munmap(mem, bytes_);
+            throw std::system_error(err, std::generic_category(), "mlock");
+        }
+        nodes_ = static_cast<node*>(mem);
+
+        const std::uint32_t s = sentinel();
+        for (std::uint32_t i = 0; i <= s; ++i)
+            ::new (static_cast<void*>(nodes_ + i)) node{i + 1, i + 1, {}};
+        nodes_[s].prev = nodes_[s].next = s;
+        free_ = capacity ? 0 : s;
+        if (capacity)
+            nodes_[capacity - 1].next = s;
+    }
+
+    realtime_list(const realtime_list&) = delete;
+    realtime_list& operator=(const realtime_list&) = delete;
+
+    ~realtime_list() {
+        clear();
+        ::munmap(nodes_, bytes_);
+    }
+
+    // Returns false, leaving the list unchanged, when it is full.
+    [[nodiscard]] bool push_back(const T& v) noexcept { return emplace(end(), v) != end(); }
+    [[nodiscard]] bool push_back(T&& v) noexcept { return emplace(end(), std::move(v)) != end(); }
+    [[nodiscard]] bool push_front(const T& v) noexcept { return emplace(begin(), v) != end(); }
+    [[nodiscard]] bool push_front(T&& v) noexcept { return emplace(begin(), std::move(v)) != end(); }
+
+    template <class... Args>
+    [[nodiscard]] bool emplace_back(Args&&... args) noexcept {
+        return emplace(end(), std::forward<Args>(args)...) != end();
+    }
+
+    // Constructs an element before `pos`; returns end() when full.
+    template <class... Args>
+    [[nodiscard]] iterator emplace(iterator pos, Args&&... args) noexcept {
+        static_assert(std::is_nothrow_constructible_v<T, Args...>,
+                      "real-time inserts must not throw");
+        const std::uint32_t n = free_;
+        if (n == sentinel()) [[unlikely]]
+            return end();
+        free_ = nodes_[n].next;
+        ::new (static_cast<void*>(nodes_[n].storage)) T(std::forward<Args>(args)...);
+        const std::uint32_t next = pos.i_;
+        const std::uint32_t prev = nodes_[next].prev;
+        nodes_[n].prev = prev;
+        nodes_[n].next = next;
+        nodes_[prev].next = n;
+        nodes_[next].prev = n;
+        ++size_;
+        return iterator(nodes_, n);
+    }
+
+    iterator erase(iterator pos) noexcept {
+        const std::uint32_t n = pos.i_;
+        const std::uint32_t prev = nodes_[n].prev;
+        const std::uint32_t next = nodes_[n].next;
+        nodes_[prev].next = next;
+        nodes_[next].prev = prev;
+        nodes_[n].value().~T();
+        nodes_[n].next = free_;
+        free_ = n;
+        --size_;
+        return iterator(nodes_, next);
+    }
+
+    void pop_front() noexcept { erase(begin()); }
+    void pop_back() noexcept { erase(iterator(nodes_, nodes_[sentinel()].prev)); }
+
+    // Moves `pos` before `to` without touching the element.
+    void splice(iterator to, iterator pos) noexcept {
+        const std::uint32_t n = pos.i_;
+        if (n == to.i_ || nodes_[n].next == to.i_)
+            return;
+        nodes_[nodes_[n].prev].next = nodes_[n].next;
+        nodes_[nodes_[n].next].prev = nodes_[n].prev;
+        const std::uint32_t prev = nodes_[to.i_].prev;
+        nodes_[n].prev = prev;
+        nodes_[n].next = to.i_;
+        nodes_[prev].next = n;
+        nodes_[to.i_].prev = n;
+    }
+
+    void clear() noexcept {
+        const std::uint32_t s = sentinel();
+        if (size_ == 0)
+            return;
+        if constexpr (std::is_trivially_destructible_v<T>) {
+            // Hand the whole chain to the free list at once.
+            nodes_[nodes_[s].prev].next = free_;
+            free_ = nodes_[s].next;
+        } else {
+            for (std::uint32_t i = nodes_[s].next; i != s;) {
+                std::uint32_t next = nodes_[i].next;
+                nodes_[i].value().~T();
+                nodes_[i].next = free_;
+                free_ = i;
+                i = next;
+            }
+        }
+        nodes_[s].prev = nodes_[s].next = s;
+        size_ = 0;
+    }
+
+    T& front() noexcept { return *begin(); }
+    T& back() noexcept { return nodes_[nodes_[sentinel()].prev].value(); }
+    bool empty() const noexcept { return size_ == 0; }
+    bool full() const noexcept { return free_ == sentinel(); }
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    iterator begin() const noexcept { return iterator(nodes_, nodes_[sentinel()].next); }
+    iterator end() const noexcept { return iterator(nodes_, sentinel()); }
+
+private:
+    std::uint32_t sentinel() const noexcept { return static_cast<std::uint32_t>(capacity_); }
+
+    std::size_t capacity_;
+    std::size_t bytes_ = 0;
+    node* nodes_ = nullptr;
+    std::uint32_t free_ = 0;
+    std::size_t size_ = 0;
+};
+
+} // namespace p_linked_list
+
+#endif
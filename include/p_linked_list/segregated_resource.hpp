@@ -0,0 +1,391 @@
+// General-purpose std::pmr::memory_resource built from linked free lists.
+//
+// Small requests (up to 1 KiB, alignment up to 16) are rounded to one of 20
+// size classes.  Each class has a singly linked free list per cache shard,
+// backed by a mutex-protected central list that shards refill from and spill
+// to in batches.  A thread always uses the same shard, so with no more busy
+// threads than shards every small allocation hits an uncontended, thread-
+// local free list.  pmr passes the size back on deallocation, so small
+// blocks carry no header.
+//
+// Medium requests come from upstream arenas managed with boundary tags: each
+// block has a header recording its size and whether it and its predecessor
+// are in use, and free blocks also keep a footer, so a freed block merges
+// with free neighbours in O(1).  Free blocks sit in doubly linked lists
+// segregated by power-of-two size and are allocated first-fit with
+// splitting.  An arena that becomes entirely free goes back upstream.
+//
+// Larger or over-aligned requests go straight to the upstream resource.
+
+#ifndef P_LINKED_LIST_SEGREGATED_RESOURCE_HPP
+#define P_LINKED_LIST_SEGREGATED_RESOURCE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace p_linked_list {
+
+class segregated_resource : public std::pmr::memory_resource {
+public:
+    // Medium requests are carved from arenas of `arena_size` bytes, which
+    // must be a multiple of 16 and hold at least one block of arena_size / 4
+    // bytes; anything else throws std::invalid_argument.
+    explicit segregated_resource(std::pmr::memory_resource* upstream = std::pmr::get_default_resource(),
+                                 std::size_t arena_size = 1 << 20)
+        : upstream_(upstream), arena_size_(checked_arena_size(arena_size)) {
+        unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+        shard_count_ = std::bit_ceil(hw * 2);
+        shards_ = std::make_unique<shard[]>(shard_count_);
+        for (std::size_t i = 0; i < bin_count; ++i)
+            bins_[i].prev = bins_[i].next = &bins_[i];
+    }
+
+    segregated_resource(const segregated_resource&) = delete;
+    segregated_resource& operator=(const segregated_resource&) = delete;
+
+    ~segregated_resource() override {
+        for (void* s : spans_)
+            upstream_->deallocate(s, span_size, 16);
+        for (arena* a = arenas_; a;) {
+            arena* next = a->next;
+            upstream_->deallocate(a, a->size, 16);
+            a = next;
+        }
+    }
+
+    std::pmr::memory_resource* upstream_resource() const noexcept { return upstream_; }
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        if (alignment <= 16 && bytes <= small_limit)
+            return allocate_small(class_of(bytes));
+        if (alignment <= 16 && bytes <= large_limit())
+            return allocate_large(bytes);
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        if (alignment <= 16 && bytes <= small_limit)
+            deallocate_small(p, class_of(bytes));
+        else if (alignment <= 16 && bytes <= large_limit())
+            deallocate_large(p);
+        else
+            upstream_->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    // ---- small blocks -------------------------------------------------------
+
+    static constexpr std::size_t small_limit = 1024;
+    static constexpr std::size_t class_count = 20;
+    static constexpr std::size_t span_size = 64 * 1024;
+
+    struct free_block {
+        free_block* next;
+    };
+
+    struct alignas(64) shard {
+        std::mutex mutex;
+        free_block* heads[class_count] = {};
+        std::uint32_t counts[class_count] = {};
+    };
+
+    struct central_list {
+        std::mutex mutex;
+        free_block* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    // 16..128 by 16, 160..256 by 32, 320..512 by 64, 640..1024 by 128.
+    static std::size_t class_of(std::size_t bytes) noexcept {
+        if (bytes <= 128)
+            return bytes <= 16 ? 0 : (bytes - 1) / 16;
+        std::size_t group = static_cast<std::size_t>(std::bit_width((bytes - 1) >> 7));  // 1..3
+        std::size_t step = std::size_t(16) << group;
+        std::size_t base = std::size_t(128) << (group - 1);
+        return 8 + (group - 1) * 4 + (bytes - base - 1) / step;
+    }
+
+    static std::size_t class_size(std::size_t c) noexcept {
+        if (c < 8)
+            return (c + 1) * 16;
+        std::size_t group = (c - 8) / 4 + 1;
+        return (std::size_t(128) << (group - 1)) + ((c - 8) % 4 + 1) * (std::size_t(16) << group);
+    }
+
+    static std::size_t batch_of(std::size_t c) noexcept {
+        std::size_t b = 4096 / class_size(c);
+        return b < 4 ? 4 : b;
+    }
+
+    shard& my_shard() noexcept {
+        static std::atomic<unsigned> next_slot{0};
+        thread_local unsigned slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+        return shards_[slot & (shard_count_ - 1)];
+    }
+
+    void* allocate_small(std::size_t c) {
+        shard& s = my_shard();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (!s.heads[c])
+            refill(s, c);
+        free_block* b = s.heads[c];
+        s.heads[c] = b->next;
+        --s.counts[c];
+        return b;
+    }
+
+    void deallocate_small(void* p, std::size_t c) {
+        shard& s = my_shard();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        auto* b = static_cast<free_block*>(p);
+        b->next = s.heads[c];
+        s.heads[c] = b;
+        if (++s.counts[c] > 2 * batch_of(c))
+            spill(s, c);
+    }
+
+    // Moves a batch from the central list, or from a fresh span, to `s`.
+    void refill(shard& s, std::size_t c) {
+        const std::size_t batch = batch_of(c);
+        {
+            central_list& cl = central_[c];
+            std::lock_guard<std::mutex> lock(cl.mutex);
+            for (std::size_t i = 0; i < batch && cl.head; ++i) {
+                free_block* b = cl.head;
+                cl.head = b->next;
+                --cl.count;
+                b->next = s.heads[c];
+                s.heads[c] = b;
+                ++s.counts[c];
+            }
+        }
+        if (s.heads[c])
+            return;
+        const std::size_t size = class_size(c);
+        std::lock_guard<std::mutex> lock(span_mutex_);
+        for (std::size_t i = 0; i < batch; ++i) {
+            if (span_left_ < size) {
+                spans_.push_back(nullptr);
+                try {
+                    spans_.back() = upstream_->allocate(span_size, 16);
+                } catch (...) {
+                    spans_.pop_back();
+                    throw;
+                }
+                span_cur_ = static_cast<char*>(spans_.back());
+                span_left_ = span_size;
+            }
+            auto* b = reinterpret_cast<free_block*>(span_cur_);
+            span_cur_ += size;
+            span_left_ -= size;
+            b->next = s.heads[c];
+            s.heads[c] = b;
+            ++s.counts[c];
+        }
+    }
+
+    // Returns half of an overfull shard list to the central list.
+    void spill(shard& s, std::size_t c) {
+        central_list& cl = central_[c];
+        std::lock_guard<std::mutex> lock(cl.mutex);
+        for (std::size_t n = s.counts[c] / 2; n; --n) {
+            free_block* b = s.heads[c];
+            s.heads[c] = b->next;
+            --s.counts[c];
+            b->next = cl.head;
+            cl.head = b;
+            ++cl.count;
+        }
+    }
+
+    // ---- boundary-tagged blocks ---------------------------------------------
+
+    // A block starts with a 16-byte header whose first word is its size with
+    // the in-use, previous-in-use and arena-first flags in the low bits.  Free
+    // blocks hold their list links after the header and repeat the size in
+    // the last word.
+    static constexpr std::size_t header_size = 16;
+    static constexpr std::size_t min_block = 48;
+    static constexpr std::size_t used_bit = 1;
+    static constexpr std::size_t prev_used_bit = 2;
+    static constexpr std::size_t first_bit = 4;
+    static constexpr std::size_t bin_count = 48;
+
+    struct link {
+        link* prev;
+        link* next;
+    };
+
+    struct arena {
+        arena* prev;
+        arena* next;
+        std::size_t size;
+        std::size_t pad;
+    };
+
+    std::size_t large_limit() const noexcept { return arena_size_ / 4; }
+
+    // Size of the block that serves a request of `bytes`, header included.
+    static std::size_t block_for(std::size_t bytes) noexcept {
+        return std::max(min_block, (bytes + 15) / 16 * 16 + header_size);
+    }
+
+    // Sizes share their word with the flags, so an arena and every block in
+    // it must be a multiple of 16.  An arena holds its header, the free
+    // block for the largest medium request and the epilogue tag.
+    static std::size_t checked_arena_size(std::size_t arena_size) {
+        if (arena_size % 16 != 0)
+            throw std::invalid_argument("segregated_resource: arena size must be a multiple of 16");
+        if (arena_size < sizeof(arena) + block_for(arena_size / 4) + header_size)
+            throw std::invalid_argument("segregated_resource: arena size too small");
+        return arena_size;
+    }
+
+    static std::size_t& tag(char* block) noexcept { return *reinterpret_cast<std::size_t*>(block); }
+    static std::size_t size_of(char* block) noexcept { return tag(block) & ~std::size_t(15); }
+    static link* links(char* block) noexcept { return reinterpret_cast<link*>(block + header_size); }
+    static char* block_of(link* l) noexcept { return reinterpret_cast<char*>(l) - header_size; }
+    static void set_footer(char* block, std::size_t size) noexcept {
+        *reinterpret_cast<std::size_t*>(block + size - sizeof(std::size_t)) = size;
+    }
+
+    static std::size_t bin_of(std::size_t size) noexcept {
+        return static_cast<std::size_t>(std::bit_width(size)) - 1;
+    }
+
+    void insert_free(char* block, std::size_t size) noexcept {
+        link* head = &bins_[bin_of(size)];
+        link* l = links(block);
+        l->prev = head;
+        l->next = head->next;
+        head->next->prev = l;
+        head->next = l;
+    }
+
+    static void remove_free(char* block) noexcept {
+        link* l = links(block);
+        l->prev->next = l->next;
+        l->next->prev = l->prev;
+    }
+
+    void* allocate_large(std::size_t bytes) {
+        const std::size_t need = block_for(bytes);
+        std::lock_guard<std::mutex> lock(large_mutex_);
+        char* block = nullptr;
+        for (std::size_t b = bin_of(need); b < bin_count && !block; ++b) {
+            for (link* l = bins_[b].next; l != &bins_[b]; l = l->next) {
+                if (size_of(block_of(l)) >= need) {
+                    block = block_of(l);
+                    break;
+                }
+            }
+        }
+        if (!block)
+            block = new_arena();
+        remove_free(block);
+
+        std::size_t size = size_of(block);
+        std::size_t flags = tag(block) & (prev_used_bit | first_bit);
+        if (size - need >= min_block) {
+            char* rest = block + need;
+            tag(rest) = (size - need) | prev_used_bit;
+            set_footer(rest, size - need);
+            insert_free(rest, size - need);
+            size = need;
+        } else {
+            tag(block + size) |= prev_used_bit;
+        }
+        tag(block) = size | used_bit | flags;
+        return block + header_size;
+    }
+
+    void deallocate_large(void* p) {
+        std::lock_guard<std::mutex> lock(large_mutex_);
+        char* block = static_cast<char*>(p) - header_size;
+        std::size_t size = size_of(block);
+
+        char* next = block + size;
+        if (!(tag(next) & used_bit)) {
+            remove_free(next);
+            size += size_of(next);
+        }
+        if (!(tag(block) & prev_used_bit)) {
+            std::size_t prev_size = *reinterpret_cast<std::size_t*>(block - sizeof(std::size_t));
+            block -= prev_size;
+            remove_free(block);
+            size += prev_size;
+        }
+        // The block before a free block is always in use.
+        const std::size_t first = tag(block) & first_bit;
+        tag(block) = size | prev_used_bit | first;
+        set_footer(block, size);
+        tag(block + size) &= ~prev_used_bit;
+
+        // A free block that starts an arena and runs into its epilogue spans
+        // the whole arena: return the arena upstream.
+        if (first && tag(block + size) == used_bit) {
+            auto* a = reinterpret_cast<arena*>(block - sizeof(arena));
+            if (a->prev)
+                a->prev->next = a->next;
+            else
+                arenas_ = a->next;
+            if (a->next)
+                a->next->prev = a->prev;
+            upstream_->deallocate(a, a->size, 16);
+            return;
+        }
+        insert_free(block, size);
+    }
+
+    // Maps a new arena as one free block followed by an in-use, zero-size
+    // epilogue header, and returns that free block (already in a bin).
+    char* new_arena() {
+        auto* a = static_cast<arena*>(upstream_->allocate(arena_size_, 16));
+        a->prev = nullptr;
+        a->next = arenas_;
+        a->size = arena_size_;
+        if (arenas_)
+            arenas_->prev = a;
+        arenas_ = a;
+        char* block = reinterpret_cast<char*>(a + 1);
+        std::size_t size = arena_size_ - sizeof(arena) - header_size;
+        tag(block) = size | prev_used_bit | first_bit;
+        set_footer(block, size);
+        tag(block + size) = used_bit;
+        insert_free(block, size);
+        return block;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::size_t arena_size_;
+
+    std::size_t shard_count_;
+    std::unique_ptr<shard[]> shards_;
+    central_list central_[class_count];
+    std::mutex span_mutex_;
+    std::vector<void*> spans_;
+    char* span_cur_ = nullptr;
+    std::size_t span_left_ = 0;
+
+    std::mutex large_mutex_;
+    link bins_[bin_count];
+    arena* arenas_ = nullptr;
+};
+
+} // namespace p_linked_list
+
+#endif
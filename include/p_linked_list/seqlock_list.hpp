@@ -0,0 +1,272 @@
+// Fixed-capacity list for tiny, read-mostly data guarded by a seqlock.
+//
+// Readers never write shared memory: they read the sequence number, walk the
+// list copying values out, and retry if the sequence number was odd or has
+// changed meanwhile.  Writers serialize on a mutex and make the sequence
+// number odd for the duration of each mutation.  Suits routing tables and
+// flag sets read on every request and changed rarely.
+//
+// Because readers can observe a list mid-update, every shared field is an
+// atomic accessed with relaxed loads, values are stored as atomic 64-bit
+// words, and traversal is bounded by the capacity.  T must be trivially
+// copyable.  Predicates passed to readers run on copies that may be torn
+// and are only trusted once the read validates.
+
+#ifndef P_LINKED_LIST_SEQLOCK_LIST_HPP
+#define P_LINKED_LIST_SEQLOCK_LIST_HPP
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace p_linked_list {
+
+template <class T, std::size_t Capacity>
+class seqlock_list {
+    static_assert(std::is_trivially_copyable_v<T>, "readers copy values racily");
+    static_assert(Capacity > 0 && Capacity < 0xffffffffu, "indices are 32-bit");
+
+public:
+    seqlock_list() {
+        for (std::uint32_t i = 0; i < Capacity; ++i)
+            free_.push_back(static_cast<std::uint32_t>(Capacity - 1 - i));
+    }
+
+    seqlock_list(const seqlock_list&) = delete;
+    seqlock_list& operator=(const seqlock_list&) = delete;
+
+    // ---- readers ------------------------------------------------------------
+
+    // Replaces `out` with a consistent copy of the list, front to back.
+    void snapshot(std::vector<T>& out) const {
+        out.reserve(Capacity);
+        for (;;) {
+            out.clear();
+            std::uint64_t s = begin_read();
+            std::uint32_t i = head_.load(std::memory_order_relaxed);
+            for (std::size_t steps = 0; i != nil && steps < Capacity; ++steps) {
+                out.push_back(load(slots_[i]));
+                i = slots_[i].next.load(std::memory_order_relaxed);
+            }
+            if (end_read(s))
+                return;
+        }
+    }
+
+    std::vector<T> snapshot() const {
+        std::vector<T> out;
+        snapshot(out);
+        return out;
+    }
+
+    // Returns a copy of the first element satisfying `pred`.
+    template <class Pred>
+    std::optional<T> find_if(Pred pred) const {
+        for (;;) {
+            std::optional<T> found;
+            std::uint64_t s = begin_read();
+            std::uint32_t i = head_.load(std::memory_order_relaxed);
+            for (std::size_t steps = 0; i != nil && steps < Capacity; ++steps) {
+                T v = load(slots_[i]);
+                if (pred(static_cast<const T&>(v))) {
+                    found = v;
+                    break;
+                }
+                i = slots_[i].next.load(std::memory_order_relaxed);
+            }
+            if (end_read(s))
+                return found;
+        }
+    }
+
+    std::size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+    bool empty() const noexcept { return size() == 0; }
+    static constexpr std::size_t capacity() noexcept { return Capacity; }
+
+    // ---- writers ------------------------------------------------------------
+
+    // Returns false when the list is full.
+    bool push_front(const T& value) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (free_.empty())
+            return false;
+        write_guard w(*this);
+        std::uint32_t n = take_slot(value);
+        slots_[n].next.store(head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        head_.store(n, std::memory_order_relaxed);
+        if (tail_ == nil)
+            tail_ = n;
+        return true;
+    }
+
+    bool push_back(const T& value) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (free_.empty())
+            return false;
+        write_guard w(*this);
+        std::uint32_t n = take_slot(value);
+        slots_[n].next.store(nil, std::memory_order_relaxed);
+        if (tail_ == nil)
+            head_.store(n, std::memory_order_relaxed);
+        else
+            slots_[tail_].next.store(n, std::memory_order_relaxed);
+        tail_ = n;
+        return true;
+    }
+
+    // Removes every element satisfying `pred`; returns how many.  `pred` runs
+    // before the write section opens, so if it throws the list is unchanged
+    // and readers were never held up.
+    template <class Pred>
+    std::size_t erase_if(Pred pred) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        std::vector<std::uint32_t> doomed;
+        for (std::uint32_t i = head_.load(std::memory_order_relaxed); i != nil;
+             i = slots_[i].next.load(std::memory_order_relaxed)) {
+            if (pred(static_cast<const T&>(load(slots_[i]))))
+                doomed.push_back(i);
+        }
+        if (doomed.empty())
+            return 0;
+
+        write_guard w(*this);
+        std::size_t k = 0;
+        std::uint32_t prev = nil;
+        std::uint32_t i = head_.load(std::memory_order_relaxed);
+        while (i != nil) {
+            std::uint32_t next = slots_[i].next.load(std::memory_order_relaxed);
+            if (k < doomed.size() && doomed[k] == i) {
+                if (prev == nil)
+                    head_.store(next, std::memory_order_relaxed);
+                else
+                    slots_[prev].next.store(next, std::memory_order_relaxed);
+                if (tail_ == i)
+                    tail_ = prev;
+                free_.push_back(i);
+                ++k;
+            } else {
+                prev = i;
+            }
+            i = next;
+        }
+        size_.fetch_sub(doomed.size(), std::memory_order_relaxed);
+        return doomed.size();
+    }
+
+    // Replaces the contents with [first, last) in one write section.
+    // Returns false, leaving the list unchanged, if the range does not fit.
+    template <class It>
+    bool assign(It first, It last) {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        if (static_cast<std::size_t>(std::distance(first, last)) > Capacity)
+            return false;
+        write_guard w(*this);
+        clear_locked();
+        for (; first != last; ++first) {
+            std::uint32_t n = take_slot(*first);
+            slots_[n].next.store(nil, std::memory_order_relaxed);
+            if (tail_ == nil)
+                head_.store(n, std::memory_order_relaxed);
+            else
+                slots_[tail_].next.store(n, std::memory_order_relaxed);
+            tail_ = n;
+        }
+        return true;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(write_mutex_);
+        write_guard w(*this);
+        clear_locked();
+    }
+
+private:
+    static constexpr std::uint32_t nil = 0xffffffffu;
+    static constexpr std::size_t words = (sizeof(T) + 7) / 8;
+
+    struct slot {
+        std::atomic<std::uint32_t> next{nil};
+        std::atomic<std::uint64_t> data[words] = {};
+    };
+
+    // Makes the sequence odd for its lifetime.
+    struct write_guard {
+        explicit write_guard(seqlock_list& l) : list(l) {
+            list.seq_.store(list.seq_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+        ~write_guard() {
+            list.seq_.store(list.seq_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+        }
+        seqlock_list& list;
+    };
+
+    std::uint64_t begin_read() const noexcept {
+        for (;;) {
+            std::uint64_t s = seq_.load(std::memory_order_acquire);
+            if (!(s & 1))
+                return s;
+        }
+    }
+
+    bool end_read(std::uint64_t s) const noexcept {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq_.load(std::memory_order_relaxed) == s;
+    }
+
+    static T load(const slot& s) noexcept {
+        std::array<std::uint64_t, words> w;
+        for (std::size_t k = 0; k < words; ++k)
+            w[k] = s.data[k].load(std::memory_order_relaxed);
+        std::array<unsigned char, sizeof(T)> bytes;
+        std::memcpy(bytes.data(), w.data(), sizeof(T));
+        return std::bit_cast<T>(bytes);
+    }
+
+    static void store(slot& s, const T& value) noexcept {
+        std::array<std::uint64_t, words> w{};
+        std::memcpy(w.data(), &value, sizeof(T));
+        for (std::size_t k = 0; k < words; ++k)
+            s.data[k].store(w[k], std::memory_order_relaxed);
+    }
+
+    std::uint32_t take_slot(const T& value) {
+        std::uint32_t n = free_.back();
+        free_.pop_back();
+        store(slots_[n], value);
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return n;
+    }
+
+    void clear_locked() {
+        for (std::uint32_t i = head_.load(std::memory_order_relaxed); i != nil;) {
+            free_.push_back(i);
+            i = slots_[i].next.load(std::memory_order_relaxed);
+        }
+        head_.store(nil, std::memory_order_relaxed);
+        tail_ = nil;
+        size_.store(0, std::memory_order_relaxed);
+    }
+
+    alignas(64) std::atomic<std::uint64_t> seq_{0};
+    std::atomic<std::uint32_t> head_{nil};
+    std::atomic<std::size_t> size_{0};
+    slot slots_[Capacity];
+
+    // Writer-only state.
+    std::mutex write_mutex_;
+    std::uint32_t tail_ = nil;
+    std::vector<std::uint32_t> free_;
+};
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,304 @@
+// Sorted singly linked list with batched insertion.
+//
+// Single-element insert() walks from the front, so inserting b items one at
+// a time into a list of n costs O(n * b).  insert_sorted_batch() and
+// upsert_sorted_batch() instead sort the batch and merge it into the list in
+// one forward pass, relinking the new nodes in place: O(n + b log b).
+//
+// Nodes are carved from chunks requested from a std::pmr::memory_resource, so
+// a batch of b elements costs one allocation rather than b.  Erased nodes go
+// to a free list that later inserts reuse; chunks are returned when the list
+// is destroyed.  Equal elements keep insertion order.
+
+#ifndef P_LINKED_LIST_SORTED_LIST_HPP
+#define P_LINKED_LIST_SORTED_LIST_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace p_linked_list {
+
+template <class T, class Compare = std::less<T>>
+class sorted_list {
+    struct node {
+        node* next = nullptr;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T& value() noexcept { return *std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    struct chunk {
+        chunk* next;
+        std::size_t count;
+
+        node* nodes() noexcept { return reinterpret_cast<node*>(reinterpret_cast<char*>(this) + header_size()); }
+    };
+
+    static constexpr std::size_t header_size() noexcept {
+        return (sizeof(chunk) + alignof(node) - 1) / alignof(node) * alignof(node);
+    }
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        iterator() = default;
+
+        const T& operator*() const { return n_->value(); }
+        const T* operator->() const { return &n_->value(); }
+        iterator& operator++() { n_ = n_->next; return *this; }
+        iterator operator++(int) { iterator t = *this; ++*this; return t; }
+        friend bool operator==(iterator a, iterator b) { return a.n_ == b.n_; }
+        friend bool operator!=(iterator a, iterator b) { return a.n_ != b.n_; }
+
+    private:
+        friend class sorted_list;
+        explicit iterator(node* n) : n_(n) {}
+        node* n_ = nullptr;
+    };
+
+    // Default merge for upsert_sorted_batch(): the incoming value replaces
+    // the stored one.
+    struct replace {
+        void operator()(T& stored, T&& incoming) const { stored = std::move(incoming); }
+    };
+
+    explicit sorted_list(Compare comp = Compare(),
+                         std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : comp_(std::move(comp)), mr_(mr) {}
+
+    explicit sorted_list(std::pmr::memory_resource* mr) : sorted_list(Compare(), mr) {}
+
+    sorted_list(const sorted_list&) = delete;
+    sorted_list& operator=(const sorted_list&) = delete;
+
+    ~sorted_list() {
+        clear();
+        while (chunk* c = chunks_) {
+            chunks_ = c->next;
+            mr_->deallocate(c, header_size() + c->count * sizeof(node), alignof(node));
+        }
+    }
+
+    // Inserts after any equal elements.  O(n).
+    iterator insert(const T& value) { return insert_one(value); }
+    iterator insert(T&& value) { return insert_one(std::move(value)); }
+
+    // Inserts every element of [first, last), keeping duplicates.
+    template <class It>
+    void insert_sorted_batch(It first, It last) {
+        std::vector<node*> batch = make_batch(first, last);
+        node** link = &head_;
+        for (node* n : batch) {
+            while (*link && !comp_(n->value(), (*link)->value()))
+                link = &(*link)->next;
+            n->next = *link;
+            *link = n;
+            link = &n->next;
+        }
+        size_ += batch.size();
+    }
+
+    // Inserts the elements of [first, last) that have no equal element in
+    // the list; for those that do, calls merge(stored, std::move(incoming)).
+    // Equal elements within the batch are merged into the first of them.
+    // merge must not change the stored element's position in the order.
+    // Returns the number of elements inserted.
+    template <class It, class Merge = replace>
+    std::size_t upsert_sorted_batch(It first, It last, Merge merge = Merge()) {
+        std::vector<node*> batch = make_batch(first, last);
+        std::size_t i = 0;
+        std::size_t inserted = 0;
+        try {
+            node** link = &head_;
+            node* prev = nullptr;  // the node before *link
+            for (; i < batch.size(); ++i) {
+                node* n = batch[i];
+                while (*link && comp_((*link)->value(), n->value())) {
+                    prev = *link;
+                    link = &prev->next;
+                }
+                node* match = nullptr;
+                if (*link && !comp_(n->value(), (*link)->value()))
+                    match = *link;
+                else if (prev && !comp_(prev->value(), n->value()))
+                    match = prev;
+                if (match) {
+                    merge(match->value(), std::move(n->value()));
+                    release(n);
+                    continue;
+                }
+                n->next = *link;
+                *link = n;
+                prev = n;
+                link = &n->next;
+                ++size_;
+                ++inserted;
+            }
+        } catch (...) {
+            for (; i < batch.size(); ++i)
+                release(batch[i]);
+            throw;
+        }
+        return inserted;
+    }
+
+    iterator find(const T& value) const {
+        node* n = lower_bound_node(value);
+        return n && !comp_(value, n->value()) ? iterator(n) : end();
+    }
+
+    bool contains(const T& value) const { return find(value) != end(); }
+
+    // Removes the first element equal to `value`; returns whether one was.
+    bool erase(const T& value) {
+        node** link = &head_;
+        while (*link && comp_((*link)->value(), value))
+            link = &(*link)->next;
+        if (!*link || comp_(value, (*link)->value()))
+            return false;
+        node* n = *link;
+        *link = n->next;
+        release(n);
+        --size_;
+        return true;
+    }
+
+    void pop_front() {
+        node* n = head_;
+        head_ = n->next;
+        release(n);
+        --size_;
+    }
+
+    void clear() {
+        while (head_)
+            pop_front();
+    }
+
+    const T& front() const { return head_->value(); }
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t size() const noexcept { return size_; }
+
+    iterator begin() const { return iterator(head_); }
+    iterator end() const { return iterator(nullptr); }
+
+private:
+    template <class U>
+    iterator insert_one(U&& value) {
+        node* n = take_node();
+        try {
+            ::new (static_cast<void*>(n->storage)) T(std::forward<U>(value));
+        } catch (...) {
+            give_back(n);
+            throw;
+        }
+        node** link = &head_;
+        while (*link && !comp_(n->value(), (*link)->value()))
+            link = &(*link)->next;
+        n->next = *link;
+        *link = n;
+        ++size_;
+        return iterator(n);
+    }
+
+    node* lower_bound_node(const T& value) const {
+        node* n = head_;
+        while (n && comp_(n->value(), value))
+            n = n->next;
+        return n;
+    }
+
+    // Builds nodes for [first, last), stably sorted.  Nodes come from the
+    // free list first and then from one new chunk for the remainder.
+    template <class It>
+    std::vector<node*> make_batch(It first, It last) {
+        std::vector<node*> batch;
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                        typename std::iterator_traits<It>::iterator_category>) {
+            const auto count = static_cast<std::size_t>(std::distance(first, last));
+            batch.reserve(count);
+            if (free_count_ < count)
+                add_chunk(count - free_count_);
+        }
+        try {
+            for (; first != last; ++first) {
+                node* n = take_node();
+                try {
+                    ::new (static_cast<void*>(n->storage)) T(*first);
+                } catch (...) {
+                    give_back(n);
+                    throw;
+                }
+                batch.push_back(n);
+            }
+            std::stable_sort(batch.begin(), batch.end(),
+                             [this](node* a, node* b) { return comp_(a->value(), b->value()); });
+        } catch (...) {
+            for (node* n : batch)
+                release(n);
+            throw;
+        }
+        return batch;
+    }
+
+    node* take_node() {
+        if (!free_)
+            add_chunk(chunk_min);
+        node* n = free_;
+        free_ = n->next;
+        --free_count_;
+        return n;
+    }
+
+    void add_chunk(std::size_t count) {
+        count = std::max(count, chunk_min);
+        void* mem = mr_->allocate(header_size() + count * sizeof(node), alignof(node));
+        chunk* c = ::new (mem) chunk{chunks_, count};
+        chunks_ = c;
+        node* nodes = c->nodes();
+        for (std::size_t i = count; i-- > 0;) {
+            node* n = ::new (static_cast<void*>(nodes + i)) node;
+            n->next = free_;
+            free_ = n;
+        }
+        free_count_ += count;
+    }
+
+    void release(node* n) noexcept {
+        n->value().~T();
+        give_back(n);
+    }
+
+    void give_back(node* n) noexcept {
+        n->next = free_;
+        free_ = n;
+        ++free_count_;
+    }
+
+    static constexpr std::size_t chunk_min = 16;
+
+    [[no_unique_address]] Compare comp_;
+    std::pmr::memory_resource* mr_;
+    node* head_ = nullptr;
+    std::size_t size_ = 0;
+    node* free_ = nullptr;
+    std::size_t free_count_ = 0;
+    chunk* chunks_ = nullptr;
+};
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,338 @@
+// Orthogonal-list sparse matrix with a cached CSR snapshot.
+//
+// Every nonzero is a node linked into two sorted doubly linked lists: its
+// row (by column) and its column (by row).  Given the neighbouring entries
+// in both lists an insert is O(1), and erasing an entry is always O(1).
+// Nodes live in a deque and are recycled through a free list.
+//
+// Walking linked rows is slow for SpMV, so csr() keeps a compressed sparse
+// row snapshot and refreshes it lazily.  Structural changes mark only their
+// row dirty.  A refresh rewrites dirty rows whose length is unchanged in
+// place, touching nothing else.  If some row changed length, the snapshot is
+// rebuilt once into a second, reused pair of arrays: dirty rows are written
+// from their nodes and each run of clean rows between them is one bulk copy.
+// Each node remembers its offset within its row, so a value change in a
+// clean row is written straight into the snapshot and invalidates nothing.
+// multiply() runs SpMV on the snapshot with rows split across threads by
+// nonzero count.
+
+#ifndef P_LINKED_LIST_SPARSE_MATRIX_HPP
+#define P_LINKED_LIST_SPARSE_MATRIX_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace p_linked_list {
+
+template <class T>
+class sparse_matrix {
+    struct node {
+        std::size_t row;
+        std::size_t col;
+        T value;
+        node* left;
+        node* right;
+        node* up;
+        node* down;
+        std::size_t offset;  // position within the row in the CSR snapshot
+    };
+
+public:
+    // Handle to a stored entry; null when default-constructed.
+    class entry {
+    public:
+        entry() = default;
+
+        std::size_t row() const noexcept { return n_->row; }
+        std::size_t col() const noexcept { return n_->col; }
+        const T& value() const noexcept { return n_->value; }
+
+        entry next_in_row() const noexcept { return entry(n_->right); }
+        entry prev_in_row() const noexcept { return entry(n_->left); }
+        entry next_in_col() const noexcept { return entry(n_->down); }
+        entry prev_in_col() const noexcept { return entry(n_->up); }
+
+        explicit operator bool() const noexcept { return n_ != nullptr; }
+        friend bool operator==(entry a, entry b) noexcept { return a.n_ == b.n_; }
+
+    private:
+        friend class sparse_matrix;
+        explicit entry(node* n) : n_(n) {}
+        node* n_ = nullptr;
+    };
+
+    struct csr_view {
+        std::span<const std::size_t> row_ptr;  // rows() + 1 offsets
+        std::span<const std::size_t> col_idx;
+        std::span<const T> values;
+    };
+
+    sparse_matrix(std::size_t rows, std::size_t cols)
+        : row_head_(rows, nullptr), row_tail_(rows, nullptr), col_head_(cols, nullptr),
+          col_tail_(cols, nullptr), row_size_(rows, 0), row_dirty_(rows, true),
+          row_ptr_(rows + 1, 0), have_csr_(false) {}
+
+    sparse_matrix(const sparse_matrix&) = delete;
+    sparse_matrix& operator=(const sparse_matrix&) = delete;
+
+    std::size_t rows() const noexcept { return row_head_.size(); }
+    std::size_t cols() const noexcept { return col_head_.size(); }
+    std::size_t nonzeros() const noexcept { return nonzeros_; }
+
+    entry row_begin(std::size_t r) const { return entry(row_head_.at(r)); }
+    entry row_last(std::size_t r) const { return entry(row_tail_.at(r)); }
+    entry col_begin(std::size_t c) const { return entry(col_head_.at(c)); }
+    entry col_last(std::size_t c) const { return entry(col_tail_.at(c)); }
+
+    // Walks row r.
+    entry find(std::size_t r, std::size_t c) const {
+        auto [left, right] = row_neighbours(r, c);
+        (void)left;
+        return right && right->col == c ? entry(right) : entry();
+    }
+
+    // Inserts (r, c) between `row_prev` and its successor in row r and
+    // between `col_prev` and its successor in column c; a null cursor means
+    // the front.  The cursors must be the entries just before (r, c) in
+    // their lists, which is checked only by assertions.  O(1).
+    entry insert(std::size_t r, std::size_t c, T value, entry row_prev, entry col_prev) {
+        node* n = allocate(r, c, std::move(value));
+        node* rp = row_prev.n_;
+        node* cp = col_prev.n_;
+        assert(!rp || (rp->row == r && rp->col < c));
+        assert(!cp || (cp->col == c && cp->row < r));
+
+        n->left = rp;
+        n->right = rp ? rp->right : row_head_[r];
+        assert(!n->right || n->right->col > c);
+        (rp ? rp->right : row_head_[r]) = n;
+        (n->right ? n->right->left : row_tail_[r]) = n;
+
+        n->up = cp;
+        n->down = cp ? cp->down : col_head_[c];
+        assert(!n->down || n->down->row > r);
+        (cp ? cp->down : col_head_[c]) = n;
+        (n->down ? n->down->up : col_tail_[c]) = n;
+
+        ++row_size_[r];
+        ++nonzeros_;
+        mark_dirty(r);
+        return entry(n);
+    }
+
+    // Sets (r, c) to `value`, inserting it if absent.  Walks row r and
+    // column c to find the neighbours.
+    entry set(std::size_t r, std::size_t c, T value) {
+        if (r >= rows() || c >= cols())
+            throw std::out_of_range("sparse_matrix::set");
+        auto [row_prev, right] = row_neighbours(r, c);
+        if (right && right->col == c) {
+            update(entry(right), std::move(value));
+            return entry(right);
+        }
+        node* col_prev = col_tail_[c];
+        while (col_prev && col_prev->row > r)
+            col_prev = col_prev->up;
+        return insert(r, c, std::move(value), entry(row_prev), entry(col_prev));
+    }
+
+    // Changes a value in place; a clean snapshot is patched, not invalidated.
+    void update(entry e, T value) {
+        node* n = e.n_;
+        n->value = std::move(value);
+        if (have_csr_ && !row_dirty_[n->row])
+            values_[row_ptr_[n->row] + n->offset] = n->value;
+    }
+
+    void erase(entry e) {
+        node* n = e.n_;
+        (n->left ? n->left->right : row_head_[n->row]) = n->right;
+        (n->right ? n->right->left : row_tail_[n->row]) = n->left;
+        (n->up ? n->up->down : col_head_[n->col]) = n->down;
+        (n->down ? n->down->up : col_tail_[n->col]) = n->up;
+        --row_size_[n->row];
+        --nonzeros_;
+        mark_dirty(n->row);
+        n->value = T();
+        n->right = free_;
+        free_ = n;
+    }
+
+    // Returns the CSR snapshot, refreshing dirty rows first.  The spans stay
+    // valid until the next structural change followed by csr() or multiply().
+    const csr_view& csr() {
+        if (!dirty_rows_.empty() || !have_csr_)
+            refresh();
+        return view_;
+    }
+
+    // y = A * x, on the snapshot, with rows split over `threads` threads
+    // (0 means std::thread::hardware_concurrency()).
+    void multiply(std::span<const T> x, std::span<T> y, unsigned threads = 1) {
+        if (x.size() != cols() || y.size() != rows())
+            throw std::invalid_argument("sparse_matrix::multiply: size mismatch");
+        csr();
+        if (threads == 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        threads = static_cast<unsigned>(std::min<std::size_t>(threads, nonzeros_ / min_nonzeros_per_thread + 1));
+        if (threads <= 1) {
+            multiply_rows(x, y, 0, rows());
+            return;
+        }
+        // Split at rows whose start offset crosses each equal share of
+        // nonzeros, so threads get similar work regardless of row lengths.
+        std::vector<std::size_t> bounds(threads + 1, rows());
+        bounds[0] = 0;
+        for (unsigned i = 1; i < threads; ++i) {
+            std::size_t target = nonzeros_ / threads * i;
+            bounds[i] = static_cast<std::size_t>(
+                std::lower_bound(row_ptr_.begin(), row_ptr_.end() - 1, target) - row_ptr_.begin());
+            bounds[i] = std::max(bounds[i], bounds[i - 1]);
+        }
+        std::vector<std::jthread> workers;
+        workers.reserve(threads - 1);
+        for (unsigned i = 1; i < threads; ++i)
+            workers.emplace_back([&, i] { multiply_rows(x, y, bounds[i], bounds[i + 1]); });
+        multiply_rows(x, y, bounds[0], bounds[1]);
+        for (auto& w : workers)
+            w.join();
+    }
+
+private:
+    static constexpr std::size_t min_nonzeros_per_thread = 1 << 14;
+
+    node* allocate(std::size_t r, std::size_t c, T&& value) {
+        node* n = free_;
+        if (n) {
+            free_ = n->right;
+            n->value = std::move(value);
+        } else {
+            n = &storage_.emplace_back(node{0, 0, std::move(value), nullptr, nullptr, nullptr, nullptr, 0});
+        }
+        n->row = r;
+        n->col = c;
+        return n;
+    }
+
+    // The last entry of row r before column c, and the one after it.
+    std::pair<node*, node*> row_neighbours(std::size_t r, std::size_t c) const {
+        node* prev = nullptr;
+        node* next = row_head_.at(r);
+        while (next && next->col < c) {
+            prev = next;
+            next = next->right;
+        }
+        return {prev, next};
+    }
+
+    void mark_dirty(std::size_t r) {
+        if (!row_dirty_[r]) {
+            row_dirty_[r] = true;
+            dirty_rows_.push_back(r);
+        }
+    }
+
+    void refresh() {
+        // Rows before the first one whose length changed keep their offsets.
+        std::size_t first = have_csr_ ? rows() : 0;
+        for (std::size_t r : dirty_rows_) {
+            if (row_ptr_[r + 1] - row_ptr_[r] != row_size_[r])
+                first = std::min(first, r);
+        }
+        for (std::size_t r : dirty_rows_) {
+            if (r < first) {
+                write_row(r, col_idx_.begin() + row_ptr_[r], values_.begin() + row_ptr_[r]);
+                row_dirty_[r] = false;
+            }
+        }
+        if (first < rows()) {
+            // Build the shifted snapshot in the spare arrays and swap them
+            // in.  Clean rows between dirty ones are contiguous in the old
+            // snapshot, so each run of them is one bulk copy.
+            const std::size_t from = row_ptr_[first];
+            spare_col_idx_.resize(nonzeros_);
+            spare_values_.resize(nonzeros_);
+            std::copy_n(col_idx_.begin(), from, spare_col_idx_.begin());
+            std::move(values_.begin(), values_.begin() + static_cast<std::ptrdiff_t>(from),
+                      spare_values_.begin());
+            std::size_t at = from;
+            for (std::size_t r = first; r < rows();) {
+                if (row_dirty_[r]) {
+                    write_row(r, spare_col_idx_.begin() + at, spare_values_.begin() + at);
+                    row_dirty_[r] = false;
+                    at += row_size_[r++];
+                    continue;
+                }
+                std::size_t end = r + 1;
+                while (end < rows() && !row_dirty_[end])
+                    ++end;
+                const auto old = static_cast<std::ptrdiff_t>(row_ptr_[r]);
+                const auto len = static_cast<std::ptrdiff_t>(row_ptr_[end] - row_ptr_[r]);
+                std::copy_n(col_idx_.begin() + old, len, spare_col_idx_.begin() + static_cast<std::ptrdiff_t>(at));
+                std::move(values_.begin() + old, values_.begin() + old + len,
+                          spare_values_.begin() + static_cast<std::ptrdiff_t>(at));
+                at += static_cast<std::size_t>(len);
+                r = end;
+            }
+            for (std::size_t r = first; r < rows(); ++r)
+                row_ptr_[r + 1] = row_ptr_[r] + row_size_[r];
+            col_idx_.swap(spare_col_idx_);
+            values_.swap(spare_values_);
+        }
+        dirty_rows_.clear();
+        have_csr_ = true;
+        view_ = {row_ptr_, col_idx_, values_};
+    }
+
+    // Writes row r from its nodes and records their offsets.
+    template <class ColIt, class ValIt>
+    void write_row(std::size_t r, ColIt col, ValIt val) {
+        std::size_t k = 0;
+        for (node* n = row_head_[r]; n; n = n->right, ++k) {
+            n->offset = k;
+            col[k] = n->col;
+            val[k] = n->value;
+        }
+    }
+
+    void multiply_rows(std::span<const T> x, std::span<T> y, std::size_t first, std::size_t last) const {
+        for (std::size_t r = first; r < last; ++r) {
+            T sum = T();
+            for (std::size_t k = row_ptr_[r]; k < row_ptr_[r + 1]; ++k)
+                sum += values_[k] * x[col_idx_[k]];
+            y[r] = sum;
+        }
+    }
+
+    std::vector<node*> row_head_;
+    std::vector<node*> row_tail_;
+    std::vector<node*> col_head_;
+    std::vector<node*> col_tail_;
+    std::vector<std::size_t> row_size_;
+    std::deque<node> storage_;
+    node* free_ = nullptr;
+    std::size_t nonzeros_ = 0;
+
+    // CSR snapshot.
+    std::vector<bool> row_dirty_;
+    std::vector<std::size_t> dirty_rows_;
+    std::vector<std::size_t> row_ptr_;
+    std::vector<std::size_t> col_idx_;
+    std::vector<T> values_;
+    std::vector<std::size_t> spare_col_idx_;  // the previous snapshot, reused by the next shift
+    std::vector<T> spare_values_;
+    bool have_csr_;
+    csr_view view_;
+};
+
+} // namespace p_linked_list
+
+#endif
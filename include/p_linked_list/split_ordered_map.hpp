@@ -0,0 +1,401 @@
+// Lock-free hash map built on a split-ordered list (Shalev & Shavit).
+//
+// All items live in one Harris-Michael lock-free list sorted by the
+// bit-reversed hash.  Buckets are shortcuts into that list: each one points
+// at a sentinel node that is created lazily the first time the bucket is
+// touched, by splitting its parent bucket.  Growing the table only doubles
+// the bucket count, so nothing is ever rehashed or moved.
+//
+// Erased nodes are unlinked immediately and freed once no operation can
+// still be standing on them, using the two-epoch scheme of observer_list.
+// Every operation registers in the current epoch for its duration; the
+// reader counts are striped over cache lines so that registering does not
+// make all threads write one shared counter.  An unlinked node is retired
+// to the epoch current at that moment.  When enough nodes are pending, the
+// operation that finishes takes a reclaim mutex if it is free (never
+// waiting for it), frees the other epoch's nodes once that epoch's readers
+// have drained, and flips the epoch.  Memory therefore stays within the
+// live items plus a backlog, however many erases a map sees.  The backlog
+// is what gets erased while the slowest operation in flight finishes, so a
+// thread preempted inside an operation holds reclamation up until it runs.
+
+#ifndef P_LINKED_LIST_SPLIT_ORDERED_MAP_HPP
+#define P_LINKED_LIST_SPLIT_ORDERED_MAP_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace p_linked_list {
+
+template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class split_ordered_map {
+public:
+    explicit split_ordered_map(double max_load_factor = 2.0,
+                               const Hash& hash = Hash(), const KeyEqual& eq = KeyEqual())
+        : hash_(hash), eq_(eq), max_load_(max_load_factor) {
+        for (auto& s : segments_)
+            s.store(nullptr, std::memory_order_relaxed);
+        node* head = new node(0);
+        bucket_slot(0).store(head, std::memory_order_relaxed);
+    }
+
+    split_ordered_map(const split_ordered_map&) = delete;
+    split_ordered_map& operator=(const split_ordered_map&) = delete;
+
+    ~split_ordered_map() {
+        node* n = bucket_slot(0).load(std::memory_order_relaxed);
+        while (n) {
+            node* next = unmarked(n->next.load(std::memory_order_relaxed));
+            destroy(n);
+            n = next;
+        }
+        free_retired(retired_[0].load(std::memory_order_relaxed));
+        free_retired(retired_[1].load(std::memory_order_relaxed));
+        for (auto& s : segments_)
+            delete[] s.load(std::memory_order_relaxed);
+    }
+
+    // Inserts (key, value) unless the key is already present.
+    bool insert(const K& key, V value) {
+        reader_guard guard(*this);
+        const std::uint64_t h = hash_of(key);
+        const std::uint64_t so = regular_key(h);
+        node* head = bucket_head(h & (bucket_count_.load(std::memory_order_acquire) - 1));
+        auto* n = new data_node(so, key, std::move(value));
+        for (;;) {
+            position pos = find(head, so, &key);
+            if (pos.found) {
+                delete n;
+                return false;
+            }
+            n->next.store(reinterpret_cast<std::uintptr_t>(pos.cur), std::memory_order_relaxed);
+            std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(pos.cur);
+            if (pos.prev->compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(n),
+                                                  std::memory_order_acq_rel)) {
+                break;
+            }
+        }
+        const std::size_t count = size_.fetch_add(1, std::memory_order_relaxed) + 1;
+        std::size_t buckets = bucket_count_.load(std::memory_order_relaxed);
+        if (count > max_load_ * static_cast<double>(buckets) && buckets < max_buckets)
+            bucket_count_.compare_exchange_strong(buckets, buckets * 2, std::memory_order_acq_rel);
+        return true;
+    }
+
+    std::optional<V> find(const K& key) const {
+        auto* self = const_cast<split_ordered_map*>(this);
+        reader_guard guard(*self);
+        const std::uint64_t h = hash_of(key);
+        node* head = self->bucket_head(h & (bucket_count_.load(std::memory_order_acquire) - 1));
+        position pos = self->find(head, regular_key(h), &key);
+        if (!pos.found)
+            return std::nullopt;
+        return static_cast<data_node*>(pos.cur)->value;
+    }
+
+    bool contains(const K& key) const { return find(key).has_value(); }
+
+    bool erase(const K& key) {
+        reader_guard guard(*this);
+        const std::uint64_t h = hash_of(key);
+        const std::uint64_t so = regular_key(h);
+        node* head = bucket_head(h & (bucket_count_.load(std::memory_order_acquire) - 1));
+        for (;;) {
+            position pos = find(head, so, &key);
+            if (!pos.found)
+                return false;
+            std::uintptr_t next = pos.cur->next.load(std::memory_order_acquire);
+            if (next & 1)
+                continue;
+            if (!pos.cur->next.compare_exchange_strong(next, next | 1, std::memory_order_acq_rel))
+                continue;
+            size_.fetch_sub(1, std::memory_order_relaxed);
+            std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(pos.cur);
+            if (pos.prev->compare_exchange_strong(expected, next, std::memory_order_acq_rel))
+                retire(pos.cur);
+            else
+                find(head, so, &key);  // let the search snip it
+            return true;
+        }
+    }
+
+    std::size_t size() const noexcept { return size_.load(std::memory_order_relaxed); }
+    bool empty() const noexcept { return size() == 0; }
+    std::size_t bucket_count() const noexcept { return bucket_count_.load(std::memory_order_relaxed); }
+
+private:
+    struct node {
+        explicit node(std::uint64_t k) : so_key(k) {}
+        const std::uint64_t so_key;  // odd for items, even for bucket sentinels
+        std::atomic<std::uintptr_t> next{0};  // low bit marks the node deleted
+        node* retired_next = nullptr;
+    };
+
+    struct data_node : node {
+        data_node(std::uint64_t k, const K& key_, V value_)
+            : node(k), key(key_), value(std::move(value_)) {}
+        const K key;
+        V value;
+    };
+
+    struct position {
+        std::atomic<std::uintptr_t>* prev;
+        node* cur;
+        bool found;
+    };
+
+    // Registers the calling thread in the current epoch for the lifetime of
+    // one operation.
+    class reader_guard {
+    public:
+        explicit reader_guard(split_ordered_map& m) noexcept
+            : map_(m), stripe_(my_stripe()), epoch_(m.enter(stripe_)) {}
+        reader_guard(const reader_guard&) = delete;
+        reader_guard& operator=(const reader_guard&) = delete;
+        ~reader_guard() { map_.leave(stripe_, epoch_); }
+
+    private:
+        split_ordered_map& map_;
+        std::size_t stripe_;
+        unsigned epoch_;
+    };
+
+    struct alignas(64) reader_stripe {
+        std::atomic<std::int64_t> count[2] = {};
+    };
+
+    static constexpr std::size_t reader_stripes = 32;
+    static constexpr std::size_t reclaim_batch = 512;
+    static constexpr std::size_t first_segment = 64;
+    static constexpr std::size_t segment_count = 26;
+    static constexpr std::size_t max_buckets = first_segment << (segment_count - 1);
+
+    static node* unmarked(std::uintptr_t p) noexcept { return reinterpret_cast<node*>(p & ~std::uintptr_t(1)); }
+    static bool is_data(const node* n) noexcept { return n->so_key & 1; }
+
+    static std::uint64_t reverse_bits(std::uint64_t x) noexcept {
+        x = ((x >> 1) & 0x5555555555555555ull) | ((x & 0x5555555555555555ull) << 1);
+        x = ((x >> 2) & 0x3333333333333333ull) | ((x & 0x3333333333333333ull) << 2);
+        x = ((x >> 4) & 0x0f0f0f0f0f0f0f0full) | ((x & 0x0f0f0f0f0f0f0f0full) << 4);
+        x = ((x >> 8) & 0x00ff00ff00ff00ffull) | ((x & 0x00ff00ff00ff00ffull) << 8);
+        x = ((x >> 16) & 0x0000ffff0000ffffull) | ((x & 0x0000ffff0000ffffull) << 16);
+        return (x >> 32) | (x << 32);
+    }
+
+    static std::uint64_t regular_key(std::uint64_t h) noexcept { return reverse_bits(h | (1ull << 63)); }
+    static std::uint64_t sentinel_key(std::uint64_t bucket) noexcept { return reverse_bits(bucket); }
+
+    std::uint64_t hash_of(const K& key) const {
+        std::uint64_t x = static_cast<std::uint64_t>(hash_(key));
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        return x ^ (x >> 31);
+    }
+
+    static void destroy(node* n) {
+        if (is_data(n))
+            delete static_cast<data_node*>(n);
+        else
+            delete n;
+    }
+
+    static std::size_t free_retired(node* n) noexcept {
+        std::size_t freed = 0;
+        while (n) {
+            node* next = n->retired_next;
+            destroy(n);
+            n = next;
+            ++freed;
+        }
+        return freed;
+    }
+
+    static std::size_t my_stripe() noexcept {
+        static std::atomic<unsigned> next_slot{0};
+        thread_local unsigned slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+        return slot % reader_stripes;
+    }
+
+    // Registers in the current epoch, retrying if it flips in between so a
+    // reclaimer never misses a reader that can still see old nodes.
+    unsigned enter(std::size_t stripe) noexcept {
+        std::atomic<std::int64_t>* count = readers_[stripe].count;
+        for (;;) {
+            unsigned e = epoch_.load();
+            count[e].fetch_add(1);
+            if (epoch_.load() == e)
+                return e;
+            count[e].fetch_sub(1);
+        }
+    }
+
+    void leave(std::size_t stripe, unsigned e) noexcept {
+        readers_[stripe].count[e].fetch_sub(1, std::memory_order_release);
+        if (pending_.load(std::memory_order_relaxed) >= reclaim_batch) {
+            std::unique_lock<std::mutex> lock(reclaim_mutex_, std::try_to_lock);
+            if (lock.owns_lock())
+                reclaim_locked();
+        }
+    }
+
+    // Called by a registered thread right after it unlinked `n`, which goes
+    // on the list of the epoch read after the unlink, c.  A reader that can
+    // still reach `n` is registered in c or in c ^ 1.  Epoch c cannot flip
+    // away until c ^ 1 has drained, and its list is freed only once c has
+    // drained too.  While the caller is registered that list cannot be
+    // freed, so the push never races with reclamation.
+    void retire(node* n) noexcept {
+        std::atomic<node*>& list = retired_[epoch_.load()];
+        node* head = list.load(std::memory_order_relaxed);
+        do {
+            n->retired_next = head;
+        } while (!list.compare_exchange_weak(head, n, std::memory_order_release, std::memory_order_relaxed));
+        pending_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Nodes retired in the other epoch were unlinked before the flip to the
+    // current one; once that epoch's readers have drained nobody can reach
+    // them.  Flipping again is allowed only then, so at most two epochs are
+    // ever live.
+    void reclaim_locked() noexcept {
+        const unsigned e = epoch_.load(std::memory_order_relaxed);
+        const unsigned other = e ^ 1;
+        for (auto& r : readers_) {
+            if (r.count[other].load() != 0)
+                return;
+        }
+        pending_.fetch_sub(free_retired(retired_[other].exchange(nullptr, std::memory_order_acquire)),
+                           std::memory_order_relaxed);
+        if (retired_[e].load(std::memory_order_relaxed))
+            epoch_.store(other);
+    }
+
+    // Segment 0 holds buckets [0, 64); segment k holds [64 << (k-1), 64 << k).
+    std::atomic<node*>& bucket_slot(std::size_t bucket) {
+        std::size_t seg = 0, offset = bucket, size = first_segment;
+        if (bucket >= first_segment) {
+            std::size_t q = bucket / first_segment;
+            seg = 0;
+            while (q >>= 1)
+                ++seg;
+            ++seg;
+            size = first_segment << (seg - 1);
+            offset = bucket - size;
+        }
+        std::atomic<node*>* s = segments_[seg].load(std::memory_order_acquire);
+        if (!s) {
+            auto* fresh = new std::atomic<node*>[size];
+            for (std::size_t i = 0; i < size; ++i)
+                fresh[i].store(nullptr, std::memory_order_relaxed);
+            if (segments_[seg].compare_exchange_strong(s, fresh, std::memory_order_acq_rel))
+                s = fresh;
+            else
+                delete[] fresh;
+        }
+        return s[offset];
+    }
+
+    node* bucket_head(std::size_t bucket) {
+        std::atomic<node*>& slot = bucket_slot(bucket);
+        node* head = slot.load(std::memory_order_acquire);
+        if (head)
+            return head;
+        return initialize_bucket(bucket, slot);
+    }
+
+    // Inserts the sentinel for `bucket` after its parent's, which must exist
+    // first; the parent is the bucket with the top set bit cleared.
+    node* initialize_bucket(std::size_t bucket, std::atomic<node*>& slot) {
+        std::size_t parent = bucket;
+        for (std::size_t bit = std::size_t(1) << 62; bit; bit >>= 1) {
+            if (parent & bit) {
+                parent &= ~bit;
+                break;
+            }
+        }
+        node* parent_head = bucket_head(parent);
+        const std::uint64_t so = sentinel_key(bucket);
+        node* sentinel = new node(so);
+        for (;;) {
+            position pos = find(parent_head, so, nullptr);
+            if (pos.found) {
+                delete sentinel;
+                sentinel = pos.cur;
+                break;
+            }
+            sentinel->next.store(reinterpret_cast<std::uintptr_t>(pos.cur), std::memory_order_relaxed);
+            std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(pos.cur);
+            if (pos.prev->compare_exchange_strong(expected, reinterpret_cast<std::uintptr_t>(sentinel),
+                                                  std::memory_order_acq_rel)) {
+                break;
+            }
+        }
+        slot.store(sentinel, std::memory_order_release);
+        return sentinel;
+    }
+
+    // Searches from `head` for `so` (and `key` for item nodes), snipping out
+    // marked nodes on the way.  When not found, prev/cur is where a new node
+    // belongs: before the first node whose split-order key is >= `so`.
+    position find(node* head, std::uint64_t so, const K* key) {
+    retry:
+        std::atomic<std::uintptr_t>* prev = &head->next;
+        node* cur = unmarked(prev->load(std::memory_order_acquire));
+        std::atomic<std::uintptr_t>* ins_prev = nullptr;
+        node* ins_cur = nullptr;
+        while (cur) {
+            std::uintptr_t next = cur->next.load(std::memory_order_acquire);
+            if (next & 1) {
+                std::uintptr_t expected = reinterpret_cast<std::uintptr_t>(cur);
+                if (!prev->compare_exchange_strong(expected, next & ~std::uintptr_t(1),
+                                                   std::memory_order_acq_rel)) {
+                    goto retry;
+                }
+                retire(cur);
+                cur = unmarked(next);
+                continue;
+            }
+            if (cur->so_key > so)
+                break;
+            if (cur->so_key == so) {
+                if (!ins_prev) {
+                    ins_prev = prev;
+                    ins_cur = cur;
+                }
+                if (!key || eq_(static_cast<data_node*>(cur)->key, *key))
+                    return {prev, cur, true};
+            }
+            prev = &cur->next;
+            cur = unmarked(next);
+        }
+        if (ins_prev)
+            return {ins_prev, ins_cur, false};
+        return {prev, cur, false};
+    }
+
+    Hash hash_;
+    KeyEqual eq_;
+    double max_load_;
+    std::atomic<std::atomic<node*>*> segments_[segment_count];
+    std::atomic<std::size_t> bucket_count_{2};
+    std::atomic<std::size_t> size_{0};
+
+    // Reclamation state: epoch_ is read by every operation and written only
+    // by a flip, so it gets its own line, as does each reader stripe.
+    alignas(64) std::atomic<unsigned> epoch_{0};
+    reader_stripe readers_[reader_stripes];
+    alignas(64) std::atomic<node*> retired_[2] = {};
+    std::atomic<std::size_t> pending_{0};
+    std::mutex reclaim_mutex_;
+};
+
+} // namespace p_linked_list
+
+#endif
@@ -0,0 +1,224 @@
+// Sliding time window of events with incrementally maintained aggregates.
+//
+// Events are kept in a ring of time buckets, each bucket a linked chain of
+// nodes plus its own count and sum.  When the window moves past a bucket the
+// whole chain is spliced onto the free list and its count and sum are
+// subtracted from the totals, so expiry is O(1) per bucket regardless of how
+// many events it held.  Count, sum and mean are therefore O(1) to query.
+//
+// Min and max cannot be subtracted back out, so each keeps a monotonic deque
+// of (bucket, extreme) pairs; expiring a bucket pops at most one entry from
+// the front, and a new event pops dominated entries from the back.
+//
+// The window has bucket granularity: it covers the bucket containing the
+// newest time plus the preceding window / bucket_width - 1 buckets.  Event
+// times are expected to be non-decreasing; an older time is counted in the
+// newest bucket.
+
+#ifndef P_LINKED_LIST_TIME_WINDOW_HPP
+#define P_LINKED_LIST_TIME_WINDOW_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace p_linked_list {
+
+template <class T, class Clock = std::chrono::steady_clock>
+class time_window {
+public:
+    using time_point = typename Clock::time_point;
+    using duration = typename Clock::duration;
+
+    // Throws std::invalid_argument unless `window` and `bucket_width` are
+    // both positive.
+    time_window(duration window, duration bucket_width)
+        : width_(bucket_width),
+          buckets_(bucket_count(window, bucket_width)),
+          mins_(buckets_.size()),
+          maxs_(buckets_.size()) {}
+
+    time_window(const time_window&) = delete;
+    time_window& operator=(const time_window&) = delete;
+
+    ~time_window() {
+        for (auto& b : buckets_)
+            free_chain(b.head);
+        free_chain(free_);
+    }
+
+    void push(time_point t, T value) {
+        advance(t);
+        bucket& b = buckets_[ring_index(newest_)];
+        node* n = free_;
+        if (n)
+            free_ = n->next;
+        else
+            n = new node;
+        n->time = t;
+        n->value = value;
+        n->next = nullptr;
+        if (b.tail)
+            b.tail->next = n;
+        else
+            b.head = n;
+        b.tail = n;
+        ++b.count;
+        b.sum += value;
+        ++count_;
+        sum_ += value;
+        mins_.push(newest_, value, [](const T& x, const T& y) { return x <= y; });
+        maxs_.push(newest_, value, [](const T& x, const T& y) { return x >= y; });
+    }
+
+    // Moves the window so its newest bucket contains `now`, expiring every
+    // bucket that falls out.
+    void advance(time_point now) {
+        std::int64_t s = seq_of(now);
+        if (started_ && s <= newest_)
+            return;
+        if (!started_) {
+            started_ = true;
+            newest_ = s;
+            return;
+        }
+        const std::int64_t n = static_cast<std::int64_t>(buckets_.size());
+        // Buckets newest_-n+1 .. s-n leave; at most n of them hold anything.
+        std::int64_t first = newest_ - n + 1;
+        if (s - n - first + 1 > n)
+            first = s - 2 * n + 1;
+        for (std::int64_t q = first; q <= s - n; ++q)
+            expire(buckets_[ring_index(q)]);
+        newest_ = s;
+        mins_.expire_before(s - n + 1);
+        maxs_.expire_before(s - n + 1);
+    }
+
+    std::size_t count() const noexcept { return count_; }
+    T sum() const noexcept { return sum_; }
+    double mean() const noexcept {
+        return count_ ? static_cast<double>(sum_) / static_cast<double>(count_) : 0.0;
+    }
+    std::optional<T> min() const { return mins_.front(); }
+    std::optional<T> max() const { return maxs_.front(); }
+
+    // Calls f(time, value) for every live event, oldest first.
+    template <class F>
+    void for_each(F&& f) const {
+        if (!started_)
+            return;
+        const std::int64_t n = static_cast<std::int64_t>(buckets_.size());
+        for (std::int64_t q = newest_ - n + 1; q <= newest_; ++q) {
+            for (node* e = buckets_[ring_index(q)].head; e; e = e->next)
+                f(e->time, e->value);
+        }
+    }
+
+private:
+    static std::size_t bucket_count(duration window, duration bucket_width) {
+        if (!(bucket_width > duration::zero()))
+            throw std::invalid_argument("time_window: bucket width must be positive");
+        if (!(window > duration::zero()))
+            throw std::invalid_argument("time_window: window must be positive");
+        return static_cast<std::size_t>((window + bucket_width - duration(1)) / bucket_width);
+    }
+
+    struct node {
+        node* next;
+        time_point time;
+        T value;
+    };
+
+    struct bucket {
+        node* head = nullptr;
+        node* tail = nullptr;
+        std::size_t count = 0;
+        T sum{};
+    };
+
+    // Monotonic deque over buckets in a fixed ring; `keep(a, b)` is true when
+    // an older extreme a still matters next to a newer value b.
+    class extreme_deque {
+    public:
+        explicit extreme_deque(std::size_t buckets) : ring_(buckets + 1) {}
+
+        template <class Keep>
+        void push(std::int64_t seq, const T& value, Keep keep) {
+            while (size_ && !keep(back().value, value))
+                --size_;
+            if (size_ && back().seq == seq)
+                return;  // the newest bucket's extreme already dominates
+            ring_[(head_ + size_) % ring_.size()] = {seq, value};
+            ++size_;
+        }
+
+        void expire_before(std::int64_t seq) {
+            while (size_ && ring_[head_].seq < seq) {
+                head_ = (head_ + 1) % ring_.size();
+                --size_;
+            }
+        }
+
+        std::optional<T> front() const {
+            if (!size_)
+                return std::nullopt;
+            return ring_[head_].value;
+        }
+
+    private:
+        struct entry {
+            std::int64_t seq;
+            T value;
+        };
+
+        entry& back() { return ring_[(head_ + size_ - 1) % ring_.size()]; }
+
+        std::vector<entry> ring_;
+        std::size_t head_ = 0;
+        std::size_t size_ = 0;
+    };
+
+    std::int64_t seq_of(time_point t) const {
+        return static_cast<std::int64_t>(t.time_since_epoch() / width_);
+    }
+
+    std::size_t ring_index(std::int64_t seq) const {
+        const auto n = static_cast<std::int64_t>(buckets_.size());
+        return static_cast<std::size_t>(((seq % n) + n) % n);
+    }
+
+    void expire(bucket& b) {
+        if (b.head) {
+            b.tail->next = free_;
+            free_ = b.head;
+        }
+        count_ -= b.count;
+        sum_ -= b.sum;
+        b = bucket();
+    }
+
+    static void free_chain(node* n) {
+        while (n) {
+            node* next = n->next;
+            delete n;
+            n = next;
+        }
+    }
+
+    duration width_;
+    std::vector<bucket> buckets_;
+    node* free_ = nullptr;
+    bool started_ = false;
+    std::int64_t newest_ = 0;
+    std::size_t count_ = 0;
+    T sum_{};
+    extreme_deque mins_;
+    extreme_deque maxs_;
+};
+
+} // namespace p_linked_list
+
+#endif
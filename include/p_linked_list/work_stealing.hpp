@@ -0,0 +1,346 @@
+// Work-stealing task scheduler over linked block deques.
+//
+// Every worker owns a deque made of linked blocks of task slots.  The owner
+// pushes and pops at the bottom (LIFO, for locality), thieves take from the
+// top (FIFO, so they steal the oldest and usually largest work).  Tasks
+// submitted from outside the pool go to a shared injection queue.  Workers
+// that find nothing anywhere park on a condition variable and are woken by
+// the next push.
+//
+// Each deque is guarded by its own mutex, which the owner takes uncontended
+// except when a thief is stealing from it; this keeps growth by whole blocks
+// simple where a lock-free Chase-Lev deque would need resizing arrays.
+//
+// task_group provides fork-join: spawn() pushes to the calling worker's
+// deque and wait() runs other tasks until the group's tasks are done.
+
+#ifndef P_LINKED_LIST_WORK_STEALING_HPP
+#define P_LINKED_LIST_WORK_STEALING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace p_linked_list {
+
+// Deque of tasks stored in a doubly linked list of fixed-size blocks.
+class task_deque {
+public:
+    using task = std::function<void()>;
+
+    task_deque() {
+        top_block_ = bottom_block_ = new block;
+        top_ = bottom_ = block_size / 2;
+    }
+
+    task_deque(const task_deque&) = delete;
+    task_deque& operator=(const task_deque&) = delete;
+
+    ~task_deque() {
+        for (block* b = top_block_; b;) {
+            block* next = b->next;
+            delete b;
+            b = next;
+        }
+        delete spare_;
+    }
+
+    void push_bottom(task t) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (bottom_ == block_size) {
+            block* b = take_spare();
+            b->prev = bottom_block_;
+            bottom_block_->next = b;
+            bottom_block_ = b;
+            bottom_ = 0;
+        }
+        bottom_block_->slots[bottom_++] = std::move(t);
+        ++size_;
+    }
+
+    std::optional<task> pop_bottom() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (size_ == 0)
+            return std::nullopt;
+        if (bottom_ == 0) {
+            block* b = bottom_block_;
+            bottom_block_ = b->prev;
+            bottom_block_->next = nullptr;
+            give_spare(b);
+            bottom_ = block_size;
+        }
+        --size_;
+        task t = std::move(bottom_block_->slots[--bottom_]);
+        bottom_block_->slots[bottom_] = nullptr;
+        recenter();
+        return t;
+    }
+
+    std::optional<task> pop_top() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (size_ == 0)
+            return std::nullopt;
+        if (top_ == block_size) {
+            block* b = top_block_;
+            top_block_ = b->next;
+            top_block_->prev = nullptr;
+            give_spare(b);
+            top_ = 0;
+        }
+        --size_;
+        task t = std::move(top_block_->slots[top_]);
+        top_block_->slots[top_++] = nullptr;
+        recenter();
+        return t;
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return size_;
+    }
+
+private:
+    static constexpr std::size_t block_size = 128;
+
+    struct block {
+        block* prev = nullptr;
+        block* next = nullptr;
+        task slots[block_size];
+    };
+
+    block* take_spare() {
+        block* b = spare_ ? spare_ : new block;
+        spare_ = nullptr;
+        b->prev = b->next = nullptr;
+        return b;
+    }
+
+    void give_spare(block* b) {
+        if (spare_)
+            delete b;
+        else
+            spare_ = b;
+    }
+
+    // An emptied deque restarts mid-block so either end can grow in place.
+    void recenter() noexcept {
+        if (size_ == 0 && top_block_ == bottom_block_)
+            top_ = bottom_ = block_size / 2;
+    }
+
+    mutable std::mutex mutex_;
+    block* top_block_;
+    block* bottom_block_;
+    block* spare_ = nullptr;
+    std::size_t top_;     // index of the first task in top_block_
+    std::size_t bottom_;  // one past the last task in bottom_block_
+    std::size_t size_ = 0;
+};
+
+class work_stealing_pool {
+public:
+    using task = task_deque::task;
+
+    explicit work_stealing_pool(unsigned threads = std::thread::hardware_concurrency())
+        : workers_(std::max(1u, threads)) {
+        try {
+            for (unsigned i = 0; i < workers_.size(); ++i)
+                workers_[i].thread = std::thread([this, i] { run(i); });
+        } catch (...) {
+            // Stop and join the workers that did start; the rest were never
+            // launched.
+            shutdown();
+            throw;
+        }
+    }
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    // Finishes queued tasks, then joins the workers.
+    ~work_stealing_pool() { shutdown(); }
+
+    // Queues `t`: on the calling worker's own deque when called from inside
+    // the pool, otherwise on the injection queue.
+    void submit(task t) {
+        if (current_pool() == this)
+            workers_[current_index()].deque.push_bottom(std::move(t));
+        else
+            injection_.push_bottom(std::move(t));
+        pending_.fetch_add(1);
+        if (sleepers_.load() > 0) {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            park_cv_.notify_one();
+        }
+    }
+
+    // Runs one queued task on the calling thread if any can be found.
+    bool run_one() {
+        std::optional<task> t = find_task(current_pool() == this ? current_index() : workers_.size());
+        if (!t)
+            return false;
+        (*t)();
+        return true;
+    }
+
+    unsigned size() const noexcept { return static_cast<unsigned>(workers_.size()); }
+
+private:
+    struct worker {
+        task_deque deque;
+        std::thread thread;
+    };
+
+    void shutdown() noexcept {
+        {
+            std::lock_guard<std::mutex> lock(park_mutex_);
+            stop_ = true;
+        }
+        park_cv_.notify_all();
+        for (auto& w : workers_) {
+            if (w.thread.joinable())
+                w.thread.join();
+        }
+    }
+
+    static work_stealing_pool*& current_pool() {
+        thread_local work_stealing_pool* pool = nullptr;
+        return pool;
+    }
+
+    static std::size_t& current_index() {
+        thread_local std::size_t index = 0;
+        return index;
+    }
+
+    // Own deque first, then the injection queue, then a sweep of victims
+    // starting at a random one.  `self` == workers_.size() means an outside
+    // thread.
+    std::optional<task> find_task(std::size_t self) {
+        std::optional<task> t;
+        if (self < workers_.size())
+            t = workers_[self].deque.pop_bottom();
+        if (!t)
+            t = injection_.pop_top();
+        if (!t) {
+            thread_local std::uint64_t rng = reinterpret_cast<std::uintptr_t>(&rng) | 1;
+            rng ^= rng << 13;
+            rng ^= rng >> 7;
+            rng ^= rng << 17;
+            const std::size_t n = workers_.size();
+            for (std::size_t k = 0, start = rng % n; k < n && !t; ++k) {
+                std::size_t v = (start + k) % n;
+                if (v != self)
+                    t = workers_[v].deque.pop_top();
+            }
+        }
+        if (t)
+            pending_.fetch_sub(1);
+        return t;
+    }
+
+    void run(std::size_t index) {
+        current_pool() = this;
+        current_index() = index;
+        for (;;) {
+            if (std::optional<task> t = find_task(index)) {
+                (*t)();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(park_mutex_);
+            sleepers_.fetch_add(1);
+            park_cv_.wait(lock, [this] { return stop_ || pending_.load() > 0; });
+            sleepers_.fetch_sub(1);
+            if (stop_ && pending_.load() == 0)
+                return;
+        }
+    }
+
+    std::vector<worker> workers_;
+    task_deque injection_;
+    std::atomic<std::int64_t> pending_{0};
+    std::atomic<int> sleepers_{0};
+    std::mutex park_mutex_;
+    std::condition_variable park_cv_;
+    bool stop_ = false;
+};
+
+// Fork-join scope: spawn() tasks, then wait() for all of them while helping
+// to run queued work.  The first exception thrown by a task is rethrown by
+// wait().
+class task_group {
+public:
+    explicit task_group(work_stealing_pool& pool) : pool_(pool) {}
+
+    task_group(const task_group&) = delete;
+    task_group& operator=(const task_group&) = delete;
+
+    ~task_group() {
+        if (outstanding_.load() != 0) {
+            try {
+                wait();
+            } catch (...) {
+            }
+        }
+    }
+
+    template <class F>
+    void spawn(F&& f) {
+        outstanding_.fetch_add(1);
+        try {
+            pool_.submit([this, fn = std::forward<F>(f)]() mutable {
+                try {
+                    fn();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex_);
+                    if (!error_)
+                        error_ = std::current_exception();
+                }
+                outstanding_.fetch_sub(1, std::memory_order_release);
+            });
+        } catch (...) {
+            // The task was never queued, so wait() must not count on it.
+            outstanding_.fetch_sub(1, std::memory_order_release);
+            throw;
+        }
+    }
+
+    void wait() {
+        while (outstanding_.load(std::memory_order_acquire) != 0) {
+            if (!pool_.run_one())
+                std::this_thread::yield();
+        }
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (error_)
+            std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+private:
+    work_stealing_pool& pool_;
+    std::atomic<std::size_t> outstanding_{0};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+// Runs f and g in parallel on `pool` and returns when both are done.
+template <class F, class G>
+void parallel_invoke(work_stealing_pool& pool, F&& f, G&& g) {
+    task_group group(pool);
+    group.spawn(std::forward<G>(g));
+    f();
+    group.wait();
+}
+
+} // namespace p_linked_list
+
+#endif
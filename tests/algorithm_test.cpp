@@ -0,0 +1,136 @@
+#include <p_linked_list/algorithm.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+void test_partition() {
+    std::list<int> l{1, 2, 3, 4, 5, 6, 7};
+    std::vector<const int*> addresses;
+    for (const int& x : l)
+        addresses.push_back(&x);
+    auto b = pl::stable_partition(l, [](int x) { return x % 2; });
+    CHECK(l == std::list<int>{1, 3, 5, 7, 2, 4, 6});
+    CHECK(*b == 2);
+    // Relinked, not copied: element 2 is still the same object.
+    CHECK(&*b == addresses[1]);
+
+    std::list<int> all{1, 3};
+    CHECK(pl::partition(all, [](int x) { return x % 2; }) == all.end());
+    std::list<int> empty;
+    CHECK(pl::stable_partition(empty, [](int) { return true; }) == empty.end());
+}
+
+void test_rotate_reverse() {
+    std::list<int> l{1, 2, 3, 4, 5};
+    pl::rotate(l, std::next(l.begin(), 2));
+    CHECK(l == std::list<int>{3, 4, 5, 1, 2});
+    pl::rotate(l, l.begin());
+    CHECK(l == std::list<int>{3, 4, 5, 1, 2});
+    pl::reverse(l);
+    CHECK(l == std::list<int>{2, 1, 5, 4, 3});
+    std::list<int> empty;
+    pl::reverse(empty);
+    CHECK(empty.empty());
+}
+
+void test_unique_remove_if() {
+    std::list<int> u{1, 1, 2, 2, 2, 3, 1}, removed;
+    CHECK(pl::unique(u, removed) == 3);
+    CHECK(u == std::list<int>{1, 2, 3, 1});
+    CHECK(removed == std::list<int>{1, 2, 2});
+    CHECK(pl::remove_if(u, removed, [](int x) { return x == 1; }) == 2);
+    CHECK(u == std::list<int>{2, 3});
+    CHECK(removed.size() == 5);
+
+    std::list<int> v{1, 2, 4, 7, 8};
+    std::list<int> r;
+    CHECK(pl::unique(v, r, [](int a, int b) { return b - a == 1; }) == 2);
+    CHECK(v == std::list<int>{1, 4, 7});
+}
+
+void check_nth(const std::list<int>& l, std::list<int>::const_iterator it, std::size_t k,
+               const std::vector<int>& sorted) {
+    CHECK(*it == sorted[k]);
+    CHECK(static_cast<std::size_t>(std::distance(l.begin(), it)) == k);
+    for (auto i = l.begin(); i != it; ++i)
+        CHECK(*i <= *it);
+    for (auto i = it; i != l.end(); ++i)
+        CHECK(*i >= *it);
+}
+
+void test_nth_element() {
+    std::mt19937 rng(1);
+    for (int trial = 0; trial < 200; ++trial) {
+        const std::size_t n = rng() % 50 + 1;
+        std::list<int> l;
+        std::vector<int> v;
+        for (std::size_t i = 0; i < n; ++i) {
+            int x = static_cast<int>(rng() % 10);
+            l.push_back(x);
+            v.push_back(x);
+        }
+        std::sort(v.begin(), v.end());
+        const std::size_t k = rng() % n;
+        auto it = pl::nth_element(l, k);
+        CHECK(l.size() == n);
+        check_nth(l, it, k, v);
+    }
+    std::list<int> small{3, 1, 2};
+    CHECK(pl::nth_element(small, 3) == small.end());
+    CHECK(*pl::nth_element(small, 0, std::greater<>()) == 3);
+}
+
+void test_nth_element_pmr() {
+    std::pmr::monotonic_buffer_resource mr;
+    std::pmr::list<int> l(&mr);
+    std::vector<int> v;
+    for (int i = 0; i < 1000; ++i) {
+        l.push_back((i * 7919) % 1000);
+        v.push_back((i * 7919) % 1000);
+    }
+    std::sort(v.begin(), v.end());
+    auto it = pl::nth_element(l, 500);
+    CHECK(*it == v[500]);
+    CHECK(l.size() == 1000);
+    CHECK(l.get_allocator().resource() == &mr);
+}
+
+void test_nth_element_throwing_compare() {
+    std::list<int> l;
+    for (int i = 0; i < 1000; ++i)
+        l.push_back((i * 7919) % 1000);
+    int calls = 0;
+    CHECK_THROWS(std::runtime_error, pl::nth_element(l, 10, [&](int a, int b) {
+        if (++calls == 1500)
+            throw std::runtime_error("compare");
+        return a < b;
+    }));
+    CHECK(l.size() == 1000);
+    std::vector<int> v(l.begin(), l.end());
+    std::sort(v.begin(), v.end());
+    for (int i = 0; i < 1000; ++i)
+        CHECK(v[static_cast<std::size_t>(i)] == i);
+}
+
+} // namespace
+
+int main() {
+    test_partition();
+    test_rotate_reverse();
+    test_unique_remove_if();
+    test_nth_element();
+    test_nth_element_pmr();
+    test_nth_element_throwing_compare();
+    return check::exit_code();
+}
@@ -0,0 +1,107 @@
+#include <p_linked_list/blob_list.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// Counts live allocations so tests can see one allocation per element.
+class counting_resource : public std::pmr::memory_resource {
+public:
+    std::size_t live = 0;
+    std::size_t total = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        ++live;
+        ++total;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        --live;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+};
+
+void test_strings() {
+    pl::blob_list l;
+    l.push_back("hello");
+    l.push_front("a");
+    l.push_back(std::string(1000, 'z'));
+    l.push_back("");
+    CHECK(l.size() == 4);
+    CHECK(l.front() == "a");
+    CHECK(l.back().empty());
+
+    auto it = std::next(l.begin());
+    CHECK(*it == "hello");
+    CHECK(it.size() == 5);
+    it = l.erase(it);
+    CHECK((*it).size() == 1000);
+    CHECK(*std::prev(it) == "a");
+
+    l.pop_back();
+    l.pop_front();
+    CHECK(l.size() == 1);
+    CHECK(l.front() == std::string(1000, 'z'));
+}
+
+void test_bytes_and_uninitialized() {
+    pl::blob_list l;
+    const std::vector<std::byte> blob{std::byte{0}, std::byte{1}, std::byte{255}};
+    l.push_back(std::span<const std::byte>(blob));
+    CHECK(l.begin().size() == 3);
+    CHECK(l.begin().bytes()[2] == std::byte{255});
+
+    auto u = l.insert_uninitialized(l.begin(), 3);
+    auto b = u.bytes();
+    b[0] = std::byte{'x'};
+    b[1] = std::byte{'y'};
+    b[2] = std::byte{'z'};
+    CHECK(*u == "xyz");
+    CHECK(*l.begin() == "xyz");
+
+    // Embedded NULs are ordinary bytes.
+    l.push_back(std::string_view("a\0b", 3));
+    CHECK(l.back().size() == 3);
+    CHECK(l.back()[1] == '\0');
+}
+
+void test_one_allocation_per_element() {
+    counting_resource mr;
+    {
+        pl::blob_list l(&mr);
+        for (int i = 0; i < 100; ++i)
+            l.push_back(std::string(static_cast<std::size_t>(i) * 10, 'q'));
+        CHECK(mr.total == 100);
+        CHECK(mr.live == 100);
+        l.erase(l.begin());
+        CHECK(mr.live == 99);
+        std::size_t bytes = 0;
+        for (auto s : l)
+            bytes += s.size();
+        CHECK(bytes == 10 * (99 * 100 / 2));
+        l.clear();
+        CHECK(l.empty());
+        CHECK(mr.live == 0);
+        l.push_back("x");
+    }
+    CHECK(mr.live == 0);
+}
+
+} // namespace
+
+int main() {
+    test_strings();
+    test_bytes_and_uninitialized();
+    test_one_allocation_per_element();
+    return check::exit_code();
+}
@@ -0,0 +1,164 @@
+#include <p_linked_list/broadcast_log.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// Counts live instances so the tests can see segments being reclaimed.
+struct counted {
+    static inline std::atomic<int> live{0};
+    int value;
+    explicit counted(int v) : value(v) { ++live; }
+    counted(const counted& o) : value(o.value) { ++live; }
+    ~counted() { --live; }
+};
+
+void test_cursors_read_in_order() {
+    pl::broadcast_log<int, 4> log;
+    auto early = log.subscribe();
+    CHECK(!early->next());
+    for (int i = 0; i < 10; ++i)
+        log.push(i);
+    auto late = log.subscribe();
+    auto oldest = log.subscribe(true);
+    CHECK(late->position() == 10 && !late->next());
+    CHECK(oldest->position() == 0);
+    for (int i = 0; i < 10; ++i) {
+        const int* a = early->next();
+        const int* b = oldest->next();
+        CHECK(a && b && *a == i && *b == i);
+    }
+    CHECK(!early->next() && !oldest->next());
+    log.push(10);
+    CHECK(*late->next() == 10 && *early->next() == 10);
+    CHECK(log.published() == 11);
+}
+
+void test_reclamation_follows_slowest_cursor() {
+    counted::live = 0;
+    {
+        pl::broadcast_log<counted, 8> log;
+        auto fast = log.subscribe();
+        auto slow = log.subscribe();
+        for (int i = 0; i < 64; ++i) {
+            log.emplace(i);
+            fast->next();
+        }
+        // The slow cursor holds everything.
+        CHECK(counted::live == 64);
+        for (int i = 0; i < 20; ++i)
+            CHECK(slow->next()->value == i);
+        log.reclaim();
+        // Segments [0, 8) and [8, 16) are behind both cursors.
+        CHECK(counted::live == 48);
+        slow.reset();
+        log.reclaim();
+        // Only the segment the fast cursor last read from is kept.
+        CHECK(counted::live == 8);
+        auto from_oldest = log.subscribe(true);
+        CHECK(from_oldest->position() == 56);
+        CHECK(from_oldest->next()->value == 56);
+        fast.reset();
+        from_oldest.reset();
+        for (int i = 64; i < 100; ++i)
+            log.emplace(i);
+        // With no cursors the writer frees segments as it goes.
+        CHECK(counted::live <= 16);
+    }
+    CHECK(counted::live == 0);
+}
+
+void test_non_trivial_items() {
+    pl::broadcast_log<std::string, 3> log;
+    auto c = log.subscribe();
+    for (int i = 0; i < 10; ++i)
+        log.push(std::string(100, static_cast<char>('a' + i)));
+    for (int i = 0; i < 7; ++i)
+        CHECK(*c->next() == std::string(100, static_cast<char>('a' + i)));
+    // The log destroys what is left.
+}
+
+void test_close_wakes_waiting_readers() {
+    pl::broadcast_log<int, 16> log;
+    auto c = log.subscribe();
+    std::jthread reader([&] {
+        int n = 0;
+        while (const int* v = c->wait_next())
+            CHECK(*v == n++);
+        CHECK(n == 3);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    log.push(0);
+    log.push(1);
+    log.push(2);
+    log.close();
+}
+
+// One writer, several readers that each see every item in order, plus
+// readers that come and go.
+void test_concurrent_fan_out() {
+    constexpr int items = 200000;
+    pl::broadcast_log<std::uint64_t, 256> log;
+    std::vector<std::unique_ptr<pl::broadcast_log<std::uint64_t, 256>::cursor>> cursors;
+    for (int r = 0; r < 4; ++r)
+        cursors.push_back(log.subscribe());
+    std::atomic<bool> ok{true};
+    std::atomic<bool> done{false};
+    {
+        std::vector<std::jthread> threads;
+        for (int r = 0; r < 4; ++r) {
+            threads.emplace_back([&, r] {
+                std::uint64_t expect = 0;
+                while (const std::uint64_t* v = cursors[r]->wait_next()) {
+                    if (*v != expect++)
+                        ok.store(false);
+                }
+                if (expect != items)
+                    ok.store(false);
+            });
+        }
+        threads.emplace_back([&] {
+            while (!done.load()) {
+                auto c = log.subscribe();
+                std::uint64_t last = 0;
+                bool first = true;
+                for (int i = 0; i < 100; ++i) {
+                    if (const std::uint64_t* v = c->next()) {
+                        if (!first && *v != last + 1)
+                            ok.store(false);
+                        last = *v;
+                        first = false;
+                    }
+                }
+            }
+        });
+        for (std::uint64_t i = 0; i < items; ++i)
+            log.push(i);
+        log.close();
+        for (int r = 0; r < 4; ++r)
+            threads[static_cast<std::size_t>(r)].join();
+        done.store(true);
+    }
+    CHECK(ok.load());
+}
+
+} // namespace
+
+int main() {
+    test_cursors_read_in_order();
+    test_reclamation_follows_slowest_cursor();
+    test_non_trivial_items();
+    test_close_wakes_waiting_readers();
+    test_concurrent_fan_out();
+    return check::exit_code();
+}
@@ -0,0 +1,188 @@
+#include <p_linked_list/buffer_chain.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+pl::buffer_chain chain_of(std::string_view s) {
+    pl::buffer_chain c;
+    c.append(s);
+    return c;
+}
+
+std::vector<std::string> slices(const pl::buffer_chain& c) {
+    std::vector<std::string> out;
+    c.for_each_slice([&](std::string_view s) { out.emplace_back(s); });
+    return out;
+}
+
+std::string pattern(std::size_t n) {
+    std::string s(n, '\0');
+    for (std::size_t i = 0; i < n; ++i)
+        s[i] = static_cast<char>('a' + i * 7 % 26);
+    return s;
+}
+
+void test_append_and_gather() {
+    pl::buffer_chain c;
+    CHECK(c.empty() && c.slice_count() == 0 && c.coalesce().empty());
+    c.append("hello");
+    c.append(", ");
+    c.append("world");
+    CHECK(c.size() == 12 && c.slice_count() == 1);
+    CHECK(c.to_string() == "hello, world");
+    char buf[8] = {};
+    CHECK(c.copy_to(buf, 5, 7) == 5);
+    CHECK(std::string_view(buf, 5) == "world");
+    CHECK(c.copy_to(buf, 8, 10) == 2);
+
+    const std::string big = pattern(3 * pl::buffer_chain::default_buffer_size + 100);
+    pl::buffer_chain d;
+    for (std::size_t i = 0; i < big.size(); i += 1000)
+        d.append(std::string_view(big).substr(i, 1000));
+    CHECK(d.size() == big.size() && d.slice_count() == 4);
+    CHECK(d.to_string() == big);
+    CHECK(d.coalesce() == big);
+    CHECK(d.slice_count() == 1);
+}
+
+void test_splice_split_and_sharing() {
+    pl::buffer_chain c = chain_of("middle");
+    c.append(chain_of("-end"));
+    c.prepend(chain_of("start-"));
+    CHECK(c.to_string() == "start-middle-end");
+    CHECK((slices(c) == std::vector<std::string>{"start-", "middle", "-end"}));
+
+    pl::buffer_chain front = c.split(8);
+    CHECK(front.to_string() == "start-mi");
+    CHECK(c.to_string() == "ddle-end");
+    CHECK((slices(front) == std::vector<std::string>{"start-", "mi"}));
+    CHECK(front.slice_count() == 2 && c.slice_count() == 2);
+
+    // "mi" shares its buffer with "ddle", so appending must not write into
+    // the bytes that follow it.
+    front.append("XX");
+    CHECK(front.to_string() == "start-miXX");
+    CHECK(c.to_string() == "ddle-end");
+
+    pl::buffer_chain copy = c.clone();
+    copy.trim_front(5);
+    copy.append("!");
+    CHECK(copy.to_string() == "end!");
+    CHECK(c.to_string() == "ddle-end");
+
+    CHECK(c.split(100).to_string() == "ddle-end");
+    CHECK(c.empty() && c.slice_count() == 0);
+    CHECK(c.split(3).empty());
+
+    pl::buffer_chain moved = std::move(front);
+    CHECK(front.empty() && moved.to_string() == "start-miXX");
+    front = std::move(moved);
+    CHECK(front.to_string() == "start-miXX");
+    front.append(std::move(front));
+    CHECK(front.to_string() == "start-miXX");
+    front.trim_front(7);
+    CHECK(front.to_string() == "iXX");
+    front.clear();
+    CHECK(front.empty());
+}
+
+void test_pipe_round_trip() {
+    int fds[2];
+    CHECK(::pipe(fds) == 0);
+    // Many small slices, more than one writev batch.
+    pl::buffer_chain out;
+    std::string expect;
+    for (int i = 0; i < 300; ++i) {
+        std::string piece = std::to_string(i) + ";";
+        out.append(chain_of(piece));
+        expect += piece;
+    }
+    CHECK(out.slice_count() == 300);
+    std::thread writer([&] {
+        while (!out.empty()) {
+            if (out.write_to(fds[1]) < 0)
+                break;
+        }
+        ::close(fds[1]);
+    });
+    pl::buffer_chain in;
+    ssize_t r;
+    while ((r = in.read_from(fds[0], 100)) > 0) {
+    }
+    writer.join();
+    CHECK(r == 0);
+    CHECK(out.empty());
+    CHECK(in.to_string() == expect);
+    ::close(fds[0]);
+}
+
+void test_partial_writes() {
+    int fds[2];
+    CHECK(::pipe(fds) == 0);
+    ::fcntl(fds[1], F_SETFL, O_NONBLOCK);
+    const std::string big = pattern(1 << 20);
+    pl::buffer_chain out = chain_of(big);
+    const ssize_t w = out.write_to(fds[1]);
+    CHECK(w > 0 && static_cast<std::size_t>(w) < big.size());
+    CHECK(out.size() == big.size() - static_cast<std::size_t>(w));
+    // Nothing more fits: -1 with EAGAIN and nothing consumed.
+    const std::size_t left = out.size();
+    errno = 0;
+    CHECK(out.write_to(fds[1]) == -1 && errno == EAGAIN);
+    CHECK(out.size() == left);
+
+    pl::buffer_chain in;
+    std::thread reader([&] {
+        while (in.read_from(fds[0], 1 << 16) > 0) {
+        }
+    });
+    ::fcntl(fds[1], F_SETFL, 0);
+    while (!out.empty()) {
+        if (out.write_to(fds[1]) < 0)
+            break;
+    }
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+    CHECK(in.to_string() == big);
+}
+
+void test_read_errors() {
+    int fds[2];
+    CHECK(::pipe(fds) == 0);
+    pl::buffer_chain c = chain_of("abc");
+    errno = 0;
+    CHECK(c.read_from(fds[0], 0) == -1 && errno == EINVAL);
+    CHECK(c.size() == 3);
+    ::close(fds[1]);
+    CHECK(c.read_from(fds[0]) == 0);
+    ::close(fds[0]);
+    errno = 0;
+    CHECK(c.read_from(fds[0]) == -1 && errno == EBADF);
+    CHECK(c.write_to(fds[1]) == -1);
+    CHECK(c.to_string() == "abc");
+}
+
+} // namespace
+
+int main() {
+    test_append_and_gather();
+    test_splice_split_and_sharing();
+    test_pipe_round_trip();
+    test_partial_writes();
+    test_read_errors();
+    return check::exit_code();
+}
@@ -0,0 +1,133 @@
+#include <p_linked_list/bulk_load.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+int to_int(std::string_view s) {
+    int v = 0;
+    std::from_chars(s.data(), s.data() + s.size(), v);
+    return v;
+}
+
+std::string numbers(int n, char delim) {
+    std::string out;
+    for (int i = 0; i < n; ++i) {
+        out += std::to_string(i);
+        out += delim;
+    }
+    return out;
+}
+
+bool in_order(const std::pmr::list<int>& l, int n) {
+    if (l.size() != static_cast<std::size_t>(n))
+        return false;
+    int expect = 0;
+    for (int x : l) {
+        if (x != expect++)
+            return false;
+    }
+    return true;
+}
+
+void test_order_across_thread_counts() {
+    std::pmr::synchronized_pool_resource pool;
+    const std::string data = numbers(200000, '\n');
+    for (unsigned threads : {1u, 2u, 3u, 7u, 16u, 64u}) {
+        auto l = pl::load_delimited<int>(data, to_int, &pool, {threads, '\n'});
+        CHECK(in_order(l, 200000));
+    }
+    // Without the final delimiter the last record is still loaded.
+    auto l = pl::load_delimited<int>(std::string_view(data).substr(0, data.size() - 1), to_int, &pool, {4, '\n'});
+    CHECK(in_order(l, 200000));
+}
+
+void test_small_and_empty_inputs() {
+    std::pmr::synchronized_pool_resource pool;
+    CHECK(pl::load_delimited<int>("", to_int, &pool, {8, '\n'}).empty());
+    auto one = pl::load_delimited<int>("42", to_int, &pool, {8, '\n'});
+    CHECK(one.size() == 1 && one.front() == 42);
+    auto empties = pl::load_delimited<std::string>(
+        "a,,b,", [](std::string_view s) { return std::string(s); }, &pool, {2, ','});
+    CHECK((std::vector<std::string>(empties.begin(), empties.end()) == std::vector<std::string>{"a", "", "b"}));
+}
+
+void test_optional_skips_records() {
+    std::pmr::synchronized_pool_resource pool;
+    const std::string data = numbers(100000, ';');
+    auto evens = pl::load_delimited<int>(
+        data,
+        [](std::string_view s) -> std::optional<int> {
+            int v = to_int(s);
+            if (v % 2)
+                return std::nullopt;
+            return v;
+        },
+        &pool, {5, ';'});
+    CHECK(evens.size() == 50000);
+    int expect = 0;
+    bool ok = true;
+    for (int x : evens) {
+        ok = ok && x == expect;
+        expect += 2;
+    }
+    CHECK(ok);
+}
+
+void test_parse_errors_propagate() {
+    std::pmr::synchronized_pool_resource pool;
+    const std::string data = numbers(100000, '\n');
+    auto parse = [](std::string_view s) {
+        if (s == "77777")
+            throw std::runtime_error("bad record");
+        return to_int(s);
+    };
+    for (unsigned threads : {1u, 4u})
+        CHECK_THROWS(std::runtime_error, pl::load_delimited<int>(data, parse, &pool, {threads, '\n'}));
+}
+
+void test_files() {
+    std::pmr::synchronized_pool_resource pool;
+    char path[] = "/tmp/p_linked_list_bulk_load_XXXXXX";
+    int fd = ::mkstemp(path);
+    CHECK(fd >= 0);
+    if (fd < 0)
+        return;
+    const std::string data = numbers(300000, '\n');
+    CHECK(::write(fd, data.data(), data.size()) == static_cast<ssize_t>(data.size()));
+    ::close(fd);
+    CHECK(in_order(pl::load_delimited_file<int>(path, to_int, &pool, {4, '\n'}), 300000));
+
+    fd = ::open(path, O_WRONLY | O_TRUNC);
+    ::close(fd);
+    CHECK(pl::load_delimited_file<int>(path, to_int, &pool).empty());
+    ::unlink(path);
+    CHECK_THROWS(std::system_error, pl::load_delimited_file<int>(path, to_int, &pool));
+}
+
+} // namespace
+
+int main() {
+    test_order_across_thread_counts();
+    test_small_and_empty_inputs();
+    test_optional_skips_records();
+    test_parse_errors_propagate();
+    test_files();
+    return check::exit_code();
+}
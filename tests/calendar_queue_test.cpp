@@ -0,0 +1,170 @@
+#include <p_linked_list/calendar_queue.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// Reference: ordered by (time, insertion number).
+using model = std::map<std::pair<double, std::uint64_t>, int>;
+
+// Hold model: pop the earliest event and schedule a new one `increment()`
+// later, checking every pop against the reference.
+void hold(pl::calendar_queue<int>& q, model& m, std::uint64_t& seq, int ops,
+          const std::function<double()>& increment) {
+    for (int i = 0; i < ops; ++i) {
+        auto [t, v] = q.pop();
+        auto first = m.begin();
+        CHECK(t == first->first.first && v == first->second);
+        m.erase(first);
+        const double next = t + increment();
+        q.push(next, v);
+        m.emplace(std::make_pair(next, seq++), v);
+    }
+    CHECK(q.size() == m.size());
+}
+
+void test_hold_distributions() {
+    std::mt19937_64 rng(4);
+    std::exponential_distribution<double> expo(1.0);
+    std::uniform_real_distribution<double> uni(0.0, 2.0);
+    const std::vector<std::function<double()>> increments = {
+        [&] { return expo(rng); },
+        [&] { return uni(rng); },
+        [&] { return rng() % 10 ? uni(rng) * 0.01 : uni(rng) * 100; },  // bimodal
+        [&] { return static_cast<double>(rng() % 3); },                 // many ties
+    };
+    for (std::size_t size : {1u, 10u, 1000u, 5000u}) {
+        for (auto& inc : increments) {
+            pl::calendar_queue<int> q;
+            model m;
+            std::uint64_t seq = 0;
+            for (std::size_t i = 0; i < size; ++i) {
+                const double t = inc();
+                q.push(t, static_cast<int>(i));
+                m.emplace(std::make_pair(t, seq++), static_cast<int>(i));
+            }
+            hold(q, m, seq, 10000, inc);
+        }
+    }
+}
+
+void test_growth_shrink_and_density_change() {
+    std::mt19937_64 rng(5);
+    pl::calendar_queue<int> q;
+    model m;
+    std::uint64_t seq = 0;
+    double now = 0;
+    // Grow to 50000 events spaced about 1 apart.
+    for (int i = 0; i < 50000; ++i) {
+        const double t = now + static_cast<double>(rng() % 50000);
+        q.push(t, i);
+        m.emplace(std::make_pair(t, seq++), i);
+    }
+    CHECK(q.bucket_count() >= 16384);
+    const double wide = q.bucket_width();
+    // Events now arrive 1000 times denser; the width must follow.
+    std::uniform_real_distribution<double> dense(0.0, 0.05);
+    for (int i = 0; i < 50000; ++i) {
+        auto [t, v] = q.pop();
+        CHECK(t == m.begin()->first.first && v == m.begin()->second);
+        m.erase(m.begin());
+        now = t;
+        const double next = now + dense(rng);
+        q.push(next, v);
+        m.emplace(std::make_pair(next, seq++), v);
+    }
+    CHECK(q.bucket_width() < wide / 10);
+    // Drain: the bucket array shrinks back.
+    while (!q.empty()) {
+        auto [t, v] = q.pop();
+        CHECK(t == m.begin()->first.first && v == m.begin()->second);
+        m.erase(m.begin());
+    }
+    CHECK(m.empty());
+    CHECK(q.bucket_count() <= 4);
+}
+
+void test_equal_times_fifo() {
+    pl::calendar_queue<int> q(0.5);
+    for (int i = 0; i < 1000; ++i)
+        q.push(static_cast<double>(i % 4), i);
+    int last_time = -1, last_value = -1;
+    while (!q.empty()) {
+        auto [t, v] = q.pop();
+        const int ti = static_cast<int>(t);
+        CHECK(ti > last_time || (ti == last_time && v > last_value));
+        CHECK(v % 4 == ti);
+        last_time = ti;
+        last_value = v;
+    }
+}
+
+void test_negative_and_sparse_times() {
+    pl::calendar_queue<std::string> q;
+    q.push(5.0, "five");
+    q.push(-3.5, "minus three and a half");
+    q.push(-1e6, "minus a million");
+    q.push(1e9, "a billion");
+    q.push(0.0, "zero");
+    CHECK(q.pop().second == "minus a million");
+    CHECK(q.pop().second == "minus three and a half");
+    // Pushing at or after the last dequeued time is allowed, negative too.
+    q.push(-3.5, "again");
+    CHECK(q.pop().second == "again");
+    CHECK(q.pop().second == "zero");
+    CHECK(q.pop().second == "five");
+    CHECK(q.pop() == std::make_pair(1e9, std::string("a billion")));
+    CHECK(q.empty());
+}
+
+void test_negative_hold() {
+    std::mt19937_64 rng(6);
+    std::exponential_distribution<double> expo(0.1);
+    pl::calendar_queue<int> q;
+    model m;
+    std::uint64_t seq = 0;
+    for (int i = 0; i < 5000; ++i) {
+        const double t = -1e5 + expo(rng) * 100;
+        q.push(t, i);
+        m.emplace(std::make_pair(t, seq++), i);
+    }
+    hold(q, m, seq, 50000, [&] { return expo(rng); });
+}
+
+void test_move_only_values() {
+    pl::calendar_queue<std::unique_ptr<int>> q;
+    for (int i = 9; i >= 0; --i)
+        q.push(i, std::make_unique<int>(i));
+    for (int i = 0; i < 10; ++i) {
+        auto [t, p] = q.pop();
+        CHECK(t == i && *p == i);
+        // Recycled nodes take the next value.
+        if (i < 5)
+            q.push(10 + i, std::make_unique<int>(10 + i));
+    }
+    for (int i = 10; i < 15; ++i)
+        CHECK(*q.pop().second == i);
+}
+
+} // namespace
+
+int main() {
+    test_hold_distributions();
+    test_growth_shrink_and_density_change();
+    test_equal_times_fifo();
+    test_negative_and_sparse_times();
+    test_negative_hold();
+    test_move_only_values();
+    return check::exit_code();
+}
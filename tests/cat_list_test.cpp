@@ -0,0 +1,124 @@
+#include <p_linked_list/cat_list.hpp>
+
+#include <deque>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+using list = pl::cat_list<int>;
+
+std::vector<int> items(const list& l) {
+    std::vector<int> out;
+    l.for_each([&](int x) { out.push_back(x); });
+    return out;
+}
+
+void test_against_deque() {
+    std::mt19937 rng(3);
+    for (int trial = 0; trial < 300; ++trial) {
+        list l;
+        std::deque<int> d;
+        for (int i = 0; i < 200; ++i) {
+            const int op = static_cast<int>(rng() % 4);
+            const int x = static_cast<int>(rng() % 1000);
+            if (op == 0) {
+                l = l.push_back(x);
+                d.push_back(x);
+            } else if (op == 1) {
+                l = l.push_front(x);
+                d.push_front(x);
+            } else if (op == 2 && !d.empty()) {
+                CHECK(l.front() == d.front());
+                l = l.pop_front();
+                d.pop_front();
+            } else {
+                list other;
+                std::deque<int> od;
+                for (int j = 0; j < 3; ++j) {
+                    other = other.push_back(j);
+                    od.push_back(j);
+                }
+                if (rng() % 2) {
+                    l = l + other;
+                    d.insert(d.end(), od.begin(), od.end());
+                } else {
+                    l = concat(other, l);
+                    d.insert(d.begin(), od.begin(), od.end());
+                }
+            }
+            CHECK(l.size() == d.size());
+        }
+        CHECK(items(l) == std::vector<int>(d.begin(), d.end()));
+    }
+}
+
+void test_persistence() {
+    list a;
+    for (int i = 0; i < 5; ++i)
+        a = a.push_back(i);
+    const list b = a + a;
+    const list c = b.pop_front();
+    CHECK(items(a) == std::vector<int>{0, 1, 2, 3, 4});
+    CHECK(items(b) == std::vector<int>{0, 1, 2, 3, 4, 0, 1, 2, 3, 4});
+    CHECK(items(c) == std::vector<int>{1, 2, 3, 4, 0, 1, 2, 3, 4});
+    // Popping the same version twice gives equal results.
+    CHECK(items(b.pop_front()) == items(c));
+    CHECK(list().empty());
+    CHECK((list() + a).size() == 5);
+    CHECK((a + list()).size() == 5);
+    CHECK(list(7).pop_front().empty());
+}
+
+void test_long_lists() {
+    list big;
+    for (int i = 0; i < 1000000; ++i)
+        big = big.push_back(i);
+    CHECK(big.size() == 1000000);
+    long sum = 0;
+    list x = big;
+    for (int i = 0; i < 1000; ++i) {
+        sum += x.front();
+        x = x.pop_front();
+    }
+    CHECK(sum == 999L * 1000 / 2);
+    CHECK(x.size() == 999000);
+    // Destroying both versions must not recurse per element.
+}
+
+void test_strings_and_threads() {
+    pl::cat_list<std::string> base;
+    for (int i = 0; i < 1000; ++i)
+        base = base.push_back(std::to_string(i));
+    std::vector<std::jthread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([base, t] {
+            pl::cat_list<std::string> mine = base;
+            for (int i = 0; i < 1000; ++i) {
+                mine = mine.push_back(std::to_string(t));
+                mine = mine.pop_front();
+            }
+            CHECK(mine.size() == 1000);
+            CHECK(mine.front() == std::to_string(t));
+        });
+    }
+    workers.clear();
+    CHECK(base.size() == 1000);
+    CHECK(base.front() == "0");
+}
+
+} // namespace
+
+int main() {
+    test_against_deque();
+    test_persistence();
+    test_long_lists();
+    test_strings_and_threads();
+    return check::exit_code();
+}
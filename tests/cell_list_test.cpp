@@ -0,0 +1,235 @@
+#include <p_linked_list/cell_list.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+using cells = pl::cell_list<double>;
+using vec = cells::vec;
+using pair_set = std::set<std::pair<std::uint32_t, std::uint32_t>>;
+
+std::vector<vec> random_positions(std::size_t n, double side, std::mt19937_64& rng) {
+    std::uniform_real_distribution<double> u(0.0, side);
+    std::vector<vec> p(n);
+    for (auto& v : p)
+        v = {u(rng), u(rng), u(rng)};
+    return p;
+}
+
+double distance2(const vec& a, const vec& b) {
+    double s = 0;
+    for (int k = 0; k < 3; ++k)
+        s += (a[k] - b[k]) * (a[k] - b[k]);
+    return s;
+}
+
+pair_set brute_pairs(const std::vector<vec>& p, double cutoff) {
+    pair_set out;
+    for (std::uint32_t i = 0; i < p.size(); ++i) {
+        for (std::uint32_t j = i + 1; j < p.size(); ++j) {
+            if (distance2(p[i], p[j]) <= cutoff * cutoff)
+                out.emplace(i, j);
+        }
+    }
+    return out;
+}
+
+// Pairs reported by the cell list, checking none is reported twice.
+pair_set cell_pairs(const cells& c, const std::vector<vec>& p) {
+    pair_set out;
+    std::size_t visits = 0;
+    c.for_each_pair(std::span<const vec>(p), [&](std::uint32_t i, std::uint32_t j) {
+        out.emplace(std::min(i, j), std::max(i, j));
+        ++visits;
+    });
+    CHECK(visits == out.size());
+    return out;
+}
+
+// Every particle sits exactly once in the list of the cell it reports.
+bool lists_consistent(const cells& c, std::size_t n) {
+    std::vector<int> seen(n);
+    for (std::size_t cell = 0; cell < c.cell_count(); ++cell) {
+        for (std::uint32_t i = c.head(cell); i != cells::none; i = c.next(i)) {
+            if (i >= n || c.cell(i) != cell)
+                return false;
+            ++seen[i];
+        }
+    }
+    return std::all_of(seen.begin(), seen.end(), [](int k) { return k == 1; });
+}
+
+void test_pairs_match_brute_force() {
+    std::mt19937_64 rng(1);
+    for (double cutoff : {0.7, 1.0, 2.5}) {
+        auto p = random_positions(1500, 8.0, rng);
+        cells c({0, 0, 0}, {8, 8, 8}, cutoff);
+        c.rebuild(p);
+        CHECK(lists_consistent(c, p.size()));
+        CHECK(cell_pairs(c, p) == brute_pairs(p, cutoff));
+    }
+}
+
+void test_dims() {
+    cells c({0, 0, 0}, {10, 5, 2.5}, 1.2);
+    CHECK((c.dims() == std::array<std::size_t, 3>{8, 4, 2}));
+    CHECK(c.cell_count() == 64);
+    // A cutoff larger than the box still gives one cell per axis.
+    cells one({0, 0, 0}, {1, 1, 1}, 5);
+    CHECK(one.cell_count() == 1);
+    CHECK_THROWS(std::invalid_argument, cells({0, 0, 0}, {1, 1, 1}, 0));
+    CHECK_THROWS(std::invalid_argument, cells({0, 0, 0}, {1, 0, 1}, 0.5));
+}
+
+void test_incremental_update() {
+    std::mt19937_64 rng(2);
+    const double side = 10, cutoff = 1.0;
+    auto p = random_positions(2000, side, rng);
+    cells c({0, 0, 0}, {side, side, side}, cutoff);
+    cells fresh({0, 0, 0}, {side, side, side}, cutoff);
+    c.set_rebuild_fraction(0.5);
+    c.rebuild(p);
+    std::normal_distribution<double> step(0.0, 0.05);
+    std::size_t moved_total = 0;
+    for (int s = 0; s < 20; ++s) {
+        std::vector<std::uint32_t> before(p.size());
+        for (std::uint32_t i = 0; i < p.size(); ++i)
+            before[i] = c.cell(i);
+        for (auto& v : p) {
+            for (double& x : v)
+                x = std::clamp(x + step(rng), 0.0, side);
+        }
+        const std::size_t moved = c.update(p);
+        fresh.rebuild(p);
+        std::size_t crossed = 0;
+        bool same_cells = true;
+        for (std::uint32_t i = 0; i < p.size(); ++i) {
+            crossed += fresh.cell(i) != before[i];
+            same_cells = same_cells && fresh.cell(i) == c.cell(i);
+        }
+        CHECK(moved == crossed && moved == c.last_moved());
+        CHECK(same_cells);
+        CHECK(moved < p.size() / 2);  // stayed on the incremental path
+        moved_total += moved;
+        if (s % 5 == 4) {
+            CHECK(lists_consistent(c, p.size()));
+            CHECK(cell_pairs(c, p) == brute_pairs(p, cutoff));
+        }
+    }
+    CHECK(moved_total > 0);
+}
+
+void test_rebuild_fallback_and_resize() {
+    std::mt19937_64 rng(3);
+    auto p = random_positions(1000, 6, rng);
+    cells c({0, 0, 0}, {6, 6, 6}, 1.0);
+    CHECK(c.update(p) == 1000);  // first call bins everything
+    // Scatter everything: far more than the default 10% change cell.
+    p = random_positions(1000, 6, rng);
+    const std::size_t moved = c.update(p);
+    CHECK(moved > 500 && c.last_moved() == moved);
+    CHECK(lists_consistent(c, p.size()));
+    // After a fallback rebuild each list is in ascending particle order.
+    bool ascending = true;
+    for (std::size_t cell = 0; cell < c.cell_count(); ++cell) {
+        for (std::uint32_t i = c.head(cell); i != cells::none && c.next(i) != cells::none; i = c.next(i))
+            ascending = ascending && i < c.next(i);
+    }
+    CHECK(ascending);
+    // A different particle count forces a rebuild.
+    p.resize(400);
+    CHECK(c.update(p) == 400);
+    CHECK(lists_consistent(c, 400));
+    CHECK(cell_pairs(c, p) == brute_pairs(p, 1.0));
+}
+
+void test_parallel_rebuild_is_identical() {
+    // Enough particles for the rebuild to use several threads.
+    std::mt19937_64 rng(4);
+    auto p = random_positions(100000, 30, rng);
+    cells serial({0, 0, 0}, {30, 30, 30}, 1.5);
+    cells parallel({0, 0, 0}, {30, 30, 30}, 1.5);
+    serial.rebuild(p, 1);
+    bool same = true;
+    for (unsigned threads : {2u, 5u, 0u}) {
+        parallel.rebuild(p, threads);
+        for (std::size_t cell = 0; cell < serial.cell_count(); ++cell)
+            same = same && serial.head(cell) == parallel.head(cell);
+        for (std::uint32_t i = 0; i < p.size(); ++i)
+            same = same && serial.next(i) == parallel.next(i) && serial.cell(i) == parallel.cell(i);
+    }
+    CHECK(same);
+    CHECK(lists_consistent(parallel, p.size()));
+    // And a parallel update on the incremental path.
+    for (auto& v : p)
+        v[0] = std::min(v[0] + 0.01, 30.0);
+    parallel.update(p, 4);
+    serial.rebuild(p, 1);
+    same = true;
+    for (std::uint32_t i = 0; i < p.size(); ++i)
+        same = same && serial.cell(i) == parallel.cell(i);
+    CHECK(same);
+}
+
+void test_neighbours() {
+    std::mt19937_64 rng(5);
+    auto p = random_positions(800, 5, rng);
+    cells c({0, 0, 0}, {5, 5, 5}, 0.9);
+    c.rebuild(p);
+    bool all = true;
+    for (std::uint32_t i = 0; i < p.size(); i += 7) {
+        std::set<std::uint32_t> got, want;
+        c.for_each_neighbour(std::span<const vec>(p), i, [&](std::uint32_t j) { got.insert(j); });
+        for (std::uint32_t j = 0; j < p.size(); ++j) {
+            if (j != i && distance2(p[i], p[j]) <= 0.81)
+                want.insert(j);
+        }
+        all = all && got == want;
+    }
+    CHECK(all);
+}
+
+void test_outside_box() {
+    // Particles outside the box land in the edge cells and still pair with
+    // their neighbours there.
+    std::vector<vec> p = {{-0.2, 0.1, 0.1}, {0.3, 0.1, 0.1}, {10.4, 9.9, 9.9}, {9.8, 9.9, 9.9}};
+    cells c({0, 0, 0}, {10, 10, 10}, 1.0);
+    c.rebuild(p);
+    CHECK(c.cell(0) == c.cell(1) && c.cell(0) == 0);
+    CHECK(c.cell(2) == c.cell(3) && c.cell(2) == c.cell_count() - 1);
+    CHECK((cell_pairs(c, p) == pair_set{{0, 1}, {2, 3}}));
+}
+
+void test_empty() {
+    cells c({0, 0, 0}, {4, 4, 4}, 1);
+    std::vector<vec> none;
+    c.rebuild(none, 4);
+    CHECK(c.update(none) == 0);
+    CHECK(cell_pairs(c, none).empty());
+}
+
+} // namespace
+
+int main() {
+    test_pairs_match_brute_force();
+    test_dims();
+    test_incremental_update();
+    test_rebuild_fallback_and_resize();
+    test_parallel_rebuild_is_identical();
+    test_neighbours();
+    test_outside_box();
+    test_empty();
+    return check::exit_code();
+}
@@ -0,0 +1,245 @@
+#include <p_linked_list/channel.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+using namespace std::chrono_literals;
+
+void test_buffered_fifo() {
+    pl::channel<int> ch(3);
+    CHECK(ch.capacity() == 3);
+    for (int i = 0; i < 3; ++i) {
+        int v = i;
+        CHECK(ch.try_send(v));
+    }
+    int extra = 3;
+    CHECK(!ch.try_send(extra));
+    CHECK(ch.size() == 3);
+    std::optional<int> out;
+    for (int i = 0; i < 3; ++i) {
+        CHECK(ch.try_recv(out) && out == i);
+    }
+    CHECK(!ch.try_recv(out));
+
+    pl::channel<int> unbounded(pl::channel<int>::unbounded);
+    for (int i = 0; i < 100000; ++i)
+        unbounded.send(i);
+    CHECK(unbounded.size() == 100000);
+    bool ok = true;
+    for (int i = 0; i < 100000; ++i)
+        ok = ok && unbounded.recv() == i;
+    CHECK(ok);
+}
+
+void test_unbuffered_rendezvous() {
+    pl::channel<int> ch;
+    int v = 1;
+    CHECK(!ch.try_send(v));  // nobody is receiving
+    std::atomic<bool> sent{false};
+    std::jthread sender([&] {
+        ch.send(42);
+        sent.store(true);
+    });
+    std::this_thread::sleep_for(20ms);
+    CHECK(!sent.load());
+    CHECK(ch.recv() == 42);
+    sender.join();
+    CHECK(sent.load());
+    CHECK(ch.size() == 0);
+}
+
+// A sender blocked on a full buffer is admitted as soon as room is made,
+// behind the values already buffered.
+void test_blocked_senders_keep_order() {
+    pl::channel<int> ch(2);
+    ch.send(0);
+    ch.send(1);
+    std::jthread sender([&] {
+        for (int i = 2; i < 1000; ++i)
+            ch.send(i);
+    });
+    bool ok = true;
+    for (int i = 0; i < 1000; ++i)
+        ok = ok && ch.recv() == i;
+    CHECK(ok);
+}
+
+void test_close() {
+    pl::channel<int> ch(4);
+    ch.send(1);
+    ch.send(2);
+    ch.close();
+    ch.close();
+    CHECK_THROWS(pl::channel_closed, ch.send(3));
+    CHECK(ch.recv() == 1 && ch.recv() == 2);
+    CHECK(!ch.recv());
+    std::optional<int> out = 7;
+    CHECK(ch.try_recv(out) && !out);
+
+    // Blocked parties are released: receivers with nullopt, senders with
+    // channel_closed.
+    pl::channel<int> rendezvous;
+    std::jthread receiver([&] { CHECK(!rendezvous.recv()); });
+    pl::channel<int> full(1);
+    full.send(0);
+    std::jthread sender([&] { CHECK_THROWS(pl::channel_closed, full.send(1)); });
+    std::this_thread::sleep_for(20ms);
+    rendezvous.close();
+    full.close();
+}
+
+void test_select_ready_and_blocking() {
+    pl::channel<int> a(1), b(1);
+    pl::channel<std::string> c(1);
+    {
+        pl::recv_case<int> ra(a);
+        pl::recv_case<int> rb(b);
+        CHECK(!pl::try_select(ra, rb));
+        b.send(5);
+        CHECK(pl::try_select(ra, rb) == 1u && rb.value == 5);
+    }
+    {
+        // Blocks until another thread sends on one of the channels.
+        pl::recv_case<int> ra(a);
+        pl::recv_case<std::string> rc(c);
+        std::jthread sender([&] {
+            std::this_thread::sleep_for(20ms);
+            c.send("hello");
+        });
+        CHECK(pl::select(ra, rc) == 1u);
+        CHECK(rc.value == "hello" && !ra.value);
+    }
+    {
+        // A send case completes when there is room; a full channel is
+        // skipped.
+        a.send(1);
+        pl::send_case<int> sa(a, 2);
+        pl::send_case<int> sb(b, 3);
+        CHECK(pl::select(sa, sb) == 1u);
+        CHECK(b.recv() == 3 && a.recv() == 1);
+    }
+    {
+        // Select on an unbuffered channel pairs with a blocked receiver.
+        pl::channel<int> r;
+        std::jthread receiver([&] { CHECK(r.recv() == 9); });
+        std::this_thread::sleep_for(20ms);
+        pl::send_case<int> s(r, 9);
+        pl::recv_case<int> ra(a);
+        CHECK(pl::select(s, ra) == 0u);
+    }
+}
+
+void test_select_closed() {
+    pl::channel<int> a, b;
+    pl::recv_case<int> ra(a);
+    pl::recv_case<int> rb(b);
+    std::thread closer([&] {
+        std::this_thread::sleep_for(20ms);
+        b.close();
+    });
+    CHECK(pl::select(ra, rb) == 1u);
+    CHECK(!rb.value);
+    closer.join();
+    pl::send_case<int> sb(b, 1);
+    CHECK_THROWS(pl::channel_closed, pl::select(sb));
+}
+
+void test_select_fairness() {
+    pl::channel<int> a(pl::channel<int>::unbounded), b(pl::channel<int>::unbounded);
+    for (int i = 0; i < 1000; ++i) {
+        a.send(i);
+        b.send(i);
+    }
+    int from_a = 0;
+    for (int i = 0; i < 1000; ++i) {
+        pl::recv_case<int> ra(a);
+        pl::recv_case<int> rb(b);
+        from_a += pl::select(ra, rb) == 0;
+    }
+    CHECK(from_a > 300 && from_a < 700);
+}
+
+void test_move_only_values() {
+    pl::channel<std::unique_ptr<int>> ch(1);
+    ch.send(std::make_unique<int>(3));
+    auto p = ch.recv();
+    CHECK(p && *p && **p == 3);
+    pl::send_case<std::unique_ptr<int>> s(ch, std::make_unique<int>(4));
+    CHECK(pl::select(s) == 0u);
+    CHECK(**ch.recv() == 4);
+}
+
+// Producers send distinct values on four channels of different kinds;
+// consumers select over all four.  Every value arrives exactly once.
+void test_select_stress() {
+    pl::channel<int> chans[4] = {pl::channel<int>(0), pl::channel<int>(1), pl::channel<int>(16),
+                                 pl::channel<int>(pl::channel<int>::unbounded)};
+    constexpr int producers = 4, per_producer = 20000;
+    std::vector<std::vector<int>> got(3);
+    {
+        std::vector<std::jthread> consumers;
+        for (int c = 0; c < 3; ++c) {
+            consumers.emplace_back([&, c] {
+                int closed = 0;
+                bool done[4] = {};
+                while (closed < 4) {
+                    pl::recv_case<int> r0(chans[0]), r1(chans[1]), r2(chans[2]), r3(chans[3]);
+                    std::size_t i = pl::select(r0, r1, r2, r3);
+                    pl::recv_case<int>* rs[4] = {&r0, &r1, &r2, &r3};
+                    if (rs[i]->value)
+                        got[c].push_back(*rs[i]->value);
+                    else if (!done[i]) {
+                        done[i] = true;
+                        ++closed;
+                    }
+                }
+            });
+        }
+        {
+            std::vector<std::jthread> threads;
+            for (int p = 0; p < producers; ++p) {
+                threads.emplace_back([&, p] {
+                    for (int i = 0; i < per_producer; ++i)
+                        chans[(p + i) % 4].send(p * per_producer + i);
+                });
+            }
+        }
+        for (auto& ch : chans)
+            ch.close();
+    }
+    std::set<int> all;
+    std::size_t total = 0;
+    for (auto& g : got) {
+        all.insert(g.begin(), g.end());
+        total += g.size();
+    }
+    CHECK(total == producers * per_producer);
+    CHECK(all.size() == total);
+}
+
+} // namespace
+
+int main() {
+    test_buffered_fifo();
+    test_unbuffered_rendezvous();
+    test_blocked_senders_keep_order();
+    test_close();
+    test_select_ready_and_blocking();
+    test_select_closed();
+    test_select_fairness();
+    test_move_only_values();
+    test_select_stress();
+    return check::exit_code();
+}
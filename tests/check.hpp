@@ -0,0 +1,47 @@
+// Minimal checking for the tests.  CHECK records a failure and carries on,
+// so one run reports every broken expectation; main() returns
+// check::exit_code().
+
+#ifndef P_LINKED_LIST_TESTS_CHECK_HPP
+#define P_LINKED_LIST_TESTS_CHECK_HPP
+
+#include <atomic>
+#include <cstdio>
+
+namespace check {
+
+inline std::atomic<int>& failures() {
+    static std::atomic<int> n{0};
+    return n;
+}
+
+inline void fail(const char* what, const char* file, int line) {
+    std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, what);
+    ++failures();
+}
+
+inline int exit_code() {
+    if (int n = failures().load()) {
+        std::fprintf(stderr, "%d check(s) failed\n", n);
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace check
+
+#define CHECK(...) ((__VA_ARGS__) ? (void)0 : check::fail(#__VA_ARGS__, __FILE__, __LINE__))
+
+#define CHECK_THROWS(type, ...)                                      \
+    do {                                                             \
+        bool caught_ = false;                                        \
+        try {                                                        \
+            (void)(__VA_ARGS__);                                     \
+        } catch (const type&) {                                      \
+            caught_ = true;                                          \
+        }                                                            \
+        if (!caught_)                                                \
+            check::fail("throws " #type ": " #__VA_ARGS__, __FILE__, __LINE__); \
+    } while (0)
+
+#endif
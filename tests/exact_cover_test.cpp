@@ -0,0 +1,257 @@
+#include <p_linked_list/exact_cover.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// Every primary column covered exactly once, every secondary at most once.
+bool is_cover(const std::vector<std::vector<std::size_t>>& rows, const std::vector<std::size_t>& chosen,
+              std::size_t primary, std::size_t secondary) {
+    std::vector<int> hits(primary + secondary);
+    for (std::size_t r : chosen) {
+        for (std::size_t c : rows[r])
+            ++hits[c];
+    }
+    for (std::size_t c = 0; c < hits.size(); ++c) {
+        if (c < primary ? hits[c] != 1 : hits[c] > 1)
+            return false;
+    }
+    return true;
+}
+
+void test_knuth_example() {
+    // The example from Knuth's Dancing Links paper.
+    const std::vector<std::vector<std::size_t>> rows = {
+        {2, 4, 5}, {0, 3, 6}, {1, 2, 5}, {0, 3}, {1, 6}, {3, 4, 6}};
+    for (unsigned threads : {1u, 2u, 4u}) {
+        pl::exact_cover x(7);
+        for (const auto& r : rows)
+            x.add_row(r);
+        auto s = x.solve(threads);
+        CHECK(s && *s == std::vector<std::size_t>{0, 3, 4});
+        CHECK(x.count_solutions() == 1);  // solve() left the matrix intact
+    }
+}
+
+void test_no_solution() {
+    pl::exact_cover x(3);
+    x.add_row({0, 1});
+    x.add_row({1, 2});
+    CHECK(!x.solve());
+    CHECK(!x.solve(3));
+    CHECK(x.count_solutions() == 0);
+    pl::exact_cover uncovered(2);
+    uncovered.add_row({0});
+    CHECK(!uncovered.solve());
+}
+
+void test_enumeration() {
+    // Four columns and every single-column and two-column row: the covers
+    // are the set partitions of {0,1,2,3} into blocks of size at most two,
+    // of which there are 10.
+    pl::exact_cover x(4);
+    std::vector<std::vector<std::size_t>> rows;
+    for (std::size_t a = 0; a < 4; ++a) {
+        rows.push_back({a});
+        for (std::size_t b = a + 1; b < 4; ++b)
+            rows.push_back({a, b});
+    }
+    for (const auto& r : rows)
+        x.add_row(r);
+    CHECK(x.count_solutions() == 10);
+    CHECK(x.count_solutions(3) == 3);
+
+    std::set<std::vector<std::size_t>> seen;
+    bool all_valid = true;
+    CHECK(x.for_each_solution([&](std::span<const std::size_t> s) {
+        std::vector<std::size_t> v(s.begin(), s.end());
+        all_valid = all_valid && is_cover(rows, v, 4, 0);
+        seen.insert(v);
+        return true;
+    }) == 10);
+    CHECK(all_valid && seen.size() == 10);
+    CHECK(x.for_each_solution([](std::span<const std::size_t>) { return false; }) == 1);
+}
+
+// N queens: ranks and files are primary, diagonals secondary.
+pl::exact_cover queens(std::size_t n, std::vector<std::vector<std::size_t>>& rows) {
+    pl::exact_cover x(2 * n, 2 * (2 * n - 1));
+    for (std::size_t r = 0; r < n; ++r) {
+        for (std::size_t c = 0; c < n; ++c) {
+            rows.push_back({r, n + c, 2 * n + r + c, 2 * n + (2 * n - 1) + (n - 1 + r - c)});
+            x.add_row(rows.back());
+        }
+    }
+    return x;
+}
+
+void test_secondary_columns() {
+    std::vector<std::vector<std::size_t>> rows;
+    pl::exact_cover x = queens(8, rows);
+    CHECK(x.count_solutions() == 92);
+    auto s = x.solve(4);
+    CHECK(s && s->size() == 8 && is_cover(rows, *s, 16, 30));
+    std::vector<std::vector<std::size_t>> rows3;
+    CHECK(!queens(3, rows3).solve(2));
+}
+
+// Standard encoding: cell, row-digit, column-digit and box-digit
+// constraints; the givens only get the row for their digit.
+std::string solve_sudoku(const std::string& puzzle, unsigned threads) {
+    pl::exact_cover x(324);
+    std::vector<std::pair<std::size_t, int>> placements;
+    for (std::size_t cell = 0; cell < 81; ++cell) {
+        const std::size_t r = cell / 9, c = cell % 9, b = r / 3 * 3 + c / 3;
+        for (int d = 1; d <= 9; ++d) {
+            if (puzzle[cell] != '.' && puzzle[cell] - '0' != d)
+                continue;
+            const auto k = static_cast<std::size_t>(d - 1);
+            x.add_row({cell, 81 + r * 9 + k, 162 + c * 9 + k, 243 + b * 9 + k});
+            placements.emplace_back(cell, d);
+        }
+    }
+    auto s = x.solve(threads);
+    if (!s)
+        return {};
+    std::string out(81, '.');
+    for (std::size_t row : *s)
+        out[placements[row].first] = static_cast<char>('0' + placements[row].second);
+    return out;
+}
+
+bool valid_grid(const std::string& g, const std::string& puzzle) {
+    if (g.size() != 81)
+        return false;
+    for (std::size_t i = 0; i < 81; ++i) {
+        if (puzzle[i] != '.' && puzzle[i] != g[i])
+            return false;
+    }
+    for (std::size_t k = 0; k < 9; ++k) {
+        std::array<bool, 10> row{}, col{}, box{};
+        for (std::size_t j = 0; j < 9; ++j) {
+            const auto rd = static_cast<std::size_t>(g[k * 9 + j] - '0');
+            const auto cd = static_cast<std::size_t>(g[j * 9 + k] - '0');
+            const auto bd = static_cast<std::size_t>(g[(k / 3 * 3 + j / 3) * 9 + k % 3 * 3 + j % 3] - '0');
+            if (row[rd] || col[cd] || box[bd])
+                return false;
+            row[rd] = col[cd] = box[bd] = true;
+        }
+    }
+    return true;
+}
+
+void test_sudoku() {
+    const std::string puzzles[] = {
+        "53..7....6..195....98....6.8...6...34..8.3..17...2...6.6....28....419..5....8..79",
+        "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......",
+    };
+    for (const auto& p : puzzles) {
+        for (unsigned threads : {1u, 3u, 0u})
+            CHECK(valid_grid(solve_sudoku(p, threads), p));
+    }
+    // Two 1s in the first row.
+    const std::string broken = "11" + std::string(79, '.');
+    CHECK(solve_sudoku(broken, 1).empty());
+    CHECK(solve_sudoku(broken, 4).empty());
+}
+
+// The twelve pentominoes, each as five (row, column) cells.
+using shape = std::array<std::pair<int, int>, 5>;
+const shape pentominoes[12] = {
+    {{{0, 1}, {0, 2}, {1, 0}, {1, 1}, {2, 1}}}, {{{0, 0}, {0, 1}, {0, 2}, {0, 3}, {0, 4}}},
+    {{{0, 0}, {1, 0}, {2, 0}, {3, 0}, {3, 1}}}, {{{0, 1}, {1, 1}, {2, 0}, {2, 1}, {3, 0}}},
+    {{{0, 0}, {0, 1}, {1, 0}, {1, 1}, {2, 0}}}, {{{0, 0}, {0, 1}, {0, 2}, {1, 1}, {2, 1}}},
+    {{{0, 0}, {0, 2}, {1, 0}, {1, 1}, {1, 2}}}, {{{0, 0}, {1, 0}, {2, 0}, {2, 1}, {2, 2}}},
+    {{{0, 0}, {1, 0}, {1, 1}, {2, 1}, {2, 2}}}, {{{0, 1}, {1, 0}, {1, 1}, {1, 2}, {2, 1}}},
+    {{{0, 1}, {1, 0}, {1, 1}, {2, 1}, {3, 1}}}, {{{0, 0}, {0, 1}, {1, 1}, {2, 1}, {2, 2}}},
+};
+
+// Every placement of every piece, in every distinct orientation, on a
+// height x width board; columns are the 12 pieces and then the cells.
+pl::exact_cover pentomino_board(int height, int width) {
+    pl::exact_cover x(12 + static_cast<std::size_t>(height * width));
+    for (std::size_t p = 0; p < 12; ++p) {
+        std::set<shape> orientations;
+        for (int o = 0; o < 8; ++o) {
+            shape s = pentominoes[p];
+            for (auto& [r, c] : s) {
+                if (o & 1)
+                    std::swap(r, c);
+                if (o & 2)
+                    r = -r;
+                if (o & 4)
+                    c = -c;
+            }
+            const int r0 = std::min_element(s.begin(), s.end())->first;
+            int c0 = s[0].second;
+            for (auto& cell : s)
+                c0 = std::min(c0, cell.second);
+            for (auto& [r, c] : s) {
+                r -= r0;
+                c -= c0;
+            }
+            std::sort(s.begin(), s.end());
+            orientations.insert(s);
+        }
+        for (const shape& s : orientations) {
+            for (int dr = 0; dr < height; ++dr) {
+                for (int dc = 0; dc < width; ++dc) {
+                    std::vector<std::size_t> row = {p};
+                    for (auto [r, c] : s) {
+                        if (r + dr >= height || c + dc >= width)
+                            break;
+                        row.push_back(12 + static_cast<std::size_t>((r + dr) * width + c + dc));
+                    }
+                    if (row.size() == 6)
+                        x.add_row(row);
+                }
+            }
+        }
+    }
+    return x;
+}
+
+void test_pentominoes() {
+    // 3 x 20 has two tilings, each in four mirror images.
+    CHECK(pentomino_board(3, 20).count_solutions() == 8);
+    for (unsigned threads : {1u, 4u}) {
+        auto s = pentomino_board(6, 10).solve(threads);
+        CHECK(s && s->size() == 12);
+    }
+}
+
+void test_errors() {
+    pl::exact_cover x(3, 1);
+    CHECK_THROWS(std::invalid_argument, x.add_row(std::span<const std::size_t>()));
+    CHECK_THROWS(std::out_of_range, x.add_row({0, 4}));
+    CHECK_THROWS(std::invalid_argument, x.add_row({1, 2, 1}));
+    CHECK_THROWS(std::invalid_argument, x.add_row({3, 3}));
+    CHECK(x.rows() == 0);
+    CHECK(x.add_row({0, 3}) == 0 && x.add_row({1, 2}) == 1);
+    auto s = x.solve();
+    CHECK(s && *s == std::vector<std::size_t>{0, 1});
+}
+
+} // namespace
+
+int main() {
+    test_knuth_example();
+    test_no_solution();
+    test_enumeration();
+    test_secondary_columns();
+    test_sudoku();
+    test_pentominoes();
+    test_errors();
+    return check::exit_code();
+}
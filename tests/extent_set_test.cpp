@@ -0,0 +1,235 @@
+#include <p_linked_list/extent_set.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// Reference: one flag per unit of a small universe starting at `base`.
+template <class Key>
+struct model {
+    Key base;
+    std::vector<bool> bits;
+
+    void set(Key start, Key end, bool v) {
+        for (Key k = start; k < end; ++k)
+            bits[k - base] = v;
+    }
+
+    std::vector<typename pl::extent_set<Key>::extent> extents() const {
+        std::vector<typename pl::extent_set<Key>::extent> out;
+        for (std::size_t i = 0; i < bits.size();) {
+            if (!bits[i]) {
+                ++i;
+                continue;
+            }
+            std::size_t j = i;
+            while (j < bits.size() && bits[j])
+                ++j;
+            out.push_back({static_cast<Key>(base + i), static_cast<Key>(base + j)});
+            i = j;
+        }
+        return out;
+    }
+};
+
+template <class Key>
+bool same(const pl::extent_set<Key>& s, const model<Key>& m) {
+    const auto want = m.extents();
+    std::vector<typename pl::extent_set<Key>::extent> got(s.begin(), s.end());
+    Key total = 0;
+    for (const auto& e : want)
+        total += e.length();
+    return got == want && s.size() == want.size() && s.total_length() == total;
+}
+
+template <class Key>
+std::optional<typename pl::extent_set<Key>::extent> model_first_fit(const model<Key>& m, Key len) {
+    for (const auto& e : m.extents()) {
+        if (e.length() >= len)
+            return e;
+    }
+    return std::nullopt;
+}
+
+template <class Key>
+std::optional<typename pl::extent_set<Key>::extent> model_best_fit(const model<Key>& m, Key len) {
+    std::optional<typename pl::extent_set<Key>::extent> best;
+    for (const auto& e : m.extents()) {
+        if (e.length() >= len && (!best || e.length() < best->length()))
+            best = e;
+    }
+    return best;
+}
+
+// Random inserts, erases, lookups and allocations against the model, in a
+// universe of `universe` units starting at `base`.
+template <class Key>
+void random_run(Key base, std::size_t universe, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    pl::extent_set<Key> s;
+    model<Key> m{base, std::vector<bool>(universe)};
+    auto random_range = [&] {
+        const Key a = static_cast<Key>(base + rng() % universe);
+        const Key len = static_cast<Key>(rng() % 40);
+        const Key b = static_cast<Key>(std::min<std::uint64_t>(std::uint64_t(a) + len, std::uint64_t(base) + universe));
+        return std::pair<Key, Key>(a, b);
+    };
+    bool ok = true;
+    for (int step = 0; step < 4000; ++step) {
+        auto [a, b] = random_range();
+        switch (rng() % 6) {
+        case 0:
+        case 1:
+            s.insert(a, b);
+            m.set(a, b, true);
+            break;
+        case 2:
+            s.erase(a, b);
+            m.set(a, b, false);
+            break;
+        case 3: {
+            const Key len = static_cast<Key>(1 + rng() % 30);
+            ok = ok && s.first_fit(len) == model_first_fit(m, len) && s.best_fit(len) == model_best_fit(m, len);
+            break;
+        }
+        case 4: {
+            const Key len = static_cast<Key>(1 + rng() % 20);
+            const bool first = rng() % 2;
+            const auto want = first ? model_first_fit(m, len) : model_best_fit(m, len);
+            const auto got = first ? s.allocate_first_fit(len) : s.allocate_best_fit(len);
+            ok = ok && (want ? got == want->start : !got);
+            if (got)
+                m.set(*got, static_cast<Key>(*got + len), false);
+            break;
+        }
+        case 5:
+            ok = ok && s.contains(a) == m.bits[a - base];
+            if (auto e = s.find(a))
+                ok = ok && e->start <= a && a < e->end;
+            break;
+        }
+        if (step % 50 == 0)
+            ok = ok && same(s, m);
+    }
+    CHECK(ok);
+    CHECK(same(s, m));
+}
+
+void test_coalescing() {
+    pl::extent_set<> s;
+    s.insert(10, 20);
+    s.insert(30, 40);
+    s.insert(20, 30);  // touches both: one extent
+    CHECK(s.size() == 1 && *s.begin() == (pl::extent_set<>::extent{10, 40}));
+    s.insert(5, 50);   // swallows it
+    s.insert(60, 70);
+    s.insert(0, 0);    // empty ranges are ignored
+    s.insert(9, 3);
+    CHECK(s.size() == 2 && s.total_length() == 55);
+    s.erase(20, 25);   // split
+    CHECK(s.size() == 3 && s.find(20) == std::nullopt && s.find(25)->start == 25);
+    s.erase(0, 100);
+    CHECK(s.empty() && s.total_length() == 0 && s.begin() == s.end());
+}
+
+void test_fits() {
+    pl::extent_set<> s;
+    s.insert(0, 8);
+    s.insert(100, 104);
+    s.insert(200, 216);
+    s.insert(300, 305);
+    CHECK(s.first_fit(5)->start == 0);
+    CHECK(s.first_fit(9)->start == 200);
+    CHECK(s.best_fit(5)->start == 300);
+    CHECK(s.best_fit(4)->start == 100);
+    CHECK(!s.first_fit(17) && !s.best_fit(17));
+    CHECK(s.allocate_best_fit(4) == 100u);
+    CHECK(!s.contains(100) && s.size() == 3);
+    CHECK(s.allocate_first_fit(6) == 0u);
+    CHECK(s.find(6)->start == 6 && s.find(6)->end == 8);
+    CHECK(!s.allocate_first_fit(0));
+}
+
+void test_random_64() { random_run<std::uint64_t>(1000, 3000, 1); }
+
+void test_random_32() {
+    // 32-bit keys: the node header is then smaller than a link, so this
+    // also covers link alignment.  Run once near the top of the key range.
+    random_run<std::uint32_t>(0, 3000, 2);
+    random_run<std::uint32_t>(0xffffffffu - 3000, 3000, 3);
+    pl::extent_set<std::uint32_t> s;
+    s.insert(0, 0xffffffffu);
+    s.erase(0x7fffffffu, 0x80000001u);
+    CHECK(s.size() == 2 && s.total_length() == 0xffffffffu - 2);
+    CHECK(s.best_fit(0x7fffffffu)->start == 0);
+}
+
+void test_small_keys() { random_run<std::uint16_t>(0, 2000, 4); }
+
+void test_many_extents() {
+    // Every other unit: the index has to stay correct at depth.
+    pl::extent_set<> s;
+    const std::uint64_t n = 200000;
+    for (std::uint64_t i = 0; i < n; ++i)
+        s.insert(2 * i, 2 * i + 1);
+    CHECK(s.size() == n);
+    s.insert(2 * (n - 1) + 1, 2 * (n - 1) + 9);  // one long extent at the end
+    CHECK(s.first_fit(2)->start == 2 * (n - 1));
+    CHECK(s.best_fit(2)->start == 2 * (n - 1));
+    for (std::uint64_t i = 0; i < n; i += 2)
+        s.insert(2 * i + 1, 2 * i + 2);  // joins pairs
+    CHECK(s.size() == n / 2 && s.first_fit(3)->start == 0);
+    CHECK(s.contains(12345) == (12345 % 4 != 3));
+}
+
+// Counts bytes, to check every node is returned.
+class counting_resource : public std::pmr::memory_resource {
+public:
+    std::size_t live = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        live += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        live -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+};
+
+void test_memory_resource() {
+    counting_resource mr;
+    {
+        pl::extent_set<std::uint32_t> s(&mr);
+        for (std::uint32_t i = 0; i < 1000; ++i)
+            s.insert(3 * i, 3 * i + 2);
+        s.erase(100, 2000);
+        CHECK(mr.live > 0);
+    }
+    CHECK(mr.live == 0);
+}
+
+} // namespace
+
+int main() {
+    test_coalescing();
+    test_fits();
+    test_random_64();
+    test_random_32();
+    test_small_keys();
+    test_many_extents();
+    test_memory_resource();
+    return check::exit_code();
+}
@@ -0,0 +1,112 @@
+#include <p_linked_list/hash_cons.hpp>
+
+#include <cctype>
+#include <string>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+void test_equal_lists_are_identical() {
+    pl::hash_cons<std::string> hc;
+    std::vector<std::string> a{"main", "run", "loop", "f"};
+    std::vector<std::string> b{"main", "run", "loop", "g"};
+    auto la = hc.from_range(a.begin(), a.end());
+    auto lb = hc.from_range(b.begin(), b.end());
+    auto la2 = hc.from_range(a.begin(), a.end());
+    CHECK(la == la2);
+    CHECK(la.get() == la2.get());
+    CHECK(la != lb);
+    CHECK(la.size() == 4);
+    CHECK(la.head() == "main");
+
+    std::string joined;
+    for (const auto& s : la)
+        joined += s;
+    CHECK(joined == "mainrunloopf");
+}
+
+void test_suffixes_are_shared() {
+    pl::hash_cons<int> hc;
+    std::vector<int> a{1, 2, 3, 4, 5};
+    std::vector<int> b{9, 8, 3, 4, 5};
+    auto la = hc.from_range(a.begin(), a.end());
+    auto lb = hc.from_range(b.begin(), b.end());
+    CHECK(la.tail().tail() == lb.tail().tail());
+    CHECK(hc.node_count() == 7);
+    CHECK(hc.stats().cons_calls == 10);
+    CHECK(hc.stats().nodes == 7);
+    CHECK(hc.stats().bytes_saved() == 3 * sizeof(pl::hash_cons<int>::node));
+}
+
+void test_cons_and_nil() {
+    pl::hash_cons<int> hc;
+    auto nil = hc.nil();
+    CHECK(nil.empty());
+    CHECK(nil.size() == 0);
+    CHECK(nil.begin() == nil.end());
+    auto one = hc.cons(1, nil);
+    auto two = hc.cons(2, one);
+    CHECK(two.tail() == one);
+    CHECK(two.size() == 2);
+    CHECK(hc.cons(2, hc.cons(1, hc.nil())) == two);
+    CHECK(hc.cons(1, one) != two);
+    CHECK(hc.node_count() == 3);
+}
+
+struct ci_hash {
+    std::size_t operator()(const std::string& s) const {
+        std::string l;
+        for (char c : s)
+            l += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        return std::hash<std::string>()(l);
+    }
+};
+
+struct ci_equal {
+    bool operator()(const std::string& a, const std::string& b) const {
+        if (a.size() != b.size())
+            return false;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+                return false;
+        }
+        return true;
+    }
+};
+
+void test_custom_equality() {
+    pl::hash_cons<std::string, ci_hash, ci_equal> hc;
+    auto a = hc.cons("Main", hc.nil());
+    auto b = hc.cons("MAIN", hc.nil());
+    CHECK(a == b);
+    CHECK(a.head() == "Main");
+}
+
+void test_many_lists() {
+    pl::hash_cons<int> hc;
+    std::vector<pl::hash_cons<int>::list> lists;
+    for (int i = 0; i < 1000; ++i) {
+        std::vector<int> v{i % 10, i % 7, 0, 1, 2};
+        lists.push_back(hc.from_range(v.begin(), v.end()));
+    }
+    // Suffix (0, 1, 2) is shared; (i % 7, ...) has 7 variants and the heads
+    // combine into 70 distinct lists.
+    CHECK(hc.node_count() == 3 + 7 + 70);
+    for (std::size_t i = 0; i < lists.size(); ++i)
+        CHECK(lists[i] == lists[i % 70]);
+}
+
+} // namespace
+
+int main() {
+    test_equal_lists_are_identical();
+    test_suffixes_are_shared();
+    test_cons_and_nil();
+    test_custom_equality();
+    test_many_lists();
+    return check::exit_code();
+}
@@ -0,0 +1,137 @@
+#include <p_linked_list/locality.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <forward_list>
+#include <list>
+#include <random>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// Analyzes a made-up sequence of node addresses, so every expectation is
+// exact rather than dependent on the allocator.
+pl::locality_report analyze(const std::vector<std::uintptr_t>& addresses, pl::locality_options options = {}) {
+    return pl::analyze_locality(addresses.begin(), addresses.end(), options,
+                                [](auto it) { return reinterpret_cast<const void*>(*it); });
+}
+
+std::vector<std::uintptr_t> strided(std::size_t n, std::uintptr_t stride, std::uintptr_t base = 1 << 20) {
+    std::vector<std::uintptr_t> out(n);
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = base + i * stride;
+    return out;
+}
+
+void test_empty_and_single() {
+    CHECK(analyze({}).hops == 0);
+    auto r = analyze({0x1000});
+    CHECK(r.hops == 0 && r.estimated_miss_rate() == 0.0 && !r.recommend_compaction);
+}
+
+void test_dense_nodes() {
+    // 16-byte nodes: one hop in four leaves its line, all short and forward.
+    auto r = analyze(strided(1025, 16));
+    CHECK(r.hops == 1024);
+    CHECK(r.cross_line_hops == 256);
+    CHECK(r.cross_page_hops == 4);
+    CHECK(r.estimated_misses == 0);
+    CHECK(r.backward_hops == 0);
+    CHECK(r.stride_log2[5] == 1024);  // 16 has bit width 5
+    CHECK(!r.recommend_compaction);
+}
+
+void test_steady_stride_within_page() {
+    // A 512-byte stride is too long for the short-forward rule, but the
+    // prefetcher follows it: only the first hop and page crossings miss.
+    auto r = analyze(strided(65, 512));
+    CHECK(r.hops == 64 && r.cross_line_hops == 64);
+    CHECK(r.cross_page_hops == 8);
+    CHECK(r.estimated_misses == 1 + 8);
+    CHECK(!r.recommend_compaction);
+}
+
+void test_backward_and_scattered() {
+    auto backward = strided(101, 16);
+    std::reverse(backward.begin(), backward.end());
+    auto r = analyze(backward);
+    CHECK(r.backward_hops == 100);
+    // Backward hops never count as short forward ones, but a repeated
+    // stride within a page does: only the first line crossing misses.
+    CHECK(r.cross_line_hops == 25);
+    CHECK(r.estimated_misses == 1);
+
+    std::vector<std::uintptr_t> scattered(5000);
+    std::mt19937_64 rng(1);
+    for (auto& a : scattered)
+        a = (rng() % (std::uintptr_t(1) << 32)) & ~std::uintptr_t(15);
+    r = analyze(scattered);
+    CHECK(r.estimated_miss_rate() > 0.95);
+    CHECK(r.cross_page_fraction() > 0.95);
+    CHECK(r.recommend_compaction);
+    std::size_t total = 0;
+    for (std::size_t c : r.stride_log2)
+        total += c;
+    CHECK(total == r.hops);
+}
+
+void test_limits() {
+    std::vector<std::uintptr_t> scattered(10000);
+    std::mt19937_64 rng(2);
+    for (auto& a : scattered)
+        a = rng() % (std::uintptr_t(1) << 40);
+    CHECK(analyze(scattered).hops == 4096);
+    CHECK(analyze(scattered, {.max_hops = 0}).hops == 9999);
+    CHECK(analyze(scattered, {.max_hops = 10}).hops == 10);
+
+    // Too few hops to judge.
+    std::vector<std::uintptr_t> few(scattered.begin(), scattered.begin() + 30);
+    CHECK(!analyze(few).recommend_compaction);
+    CHECK(analyze(few, {.min_hops = 8}).recommend_compaction);
+    CHECK(!analyze(scattered, {.compact_threshold = 1.0}).recommend_compaction);
+}
+
+void test_cache_geometry_options() {
+    auto r = analyze(strided(129, 64), {.cache_line = 128, .page = 1 << 21});
+    CHECK(r.cross_line_hops == 64 && r.cross_page_hops == 0);
+}
+
+void test_real_lists() {
+    std::list<int> fresh(2000);
+    auto compact = pl::analyze_locality(fresh);
+    CHECK(compact.hops == 1999);
+
+    // Relinking the same nodes into a random order scatters the hops.
+    std::list<int> shuffled;
+    std::vector<std::list<int>::iterator> its;
+    for (auto it = fresh.begin(); it != fresh.end(); ++it)
+        its.push_back(it);
+    std::shuffle(its.begin(), its.end(), std::mt19937(3));
+    for (auto it : its)
+        shuffled.splice(shuffled.end(), fresh, it);
+    auto scattered = pl::analyze_locality(shuffled);
+    CHECK(scattered.hops == 1999);
+    CHECK(scattered.estimated_miss_rate() > compact.estimated_miss_rate());
+    CHECK(scattered.recommend_compaction);
+
+    std::forward_list<int> fl(10);
+    CHECK(pl::analyze_locality(fl.begin(), fl.end()).hops == 9);
+}
+
+} // namespace
+
+int main() {
+    test_empty_and_single();
+    test_dense_nodes();
+    test_steady_stride_within_page();
+    test_backward_and_scattered();
+    test_limits();
+    test_cache_geometry_options();
+    test_real_lists();
+    return check::exit_code();
+}
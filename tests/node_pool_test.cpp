@@ -0,0 +1,170 @@
+#include <p_linked_list/node_pool.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+constexpr std::size_t slab_size = 64 * 1024;
+
+std::uintptr_t slab_of(void* p) { return reinterpret_cast<std::uintptr_t>(p) & ~(slab_size - 1); }
+
+void test_allocate_free_trim() {
+    pl::node_pool pool(40, slab_size);
+    CHECK(pool.node_size() >= 40);
+    std::vector<void*> nodes;
+    for (int i = 0; i < 100000; ++i) {
+        void* p = pool.allocate();
+        std::memset(p, 0xab, 40);
+        nodes.push_back(p);
+    }
+    auto st = pool.stats();
+    CHECK(st.nodes_in_use == 100000);
+    CHECK(st.slabs * slab_size == st.mapped_bytes);
+    CHECK(st.resident_bytes == st.mapped_bytes);
+
+    std::shuffle(nodes.begin(), nodes.end(), std::mt19937(1));
+    for (void* p : nodes)
+        pool.deallocate(p);
+    nodes.clear();
+    st = pool.stats();
+    CHECK(st.nodes_in_use == 0);
+    CHECK(st.empty_slabs == st.slabs);
+
+    const std::size_t before = st.slabs;
+    const std::size_t released = pool.trim({2});
+    st = pool.stats();
+    CHECK(st.slabs == 2);
+    CHECK(released >= (before - 2) * slab_size);
+    // The kept slabs are madvised down to their header page.
+    CHECK(st.resident_bytes < st.mapped_bytes);
+    CHECK(pool.trim({2}) == 0);
+
+    // A madvised slab is reused and comes back as resident.
+    void* p = pool.allocate();
+    std::memset(p, 1, 40);
+    CHECK(pool.stats().slabs == 2);
+    pool.deallocate(p);
+}
+
+void test_prefers_fullest_slab() {
+    // Fill two slabs, a and b, then leave a about 90% used and b about 10%.
+    pl::node_pool pool(64, slab_size);
+    std::vector<void*> a, b;
+    void* p0 = pool.allocate();
+    a.push_back(p0);
+    for (;;) {
+        void* p = pool.allocate();
+        if (slab_of(p) != slab_of(p0)) {
+            b.push_back(p);
+            break;
+        }
+        a.push_back(p);
+    }
+    while (b.size() < a.size())
+        b.push_back(pool.allocate());
+    for (std::size_t i = 0; i < a.size() / 10; ++i) {
+        pool.deallocate(a.back());
+        a.pop_back();
+    }
+    while (b.size() > a.size() / 9) {
+        pool.deallocate(b.back());
+        b.pop_back();
+    }
+    for (int i = 0; i < 10; ++i) {
+        void* p = pool.allocate();
+        CHECK(slab_of(p) == slab_of(a.front()));
+        a.push_back(p);
+    }
+    for (void* p : a)
+        pool.deallocate(p);
+    for (void* p : b)
+        pool.deallocate(p);
+    CHECK(pool.stats().nodes_in_use == 0);
+}
+
+void test_trimmer() {
+    pl::node_pool pool(48, slab_size);
+    std::vector<void*> nodes;
+    for (int i = 0; i < 5000; ++i)
+        nodes.push_back(pool.allocate());
+    for (void* p : nodes)
+        pool.deallocate(p);
+    CHECK(pool.stats().slabs > 0);
+    {
+        pl::pool_trimmer trimmer(pool, std::chrono::milliseconds(5), {0});
+        for (int i = 0; i < 200 && pool.stats().slabs != 0; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    CHECK(pool.stats().slabs == 0);
+}
+
+void test_pool_allocator() {
+    pl::node_pool pool(64, slab_size);
+    {
+        std::list<std::string, pl::pool_allocator<std::string>> l{pl::pool_allocator<std::string>(pool)};
+        for (int i = 0; i < 1000; ++i)
+            l.push_back("abc");
+        CHECK(pool.stats().nodes_in_use == 1000);
+        l.pop_front();
+        CHECK(pool.stats().nodes_in_use == 999);
+    }
+    CHECK(pool.stats().nodes_in_use == 0);
+
+    // Requests that do not fit a node bypass the pool.
+    pl::pool_allocator<char> big(pool);
+    char* p = big.allocate(4096);
+    CHECK(pool.stats().nodes_in_use == 0);
+    big.deallocate(p, 4096);
+}
+
+void test_concurrent() {
+    pl::node_pool pool(32, slab_size);
+    {
+        pl::pool_trimmer trimmer(pool, std::chrono::milliseconds(1), {0});
+        std::vector<std::jthread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&pool, t] {
+                std::mt19937 rng(static_cast<unsigned>(t));
+                std::vector<void*> mine;
+                for (int i = 0; i < 50000; ++i) {
+                    if (mine.empty() || rng() % 3) {
+                        auto* p = static_cast<std::uint64_t*>(pool.allocate());
+                        *p = static_cast<std::uint64_t>(t);
+                        mine.push_back(p);
+                    } else {
+                        auto* p = static_cast<std::uint64_t*>(mine.back());
+                        CHECK(*p == static_cast<std::uint64_t>(t));
+                        pool.deallocate(p);
+                        mine.pop_back();
+                    }
+                }
+                for (void* p : mine)
+                    pool.deallocate(p);
+            });
+        }
+    }
+    CHECK(pool.stats().nodes_in_use == 0);
+}
+
+} // namespace
+
+int main() {
+    test_allocate_free_trim();
+    test_prefers_fullest_slab();
+    test_trimmer();
+    test_pool_allocator();
+    test_concurrent();
+    return check::exit_code();
+}
@@ -0,0 +1,184 @@
+#include <p_linked_list/observer_list.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// Counts live callback states, so the tests can see removed listeners
+// being freed.
+struct counted {
+    static inline std::atomic<int> live{0};
+    counted() { ++live; }
+    counted(const counted&) { ++live; }
+    ~counted() { --live; }
+};
+
+void test_add_emit_remove() {
+    pl::observer_list<int, int> list;
+    std::vector<int> calls;
+    auto a = list.add([&](int x, int y) { calls.push_back(x + y); });
+    auto b = list.add([&](int x, int y) { calls.push_back(x * y); });
+    CHECK(a != b && list.size() == 2);
+    list.emit(3, 4);
+    CHECK((calls == std::vector<int>{12, 7}));  // newest first
+    CHECK(list.remove(b) && !list.remove(b) && !list.remove(12345));
+    calls.clear();
+    list.emit(3, 4);
+    CHECK((calls == std::vector<int>{7}));
+    CHECK(list.remove(a) && list.empty());
+    list.emit(1, 1);
+    CHECK(calls.size() == 1);
+}
+
+void test_remove_from_callback() {
+    pl::observer_list<> list;
+    int first = 0, second = 0, third = 0;
+    pl::observer_list<>::id self = 0, later = 0;
+    later = list.add([&] { ++third; });
+    self = list.add([&] {
+        ++second;
+        list.remove(self);   // itself, while standing on its node
+        list.remove(later);  // and one the walk has not reached yet
+    });
+    list.add([&] { ++first; });
+    list.emit();
+    CHECK(first == 1 && second == 1 && third == 0);
+    list.emit();
+    CHECK(first == 2 && second == 1 && third == 0 && list.size() == 1);
+}
+
+void test_add_and_emit_from_callback() {
+    pl::observer_list<int> list;
+    int depth_calls = 0, added_calls = 0;
+    list.add([&](int depth) {
+        ++depth_calls;
+        if (depth < 3)
+            list.emit(depth + 1);
+    });
+    list.add([&](int depth) {
+        if (depth == 0)
+            list.add([&](int) { ++added_calls; });
+    });
+    list.emit(0);
+    CHECK(depth_calls == 4);
+    // The listener added mid-emission is the new head, so the walk already
+    // in progress does not see it.
+    const int before = added_calls;
+    list.emit(10);
+    CHECK(added_calls == before + 1);
+}
+
+void test_exception_propagates() {
+    pl::observer_list<> list;
+    int after = 0;
+    list.add([&] { ++after; });
+    auto thrower = list.add([] { throw std::runtime_error("listener"); });
+    CHECK_THROWS(std::runtime_error, list.emit());
+    CHECK(after == 0);
+    // The emission unregistered on the way out: removal and reclamation
+    // still work.
+    CHECK(list.remove(thrower));
+    list.emit();
+    CHECK(after == 1);
+}
+
+void test_removed_listeners_are_freed() {
+    counted::live = 0;
+    {
+        pl::observer_list<> list;
+        std::vector<pl::observer_list<>::id> ids;
+        for (int i = 0; i < 10; ++i)
+            ids.push_back(list.add([c = counted()] {}));
+        CHECK(counted::live == 10);
+        for (int i = 0; i < 6; ++i)
+            list.remove(ids[static_cast<std::size_t>(i)]);
+        // With no emitter running, the grace period passes after at most
+        // two reclaim passes: one to close the epoch, one to free it.
+        list.try_reclaim();
+        list.try_reclaim();
+        CHECK(counted::live == 4);
+        list.emit();
+        list.remove(ids[6]);
+    }
+    CHECK(counted::live == 0);
+}
+
+// Emitters run constantly while other threads add and remove listeners.
+// A node freed while an emitter can still reach it shows up under
+// AddressSanitizer; a call to a listener whose remove() had returned before
+// the emission started is counted as a violation.
+void test_concurrent_stress() {
+    struct state {
+        std::atomic<std::uint64_t> removed_at{0};
+        std::atomic<int> calls{0};
+    };
+    pl::observer_list<std::uint64_t> list;
+    std::atomic<std::uint64_t> removals{0};
+    std::atomic<bool> stop{false};
+    std::atomic<int> violations{0};
+
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&] {
+            while (!stop.load()) {
+                // Every removal counted here finished before the walk began.
+                list.emit(removals.load());
+            }
+        });
+    }
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([&, t] {
+            std::mt19937 rng(static_cast<unsigned>(t));
+            std::vector<std::pair<pl::observer_list<std::uint64_t>::id, std::shared_ptr<state>>> mine;
+            for (int i = 0; i < 20000; ++i) {
+                if (mine.size() < 20 && rng() % 2) {
+                    auto s = std::make_shared<state>();
+                    auto id = list.add([s, &violations](std::uint64_t seen) {
+                        const std::uint64_t at = s->removed_at.load();
+                        if (at != 0 && at <= seen)
+                            ++violations;
+                        ++s->calls;
+                    });
+                    mine.emplace_back(id, std::move(s));
+                } else if (!mine.empty()) {
+                    const std::size_t k = rng() % mine.size();
+                    CHECK(list.remove(mine[k].first));
+                    mine[k].second->removed_at.store(removals.fetch_add(1) + 1);
+                    mine[k] = std::move(mine.back());
+                    mine.pop_back();
+                }
+            }
+            for (auto& [id, s] : mine)
+                CHECK(list.remove(id));
+        });
+    }
+    threads[3].join();
+    threads[4].join();
+    stop.store(true);
+    threads.clear();
+    CHECK(violations.load() == 0);
+    CHECK(list.empty());
+}
+
+} // namespace
+
+int main() {
+    test_add_emit_remove();
+    test_remove_from_callback();
+    test_add_and_emit_from_callback();
+    test_exception_propagates();
+    test_removed_listeners_are_freed();
+    test_concurrent_stress();
+    return check::exit_code();
+}
@@ -0,0 +1,117 @@
+#include <p_linked_list/poly_list.hpp>
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+int live = 0;
+
+struct shape {
+    shape() { ++live; }
+    virtual ~shape() { --live; }
+    virtual double area() const = 0;
+};
+
+struct square : shape {
+    explicit square(double side) : s(side) {}
+    double area() const override { return s * s; }
+    double s;
+};
+
+struct alignas(32) big : shape {
+    explicit big(std::string n) : name(std::move(n)) {}
+    double area() const override { return 1; }
+    std::string name;
+    double v[8]{};
+};
+
+struct throws : shape {
+    throws() { throw std::runtime_error("ctor"); }
+    double area() const override { return 0; }
+};
+
+void test_dispatch_and_visit() {
+    {
+        pl::poly_list<shape> l(256);
+        for (int i = 0; i < 100; ++i) {
+            l.emplace_back<square>(2);
+            l.emplace_back<big>(std::string(40, 'x'));
+        }
+        l.emplace_front<square>(3);
+        CHECK(l.size() == 201);
+        CHECK(live == 201);
+        CHECK(l.front().area() == 9);
+        CHECK(l.back().area() == 1);
+
+        double total = 0;
+        for (auto& s : l)
+            total += s.area();
+        CHECK(total == 9 + 100 * 4 + 100);
+
+        int squares = 0, bigs = 0, others = 0;
+        l.visit<square, big>([&](auto& x) {
+            using T = std::decay_t<decltype(x)>;
+            if constexpr (std::is_same_v<T, square>) {
+                ++squares;
+            } else if constexpr (std::is_same_v<T, big>) {
+                ++bigs;
+                CHECK(reinterpret_cast<std::uintptr_t>(&x) % 32 == 0);
+                CHECK(x.name.size() == 40);
+            } else {
+                ++others;
+            }
+        });
+        CHECK(squares == 101);
+        CHECK(bigs == 100);
+        CHECK(others == 0);
+
+        int as_base = 0;
+        l.visit<square>([&](auto& x) {
+            if constexpr (std::is_same_v<std::decay_t<decltype(x)>, shape>)
+                ++as_base;
+        });
+        CHECK(as_base == 100);
+
+        CHECK(l.begin().get_if<square>() != nullptr);
+        CHECK(l.begin().get_if<square>()->s == 3);
+        CHECK(l.begin().get_if<big>() == nullptr);
+
+        l.pop_front();
+        CHECK(l.size() == 200);
+        CHECK(live == 200);
+        l.clear();
+        CHECK(l.empty());
+        CHECK(live == 0);
+        l.emplace_back<big>("again");
+        CHECK(l.size() == 1);
+    }
+    CHECK(live == 0);
+}
+
+void test_throwing_constructor() {
+    pl::poly_list<shape> l;
+    l.emplace_back<square>(1);
+    CHECK_THROWS(std::runtime_error, l.emplace_back<throws>());
+    CHECK(l.size() == 1);
+    CHECK(live == 1);
+    int n = 0;
+    for (auto& s : l)
+        n += s.area() == 1;
+    CHECK(n == 1);
+}
+
+} // namespace
+
+int main() {
+    test_dispatch_and_visit();
+    test_throwing_constructor();
+    CHECK(live == 0);
+    return check::exit_code();
+}
@@ -0,0 +1,152 @@
+#include <p_linked_list/priority_queue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+void test_strict_priority_and_fifo_lanes() {
+    pl::priority_mpmc_queue<int, 4> q;
+    CHECK(q.empty());
+    CHECK(!q.try_pop());
+    for (int i = 0; i < 10; ++i)
+        q.push(100 + i, 3);
+    for (int i = 0; i < 10; ++i)
+        q.push(i, 0);
+    q.push(50, 1);
+    std::size_t p = 99;
+    for (int i = 0; i < 10; ++i) {
+        auto v = q.try_pop(&p);
+        CHECK(v && *v == i && p == 0);
+    }
+    CHECK(q.try_pop(&p) == 50 && p == 1);
+    for (int i = 0; i < 10; ++i) {
+        CHECK(q.size_approx(3) == static_cast<std::size_t>(10 - i));
+        CHECK(q.try_pop(&p) == 100 + i && p == 3);
+    }
+    CHECK(q.empty());
+    CHECK(!q.try_pop());
+}
+
+void test_priority_out_of_range() {
+    pl::priority_mpmc_queue<int, 4> q;
+    CHECK_THROWS(std::out_of_range, q.push(1, 4));
+    CHECK_THROWS(std::out_of_range, q.push(1, 1000));
+    CHECK(q.empty());
+    q.push(1, 3);
+    CHECK(q.try_pop() == 1);
+}
+
+// Draining with successful pops only, so no failed pop has cleared the lane
+// bits, must still leave the queue empty.
+void test_empty_after_drain() {
+    pl::priority_mpmc_queue<int, 8> q;
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 40; ++i)
+            q.push(i, static_cast<std::size_t>(i) % 8);
+        CHECK(!q.empty());
+        for (int i = 0; i < 40; ++i)
+            CHECK(q.try_pop());
+        CHECK(q.empty());
+    }
+}
+
+void test_aging_serves_low_lanes() {
+    pl::priority_mpmc_queue<int, 2> strict;
+    pl::priority_mpmc_queue<int, 2> aged(4);
+    for (int i = 0; i < 100; ++i) {
+        strict.push(0, 0);
+        aged.push(0, 0);
+    }
+    strict.push(1, 1);
+    aged.push(1, 1);
+    auto low_served_within = [](auto& q, int pops) {
+        for (int i = 0; i < pops; ++i) {
+            std::size_t p = 0;
+            if (q.try_pop(&p) && p == 1)
+                return true;
+        }
+        return false;
+    };
+    CHECK(!low_served_within(strict, 20));
+    CHECK(low_served_within(aged, 20));
+}
+
+void test_node_reuse() {
+    pl::priority_mpmc_queue<std::uint64_t, 1> q;
+    for (std::uint64_t round = 0; round < 1000; ++round) {
+        for (std::uint64_t i = 0; i < 100; ++i)
+            q.push(round * 100 + i, 0);
+        bool ok = true;
+        for (std::uint64_t i = 0; i < 100; ++i)
+            ok = ok && q.try_pop() == round * 100 + i;
+        CHECK(ok);
+    }
+    CHECK(q.empty());
+}
+
+// Values encode (producer, lane, sequence); each consumer checks that it
+// sees every (producer, lane) stream in increasing order, and together they
+// must see every value exactly once.
+void test_concurrent_producers_and_consumers() {
+    constexpr unsigned producers = 4, consumers = 4, lanes = 4;
+    constexpr std::uint64_t per_producer = 50000;
+    pl::priority_mpmc_queue<std::uint64_t, lanes> q;
+    std::vector<std::atomic<std::uint8_t>> seen(producers * per_producer);
+    std::atomic<unsigned> done{0};
+    std::atomic<bool> order_ok{true};
+    {
+        std::vector<std::jthread> threads;
+        for (unsigned p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p] {
+                for (std::uint64_t i = 0; i < per_producer; ++i)
+                    q.push(std::uint64_t(p) << 32 | i, i % lanes);
+                done.fetch_add(1);
+            });
+        }
+        for (unsigned c = 0; c < consumers; ++c) {
+            threads.emplace_back([&] {
+                std::vector<std::int64_t> last(producers * lanes, -1);
+                for (;;) {
+                    std::size_t lane = 0;
+                    auto v = q.try_pop(&lane);
+                    if (!v) {
+                        if (done.load() == producers && q.empty())
+                            break;
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    const auto p = static_cast<unsigned>(*v >> 32);
+                    const auto i = static_cast<std::int64_t>(*v & 0xffffffffu);
+                    if (lane != static_cast<std::size_t>(i) % lanes || i <= last[p * lanes + lane])
+                        order_ok.store(false);
+                    last[p * lanes + lane] = i;
+                    seen[p * per_producer + static_cast<std::uint64_t>(i)].fetch_add(1);
+                }
+            });
+        }
+    }
+    CHECK(order_ok.load());
+    CHECK(std::all_of(seen.begin(), seen.end(), [](auto& s) { return s.load() == 1; }));
+    CHECK(q.empty());
+}
+
+} // namespace
+
+int main() {
+    test_strict_priority_and_fifo_lanes();
+    test_priority_out_of_range();
+    test_empty_after_drain();
+    test_aging_serves_low_lanes();
+    test_node_reuse();
+    test_concurrent_producers_and_consumers();
+    return check::exit_code();
+}
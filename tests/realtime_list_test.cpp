@@ -0,0 +1,176 @@
+#include <p_linked_list/realtime_list.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <list>
+#include <random>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+template <class T>
+std::vector<T> items(const pl::realtime_list<T>& l) {
+    return {l.begin(), l.end()};
+}
+
+// Counts live instances, to check clear() and the destructor destroy every
+// element of a non-trivial type.
+struct counted {
+    static inline int live = 0;
+    int v;
+    explicit counted(int x) noexcept : v(x) { ++live; }
+    counted(const counted& o) noexcept : v(o.v) { ++live; }
+    ~counted() { --live; }
+};
+
+static_assert(noexcept(std::declval<pl::realtime_list<int>&>().push_back(1)));
+static_assert(noexcept(std::declval<pl::realtime_list<int>&>().erase({})));
+static_assert(noexcept(std::declval<pl::realtime_list<int>&>().clear()));
+
+void test_basic() {
+    pl::realtime_list<int> l(8);
+    CHECK(l.empty() && l.capacity() == 8 && !l.full());
+    CHECK(l.push_back(2) && l.push_back(3) && l.push_front(1));
+    CHECK(items(l) == std::vector<int>{1, 2, 3});
+    CHECK(l.front() == 1 && l.back() == 3 && l.size() == 3);
+    auto it = l.emplace(std::next(l.begin()), 7);
+    CHECK(*it == 7);
+    CHECK(items(l) == std::vector<int>{1, 7, 2, 3});
+    it = l.erase(it);
+    CHECK(*it == 2);
+    l.pop_front();
+    l.pop_back();
+    CHECK(items(l) == std::vector<int>{2});
+    CHECK(std::prev(l.end()) == l.begin());
+}
+
+void test_full_path() {
+    pl::realtime_list<int> l(3);
+    for (int i = 0; i < 3; ++i)
+        CHECK(l.emplace_back(i));
+    CHECK(l.full());
+    CHECK(!l.push_back(9) && !l.push_front(9));
+    CHECK(l.emplace(l.begin(), 9) == l.end());
+    CHECK(items(l) == std::vector<int>{0, 1, 2});
+    l.erase(std::next(l.begin()));
+    CHECK(!l.full() && l.push_front(5));
+    CHECK(items(l) == std::vector<int>{5, 0, 2});
+}
+
+void test_zero_capacity() {
+    pl::realtime_list<int> l(0);
+    CHECK(l.full() && l.empty());
+    CHECK(!l.push_back(1));
+    l.clear();
+    CHECK(l.begin() == l.end());
+}
+
+void test_splice() {
+    pl::realtime_list<int> l(8);
+    for (int i = 0; i < 5; ++i)
+        (void)l.push_back(i);
+    l.splice(l.begin(), std::prev(l.end()));  // move 4 to the front
+    CHECK(items(l) == std::vector<int>{4, 0, 1, 2, 3});
+    l.splice(l.end(), l.begin());  // and back again
+    CHECK(items(l) == std::vector<int>{0, 1, 2, 3, 4});
+    auto two = std::next(l.begin(), 2);
+    l.splice(std::next(two), two);  // already in place
+    l.splice(two, two);
+    CHECK(items(l) == std::vector<int>{0, 1, 2, 3, 4});
+    CHECK(l.size() == 5);
+}
+
+void test_model() {
+    std::mt19937 rng(1);
+    const std::size_t cap = 64;
+    pl::realtime_list<int> l(cap);
+    std::list<int> m;
+    for (int step = 0; step < 100000; ++step) {
+        const unsigned op = rng() % 6;
+        const int v = static_cast<int>(rng() % 1000);
+        if (op < 2) {
+            bool ok = op == 0 ? l.push_back(v) : l.push_front(v);
+            CHECK(ok == (m.size() < cap));
+            if (ok)
+                op == 0 ? m.push_back(v) : m.push_front(v);
+        } else if (op == 2 && !m.empty()) {
+            l.pop_front();
+            m.pop_front();
+        } else if (op == 3 && !m.empty()) {
+            l.pop_back();
+            m.pop_back();
+        } else if (op == 4 && !m.empty()) {
+            const std::size_t k = rng() % m.size();
+            l.erase(std::next(l.begin(), static_cast<std::ptrdiff_t>(k)));
+            m.erase(std::next(m.begin(), static_cast<std::ptrdiff_t>(k)));
+        } else if (op == 5 && rng() % 50 == 0) {
+            l.clear();
+            m.clear();
+        }
+        if (step % 97 == 0)
+            CHECK(std::equal(l.begin(), l.end(), m.begin(), m.end()));
+    }
+    CHECK(l.size() == m.size() && l.full() == (m.size() == cap));
+}
+
+void test_non_trivial_elements() {
+    {
+        pl::realtime_list<counted> l(16);
+        for (int i = 0; i < 10; ++i)
+            (void)l.emplace_back(i);
+        CHECK(counted::live == 10);
+        l.erase(l.begin());
+        CHECK(counted::live == 9);
+        l.clear();
+        CHECK(counted::live == 0);
+        for (int i = 0; i < 16; ++i)
+            (void)l.emplace_back(i);
+        CHECK(l.full() && counted::live == 16);
+    }
+    CHECK(counted::live == 0);
+}
+
+void test_clear_reuses_every_node() {
+    pl::realtime_list<std::uint64_t> l(100);
+    for (int round = 0; round < 3; ++round) {
+        for (std::uint64_t i = 0; i < 100; ++i)
+            CHECK(l.push_back(i));
+        CHECK(l.full());
+        l.clear();
+        CHECK(l.empty() && !l.full());
+    }
+}
+
+void test_lock_memory() {
+    // mlock may be refused by RLIMIT_MEMLOCK; that must surface as
+    // system_error from the constructor, not later.
+    try {
+        pl::realtime_list<int> l(1024, {.lock_memory = true});
+        CHECK(l.push_back(1) && l.front() == 1);
+    } catch (const std::system_error& e) {
+        CHECK(e.code().value() == EPERM || e.code().value() == ENOMEM || e.code().value() == EAGAIN);
+    }
+}
+
+} // namespace
+
+int main() {
+    test_basic();
+    test_full_path();
+    test_zero_capacity();
+    test_splice();
+    test_model();
+    test_non_trivial_elements();
+    test_clear_reuses_every_node();
+    test_lock_memory();
+    return check::exit_code();
+}
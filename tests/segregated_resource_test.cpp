@@ -0,0 +1,262 @@
+#include <p_linked_list/segregated_resource.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// Upstream that counts the bytes and blocks it has outstanding.
+class counting_resource : public std::pmr::memory_resource {
+public:
+    std::atomic<std::size_t> bytes{0};
+    std::atomic<std::size_t> blocks{0};
+
+private:
+    void* do_allocate(std::size_t n, std::size_t a) override {
+        void* p = std::pmr::new_delete_resource()->allocate(n, a);
+        bytes += n;
+        ++blocks;
+        return p;
+    }
+    void do_deallocate(void* p, std::size_t n, std::size_t a) override {
+        std::pmr::new_delete_resource()->deallocate(p, n, a);
+        bytes -= n;
+        --blocks;
+    }
+    bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+};
+
+struct block {
+    unsigned char* p;
+    std::size_t size;
+    std::size_t align;
+    unsigned char fill;
+};
+
+bool intact(const block& b) {
+    for (std::size_t i = 0; i < b.size; ++i) {
+        if (b.p[i] != b.fill)
+            return false;
+    }
+    return true;
+}
+
+void test_small_classes() {
+    counting_resource up;
+    {
+        pl::segregated_resource r(&up);
+        std::vector<block> live;
+        for (std::size_t size = 1; size <= 1024; ++size) {
+            for (std::size_t align : {1, 8, 16}) {
+                auto* p = static_cast<unsigned char*>(r.allocate(size, align));
+                CHECK(reinterpret_cast<std::uintptr_t>(p) % align == 0);
+                const auto fill = static_cast<unsigned char>(size * 3 + align);
+                std::memset(p, fill, size);
+                live.push_back({p, size, align, fill});
+            }
+        }
+        bool ok = true;
+        for (auto& b : live) {
+            ok = ok && intact(b);
+            r.deallocate(b.p, b.size, b.align);
+        }
+        CHECK(ok);
+        // Freed small blocks are reused rather than taken from new spans.
+        const std::size_t before = up.bytes.load();
+        for (auto& b : live)
+            b.p = static_cast<unsigned char*>(r.allocate(b.size, b.align));
+        CHECK(up.bytes.load() == before);
+        for (auto& b : live)
+            r.deallocate(b.p, b.size, b.align);
+    }
+    CHECK(up.bytes.load() == 0 && up.blocks.load() == 0);
+}
+
+// Payloads are filled with all-ones words, which would read as set flag bits
+// if the allocator ever mistook payload for a boundary tag.
+void test_large_blocks_coalesce_and_return_arenas() {
+    counting_resource up;
+    pl::segregated_resource r(&up, 1 << 16);
+    CHECK(up.bytes.load() == 0);
+
+    auto* a = static_cast<unsigned char*>(r.allocate(2000, 16));
+    auto* b = static_cast<unsigned char*>(r.allocate(2000, 16));
+    CHECK(up.blocks.load() == 1);
+    std::memset(a, 0xff, 2000);
+    std::memset(b, 0xff, 2000);
+    // Freeing the second block leaves one free block running into the
+    // epilogue, but it does not start the arena, so the arena stays.
+    r.deallocate(b, 2000, 16);
+    CHECK(up.blocks.load() == 1);
+    CHECK(intact({a, 2000, 16, 0xff}));
+    b = static_cast<unsigned char*>(r.allocate(2000, 16));
+    std::memset(b, 0xff, 2000);
+    r.deallocate(a, 2000, 16);
+    CHECK(up.blocks.load() == 1);
+    CHECK(intact({b, 2000, 16, 0xff}));
+    // Now the whole arena coalesces into one block and goes back upstream.
+    r.deallocate(b, 2000, 16);
+    CHECK(up.blocks.load() == 0);
+}
+
+void test_random_large_trace() {
+    counting_resource up;
+    {
+        pl::segregated_resource r(&up, 1 << 18);
+        std::mt19937 rng(5);
+        std::vector<block> live;
+        bool ok = true;
+        for (int step = 0; step < 200000; ++step) {
+            if (live.empty() || (live.size() < 2000 && rng() % 2)) {
+                const std::size_t size = 1025 + rng() % 16000;
+                auto* p = static_cast<unsigned char*>(r.allocate(size, 16));
+                ok = ok && reinterpret_cast<std::uintptr_t>(p) % 16 == 0;
+                const auto fill = static_cast<unsigned char>(rng() % 2 ? 0xff : rng());
+                std::memset(p, fill, size);
+                live.push_back({p, size, 16, fill});
+            } else {
+                const std::size_t i = rng() % live.size();
+                ok = ok && intact(live[i]);
+                r.deallocate(live[i].p, live[i].size, 16);
+                live[i] = live.back();
+                live.pop_back();
+            }
+        }
+        CHECK(ok);
+        for (auto& b : live)
+            r.deallocate(b.p, b.size, 16);
+        // Every arena is entirely free again and has been returned.
+        CHECK(up.blocks.load() == 0);
+    }
+    CHECK(up.bytes.load() == 0);
+}
+
+void test_upstream_pass_through() {
+    counting_resource up;
+    pl::segregated_resource r(&up, 1 << 16);
+    CHECK(r.upstream_resource() == &up);
+    CHECK(r.is_equal(r));
+    pl::segregated_resource other(&up);
+    CHECK(!r.is_equal(other));
+
+    void* big = r.allocate(1 << 20, 16);
+    CHECK(up.bytes.load() == std::size_t(1) << 20);
+    r.deallocate(big, 1 << 20, 16);
+    void* aligned = r.allocate(64, 64);
+    CHECK(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+    CHECK(up.bytes.load() == 64);
+    r.deallocate(aligned, 64, 64);
+    CHECK(up.bytes.load() == 0);
+}
+
+void test_arena_size_checked() {
+    counting_resource up;
+    for (std::size_t bad : {std::size_t(0), std::size_t(8), std::size_t(80), std::size_t(1000),
+                            (std::size_t(1) << 16) + 8})
+        CHECK_THROWS(std::invalid_argument, pl::segregated_resource(&up, bad));
+    {
+        // The smallest arena that fits its header, one block and the epilogue.
+        pl::segregated_resource tiny(&up, 96);
+        void* p = tiny.allocate(24, 16);
+        tiny.deallocate(p, 24, 16);
+    }
+    CHECK(up.blocks.load() == 0);
+    // large_limit() is just above the small classes, so the largest medium
+    // request takes a fresh arena, which goes back upstream with it.
+    pl::segregated_resource r(&up, 4112);
+    auto* q = static_cast<unsigned char*>(r.allocate(1028, 16));
+    CHECK(up.blocks.load() == 1);
+    std::memset(q, 0xff, 1028);
+    r.deallocate(q, 1028, 16);
+    CHECK(up.blocks.load() == 0);
+}
+
+void test_as_list_allocator() {
+    pl::segregated_resource r;
+    std::pmr::list<std::pmr::string> l(&r);
+    for (int i = 0; i < 10000; ++i)
+        l.emplace_back(static_cast<std::size_t>(i % 3000), 'x');
+    std::size_t total = 0;
+    for (auto& s : l)
+        total += s.size();
+    CHECK(total == 10000u / 3000 * (2999u * 3000 / 2) + 999u * 1000 / 2);
+    l.clear();
+}
+
+// Blocks are allocated on one thread and freed on another, mixing small
+// and large sizes.
+void test_threads() {
+    counting_resource up;
+    {
+        pl::segregated_resource r(&up, 1 << 18);
+        constexpr int threads = 4;
+        std::vector<std::vector<block>> handoff(threads);
+        std::atomic<bool> ok{true};
+        {
+            std::vector<std::jthread> workers;
+            for (int t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    std::mt19937 rng(static_cast<unsigned>(t));
+                    std::vector<block> mine;
+                    for (int i = 0; i < 50000; ++i) {
+                        if (mine.empty() || rng() % 2) {
+                            const std::size_t size = rng() % 4 ? 1 + rng() % 1024 : 1025 + rng() % 8000;
+                            auto* p = static_cast<unsigned char*>(r.allocate(size, 16));
+                            const auto fill = static_cast<unsigned char>(t * 50 + i);
+                            std::memset(p, fill, size);
+                            mine.push_back({p, size, 16, fill});
+                        } else {
+                            const std::size_t j = rng() % mine.size();
+                            if (!intact(mine[j]))
+                                ok.store(false);
+                            r.deallocate(mine[j].p, mine[j].size, 16);
+                            mine[j] = mine.back();
+                            mine.pop_back();
+                        }
+                    }
+                    handoff[t] = std::move(mine);
+                });
+            }
+        }
+        {
+            std::vector<std::jthread> workers;
+            for (int t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    for (auto& b : handoff[(t + 1) % threads]) {
+                        if (!intact(b))
+                            ok.store(false);
+                        r.deallocate(b.p, b.size, 16);
+                    }
+                });
+            }
+        }
+        CHECK(ok.load());
+    }
+    CHECK(up.bytes.load() == 0);
+}
+
+} // namespace
+
+int main() {
+    test_small_classes();
+    test_large_blocks_coalesce_and_return_arenas();
+    test_random_large_trace();
+    test_upstream_pass_through();
+    test_arena_size_checked();
+    test_as_list_allocator();
+    test_threads();
+    return check::exit_code();
+}
@@ -0,0 +1,143 @@
+#include <p_linked_list/seqlock_list.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+struct route {
+    std::uint32_t prefix;
+    std::uint16_t length;
+    std::uint16_t port;
+    std::uint32_t metric;
+};
+
+bool operator==(const route& a, const route& b) {
+    return a.prefix == b.prefix && a.length == b.length && a.port == b.port && a.metric == b.metric;
+}
+
+void test_basic_operations() {
+    pl::seqlock_list<int, 8> l;
+    CHECK(l.empty() && l.snapshot().empty() && l.capacity() == 8);
+    CHECK(l.push_back(2) && l.push_back(3) && l.push_front(1));
+    CHECK((l.snapshot() == std::vector<int>{1, 2, 3}));
+    CHECK(l.find_if([](int x) { return x > 1; }) == 2);
+    CHECK(!l.find_if([](int x) { return x > 3; }));
+    for (int i = 4; i <= 8; ++i)
+        CHECK(l.push_back(i));
+    CHECK(!l.push_back(9) && !l.push_front(0));
+    CHECK(l.size() == 8);
+
+    CHECK(l.erase_if([](int x) { return x % 2 == 0; }) == 4);
+    CHECK((l.snapshot() == std::vector<int>{1, 3, 5, 7}));
+    CHECK(l.erase_if([](int) { return false; }) == 0);
+    // The tail is fixed up when the last element goes.
+    CHECK(l.erase_if([](int x) { return x == 7; }) == 1);
+    CHECK(l.push_back(10));
+    CHECK((l.snapshot() == std::vector<int>{1, 3, 5, 10}));
+
+    const std::vector<int> too_many(9, 1);
+    CHECK(!l.assign(too_many.begin(), too_many.end()));
+    CHECK(l.size() == 4);
+    const std::vector<int> fresh{9, 8, 7, 6, 5, 4, 3, 2};
+    CHECK(l.assign(fresh.begin(), fresh.end()));
+    CHECK(l.snapshot() == fresh);
+    l.clear();
+    CHECK(l.empty() && l.snapshot().empty());
+    CHECK(l.push_front(1) && l.snapshot() == std::vector<int>{1});
+}
+
+void test_odd_sized_values() {
+    static_assert(sizeof(route) == 12);
+    pl::seqlock_list<route, 4> l;
+    l.push_back({0x0a000000, 8, 1, 10});
+    l.push_back({0xc0a80000, 16, 2, 20});
+    auto r = l.find_if([](const route& x) { return x.port == 2; });
+    CHECK(r && *r == route{0xc0a80000, 16, 2, 20});
+    CHECK(l.snapshot().front() == route{0x0a000000, 8, 1, 10});
+}
+
+void test_throwing_predicate() {
+    pl::seqlock_list<int, 8> l;
+    for (int i = 0; i < 5; ++i)
+        l.push_back(i);
+    CHECK_THROWS(std::runtime_error, l.erase_if([](int x) {
+        if (x == 3)
+            throw std::runtime_error("predicate failed");
+        return x < 2;
+    }));
+    // Nothing was removed and no write section was left open: readers and
+    // writers both still go through.
+    CHECK((l.snapshot() == std::vector<int>{0, 1, 2, 3, 4}));
+    CHECK(l.size() == 5);
+    CHECK(l.erase_if([](int x) { return x < 2; }) == 2);
+    CHECK((l.snapshot() == std::vector<int>{2, 3, 4}));
+}
+
+// Every list the writer publishes, and every state in between, holds
+// elements of one version numbered 0, 1, 2, ...; readers must never see a
+// mixture of versions or a hole.
+void test_readers_see_consistent_lists() {
+    struct item {
+        std::uint32_t version;
+        std::uint32_t index;
+    };
+    pl::seqlock_list<item, 16> l;
+    std::atomic<bool> stop{false};
+    std::atomic<bool> ok{true};
+    std::atomic<std::uint64_t> reads{0};
+    {
+        std::vector<std::jthread> readers;
+        for (int r = 0; r < 3; ++r) {
+            readers.emplace_back([&] {
+                std::vector<item> snap;
+                while (!stop.load()) {
+                    l.snapshot(snap);
+                    for (std::size_t i = 0; i < snap.size(); ++i) {
+                        if (snap[i].version != snap[0].version || snap[i].index != i)
+                            ok.store(false);
+                    }
+                    if (auto x = l.find_if([](const item& e) { return e.index == 3; }); x && x->index != 3)
+                        ok.store(false);
+                    reads.fetch_add(1);
+                }
+            });
+        }
+        std::vector<item> next;
+        for (std::uint32_t v = 0; v < 20000; ++v) {
+            next.clear();
+            for (std::uint32_t i = 0; i <= v % 16; ++i)
+                next.push_back({v, i});
+            if (v % 3 == 0) {
+                l.assign(next.begin(), next.end());
+            } else if (v % 3 == 1) {
+                l.clear();
+                for (auto& x : next)
+                    l.push_back(x);
+            } else {
+                l.assign(next.begin(), next.end());
+                l.erase_if([](const item& e) { return e.index >= 8; });
+            }
+        }
+        stop.store(true);
+    }
+    CHECK(ok.load());
+    CHECK(reads.load() > 0);
+}
+
+} // namespace
+
+int main() {
+    test_basic_operations();
+    test_odd_sized_values();
+    test_throwing_predicate();
+    test_readers_see_consistent_lists();
+    return check::exit_code();
+}
@@ -0,0 +1,222 @@
+#include <p_linked_list/sorted_list.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <memory_resource>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+template <class List>
+std::vector<typename List::iterator::value_type> items(const List& l) {
+    return {l.begin(), l.end()};
+}
+
+// Counts allocations so a batch can be checked to cost one chunk.
+class counting_resource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+    std::size_t live = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t align) override {
+        ++allocations;
+        ++live;
+        return std::pmr::new_delete_resource()->allocate(bytes, align);
+    }
+    void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+        --live;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+    }
+    bool do_is_equal(const std::pmr::memory_resource& o) const noexcept override { return this == &o; }
+};
+
+// Keyed record: ordered by key only, so equal keys carry distinguishable
+// payloads.
+struct entry {
+    int key;
+    int value;
+};
+
+struct by_key {
+    bool operator()(const entry& a, const entry& b) const { return a.key < b.key; }
+};
+
+void test_single_insert_and_erase() {
+    pl::sorted_list<int> l;
+    for (int v : {5, 1, 4, 1, 3})
+        l.insert(v);
+    CHECK(items(l) == std::vector<int>{1, 1, 3, 4, 5});
+    CHECK(l.size() == 5 && l.front() == 1);
+    CHECK(l.contains(4) && !l.contains(2));
+    CHECK(l.erase(1) && l.erase(1) && !l.erase(1));
+    CHECK(items(l) == std::vector<int>{3, 4, 5});
+    l.pop_front();
+    CHECK(items(l) == std::vector<int>{4, 5});
+    l.clear();
+    CHECK(l.empty() && l.begin() == l.end());
+}
+
+void test_insert_batch_matches_multiset() {
+    std::mt19937 rng(1);
+    pl::sorted_list<int> l;
+    std::multiset<int> model;
+    for (int round = 0; round < 50; ++round) {
+        std::vector<int> batch(rng() % 200);
+        for (int& v : batch)
+            v = static_cast<int>(rng() % 500);
+        l.insert_sorted_batch(batch.begin(), batch.end());
+        model.insert(batch.begin(), batch.end());
+        for (int k = 0; k < 20; ++k) {
+            const int v = static_cast<int>(rng() % 500);
+            auto it = model.find(v);
+            CHECK(l.erase(v) == (it != model.end()));
+            if (it != model.end())
+                model.erase(it);
+        }
+        CHECK(l.size() == model.size());
+        CHECK(std::equal(l.begin(), l.end(), model.begin(), model.end()));
+    }
+}
+
+void test_insert_batch_is_stable() {
+    pl::sorted_list<entry, by_key> l;
+    l.insert({1, 0});
+    l.insert({2, 0});
+    std::vector<entry> batch = {{2, 1}, {1, 1}, {2, 2}, {0, 1}, {1, 2}};
+    l.insert_sorted_batch(batch.begin(), batch.end());
+    std::vector<std::pair<int, int>> got;
+    for (const entry& e : l)
+        got.emplace_back(e.key, e.value);
+    // Existing elements first, then batch elements in batch order.
+    CHECK(got == std::vector<std::pair<int, int>>{{0, 1}, {1, 0}, {1, 1}, {1, 2}, {2, 0}, {2, 1}, {2, 2}});
+}
+
+void test_upsert_matches_map() {
+    std::mt19937 rng(2);
+    pl::sorted_list<entry, by_key> l;
+    std::map<int, int> model;
+    auto add = [](entry& stored, entry&& incoming) { stored.value += incoming.value; };
+    for (int round = 0; round < 100; ++round) {
+        std::vector<entry> batch(rng() % 300);
+        std::size_t fresh = 0;
+        std::map<int, int> before = model;
+        for (entry& e : batch) {
+            e = {static_cast<int>(rng() % 1000), static_cast<int>(rng() % 10)};
+            auto [it, added] = model.try_emplace(e.key, 0);
+            it->second += e.value;
+            fresh += added;
+        }
+        CHECK(l.upsert_sorted_batch(batch.begin(), batch.end(), add) == fresh);
+        if (round % 10 == 9) {
+            for (int k = 0; k < 50; ++k) {
+                int key = static_cast<int>(rng() % 1000);
+                CHECK(l.erase({key, 0}) == (model.erase(key) == 1));
+            }
+        }
+        CHECK(l.size() == model.size());
+        auto it = model.begin();
+        bool same = true;
+        for (const entry& e : l) {
+            same = same && it != model.end() && it->first == e.key && it->second == e.value;
+            ++it;
+        }
+        CHECK(same && it == model.end());
+    }
+}
+
+void test_upsert_default_replaces() {
+    pl::sorted_list<entry, by_key> l;
+    std::vector<entry> a = {{1, 10}, {3, 30}};
+    l.upsert_sorted_batch(a.begin(), a.end());
+    std::vector<entry> b = {{3, 31}, {2, 20}, {3, 32}, {1, 11}};
+    CHECK(l.upsert_sorted_batch(b.begin(), b.end()) == 1);
+    std::vector<std::pair<int, int>> got;
+    for (const entry& e : l)
+        got.emplace_back(e.key, e.value);
+    // Later duplicates within the batch replace earlier ones.
+    CHECK(got == std::vector<std::pair<int, int>>{{1, 11}, {2, 20}, {3, 32}});
+}
+
+void test_batch_allocates_once() {
+    counting_resource mr;
+    {
+        pl::sorted_list<int> l(&mr);
+        std::vector<int> batch(1000);
+        std::iota(batch.begin(), batch.end(), 0);
+        std::shuffle(batch.begin(), batch.end(), std::mt19937(3));
+        l.insert_sorted_batch(batch.begin(), batch.end());
+        CHECK(mr.allocations == 1);
+        // Erased nodes are reused before any new chunk.
+        for (int v = 0; v < 500; ++v)
+            l.erase(v);
+        l.insert_sorted_batch(batch.begin(), batch.begin() + 500);
+        CHECK(mr.allocations == 1);
+        CHECK(l.size() == 1000);
+    }
+    CHECK(mr.live == 0);
+}
+
+void test_input_iterators() {
+    pl::sorted_list<int> l;
+    std::istringstream in("9 3 7 3");
+    l.insert_sorted_batch(std::istream_iterator<int>(in), std::istream_iterator<int>());
+    CHECK(items(l) == std::vector<int>{3, 3, 7, 9});
+}
+
+void test_throwing_merge_leaves_list_valid() {
+    counting_resource mr;
+    {
+        pl::sorted_list<std::string> l(&mr);
+        std::vector<std::string> a = {"a", "c", "e"};
+        l.upsert_sorted_batch(a.begin(), a.end());
+        std::vector<std::string> b = {"b", "c", "d"};
+        auto merge = [](std::string&, std::string&&) { throw std::runtime_error("merge"); };
+        CHECK_THROWS(std::runtime_error, l.upsert_sorted_batch(b.begin(), b.end(), merge));
+        // "b" was linked before the merge of "c" threw; "d" was released.
+        CHECK(items(l) == std::vector<std::string>{"a", "b", "c", "e"});
+        CHECK(l.size() == 4);
+        std::vector<std::string> c = {"d", "f"};
+        l.insert_sorted_batch(c.begin(), c.end());
+        CHECK(items(l) == std::vector<std::string>{"a", "b", "c", "d", "e", "f"});
+    }
+    CHECK(mr.live == 0);
+}
+
+void test_custom_compare() {
+    pl::sorted_list<int, std::greater<int>> l;
+    std::vector<int> batch = {2, 9, 4};
+    l.insert_sorted_batch(batch.begin(), batch.end());
+    l.insert(5);
+    CHECK(items(l) == std::vector<int>{9, 5, 4, 2});
+    CHECK(l.find(4) != l.end() && *l.find(4) == 4);
+}
+
+} // namespace
+
+int main() {
+    test_single_insert_and_erase();
+    test_insert_batch_matches_multiset();
+    test_insert_batch_is_stable();
+    test_upsert_matches_map();
+    test_upsert_default_replaces();
+    test_batch_allocates_once();
+    test_input_iterators();
+    test_throwing_merge_leaves_list_valid();
+    test_custom_compare();
+    return check::exit_code();
+}
@@ -0,0 +1,215 @@
+#include <p_linked_list/sparse_matrix.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// Dense reference; 0 means absent, so tests only store nonzero values.
+using dense = std::vector<std::vector<std::int64_t>>;
+
+bool matches(pl::sparse_matrix<std::int64_t>& m, const dense& d) {
+    const auto& v = m.csr();
+    if (v.row_ptr.size() != d.size() + 1 || v.col_idx.size() != m.nonzeros())
+        return false;
+    std::size_t k = 0;
+    for (std::size_t r = 0; r < d.size(); ++r) {
+        if (v.row_ptr[r] != k)
+            return false;
+        for (std::size_t c = 0; c < d[r].size(); ++c) {
+            if (d[r][c] == 0)
+                continue;
+            if (k >= v.col_idx.size() || v.col_idx[k] != c || v.values[k] != d[r][c])
+                return false;
+            ++k;
+        }
+    }
+    return v.row_ptr[d.size()] == k;
+}
+
+// Every column list must hold the column's entries in row order, linked
+// both ways.
+bool columns_consistent(const pl::sparse_matrix<std::int64_t>& m, const dense& d) {
+    for (std::size_t c = 0; c < m.cols(); ++c) {
+        auto e = m.col_begin(c);
+        decltype(e) prev;
+        for (std::size_t r = 0; r < m.rows(); ++r) {
+            if (d[r][c] == 0)
+                continue;
+            if (!e || e.row() != r || e.col() != c || e.value() != d[r][c] || e.prev_in_col() != prev)
+                return false;
+            prev = e;
+            e = e.next_in_col();
+        }
+        if (e || m.col_last(c) != prev)
+            return false;
+    }
+    return true;
+}
+
+std::vector<std::int64_t> product(const dense& d, const std::vector<std::int64_t>& x) {
+    std::vector<std::int64_t> y(d.size());
+    for (std::size_t r = 0; r < d.size(); ++r) {
+        for (std::size_t c = 0; c < x.size(); ++c)
+            y[r] += d[r][c] * x[c];
+    }
+    return y;
+}
+
+void test_set_find_erase() {
+    pl::sparse_matrix<std::int64_t> m(3, 4);
+    m.set(1, 2, 5);
+    m.set(1, 0, 3);
+    m.set(0, 2, 7);
+    CHECK(m.nonzeros() == 3);
+    CHECK(m.find(1, 2).value() == 5 && !m.find(1, 1) && !m.find(2, 2));
+    auto e = m.row_begin(1);
+    CHECK(e.col() == 0 && e.next_in_row().col() == 2 && !e.next_in_row().next_in_row());
+    CHECK(m.col_begin(2).row() == 0 && m.col_begin(2).next_in_col().row() == 1);
+    m.set(1, 2, 6);  // overwrite
+    CHECK(m.nonzeros() == 3 && m.find(1, 2).value() == 6);
+    m.erase(m.find(1, 0));
+    CHECK(m.nonzeros() == 2 && m.row_begin(1).col() == 2 && !m.row_begin(1).prev_in_row());
+    CHECK_THROWS(std::out_of_range, m.set(3, 0, 1));
+    CHECK_THROWS(std::out_of_range, m.set(0, 4, 1));
+    CHECK_THROWS(std::out_of_range, m.find(3, 0));
+}
+
+void test_cursor_insert() {
+    // Build a diagonal band by appending with cursors, never walking.
+    const std::size_t n = 50;
+    pl::sparse_matrix<std::int64_t> m(n, n);
+    dense d(n, std::vector<std::int64_t>(n));
+    for (std::size_t r = 0; r < n; ++r) {
+        decltype(m.row_last(0)) row_prev;
+        for (std::size_t c = r > 0 ? r - 1 : 0; c <= r + 1 && c < n; ++c) {
+            const auto v = static_cast<std::int64_t>(r * n + c + 1);
+            row_prev = m.insert(r, c, v, row_prev, m.col_last(c));
+            d[r][c] = v;
+        }
+    }
+    CHECK(matches(m, d));
+    CHECK(columns_consistent(m, d));
+}
+
+void test_random_model() {
+    const std::size_t rows = 40, cols = 30;
+    std::mt19937_64 rng(1);
+    pl::sparse_matrix<std::int64_t> m(rows, cols);
+    dense d(rows, std::vector<std::int64_t>(cols));
+    std::vector<std::int64_t> x(cols), y(rows);
+    for (auto& v : x)
+        v = static_cast<std::int64_t>(rng() % 21) - 10;
+    for (int step = 0; step < 20000; ++step) {
+        const std::size_t r = rng() % rows, c = rng() % cols;
+        const auto v = static_cast<std::int64_t>(rng() % 100) + 1;
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            m.set(r, c, v);
+            d[r][c] = v;
+            break;
+        case 2:
+            if (auto e = m.find(r, c)) {
+                m.erase(e);
+                d[r][c] = 0;
+            }
+            break;
+        case 3:
+            if (auto e = m.find(r, c)) {
+                m.update(e, v);
+                d[r][c] = v;
+            }
+            break;
+        }
+        // Check at irregular intervals so refreshes see batches of mixed
+        // dirty rows, including value-only patches to clean rows.
+        if (rng() % 50 == 0) {
+            CHECK(matches(m, d));
+            m.multiply(x, y);
+            CHECK(y == product(d, x));
+        }
+    }
+    CHECK(matches(m, d));
+    CHECK(columns_consistent(m, d));
+}
+
+void test_update_patches_clean_snapshot() {
+    pl::sparse_matrix<std::int64_t> m(4, 4);
+    for (std::size_t i = 0; i < 4; ++i)
+        m.set(i, 3 - i, static_cast<std::int64_t>(i + 1));
+    const auto* values = m.csr().values.data();
+    m.update(m.find(2, 1), 30);
+    // Same storage, already patched, before any refresh.
+    CHECK(m.csr().values.data() == values && m.csr().values[2] == 30);
+}
+
+void test_node_reuse() {
+    pl::sparse_matrix<std::int64_t> m(100, 100);
+    for (std::size_t i = 0; i < 100; ++i)
+        m.set(i, i, 1);
+    std::vector<const std::int64_t*> before;
+    for (std::size_t i = 0; i < 100; ++i)
+        before.push_back(&m.find(i, i).value());
+    for (std::size_t i = 0; i < 100; ++i)
+        m.erase(m.find(i, i));
+    CHECK(m.nonzeros() == 0 && m.csr().col_idx.empty());
+    for (std::size_t i = 0; i < 100; ++i)
+        m.set(i, 99 - i, 2);
+    std::size_t reused = 0;
+    for (std::size_t i = 0; i < 100; ++i)
+        reused += std::find(before.begin(), before.end(), &m.find(i, 99 - i).value()) != before.end();
+    CHECK(reused == 100);
+}
+
+void test_parallel_multiply() {
+    // Enough nonzeros for several threads, with skewed row lengths so the
+    // split by nonzero count matters.
+    const std::size_t n = 3000;
+    std::mt19937_64 rng(2);
+    pl::sparse_matrix<double> m(n, n);
+    for (std::size_t r = 0; r < n; ++r) {
+        const std::size_t len = r % 100 == 0 ? 800 : 20;
+        for (std::size_t k = 0; k < len; ++k)
+            m.set(r, rng() % n, static_cast<double>(rng() % 7) - 3);
+    }
+    std::vector<double> x(n);
+    for (auto& v : x)
+        v = static_cast<double>(rng() % 9) - 4;
+    std::vector<double> serial(n), parallel(n);
+    m.multiply(x, serial, 1);
+    for (unsigned threads : {2u, 3u, 8u, 0u}) {
+        m.multiply(x, parallel, threads);
+        CHECK(parallel == serial);  // small integers: exact in double
+    }
+    CHECK_THROWS(std::invalid_argument, m.multiply(std::span<const double>(x).first(n - 1), parallel));
+}
+
+void test_empty() {
+    pl::sparse_matrix<double> m(0, 0);
+    CHECK(m.csr().row_ptr.size() == 1 && m.nonzeros() == 0);
+    std::vector<double> none;
+    m.multiply(none, none, 4);
+}
+
+} // namespace
+
+int main() {
+    test_set_find_erase();
+    test_cursor_insert();
+    test_random_model();
+    test_update_patches_clean_snapshot();
+    test_node_reuse();
+    test_parallel_multiply();
+    test_empty();
+    return check::exit_code();
+}
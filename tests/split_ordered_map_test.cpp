@@ -0,0 +1,194 @@
+#include <p_linked_list/split_ordered_map.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+void test_single_thread() {
+    pl::split_ordered_map<int, int> m;
+    const std::size_t initial_buckets = m.bucket_count();
+    for (int i = 0; i < 100000; ++i)
+        CHECK(m.insert(i, i * 2));
+    CHECK(!m.insert(5, 0));
+    CHECK(m.size() == 100000);
+    CHECK(m.bucket_count() > initial_buckets);
+    for (int i = 0; i < 100000; ++i)
+        CHECK(m.find(i) == i * 2);
+    CHECK(!m.find(-1));
+    for (int i = 0; i < 100000; i += 2)
+        CHECK(m.erase(i));
+    CHECK(!m.erase(0));
+    CHECK(m.size() == 50000);
+    for (int i = 0; i < 100000; ++i)
+        CHECK(m.contains(i) == (i % 2 == 1));
+}
+
+void test_string_keys() {
+    pl::split_ordered_map<std::string, std::string> m;
+    CHECK(m.empty());
+    CHECK(m.insert("a", "1"));
+    CHECK(m.insert("b", "2"));
+    CHECK(m.find("a") == std::string("1"));
+    CHECK(m.erase("a"));
+    CHECK(!m.contains("a"));
+    CHECK(m.insert("a", "3"));
+    CHECK(m.find("a") == std::string("3"));
+}
+
+// Colliding hashes share a bucket chain; keys must still be told apart.
+struct bad_hash {
+    std::size_t operator()(int) const noexcept { return 7; }
+};
+
+void test_collisions() {
+    pl::split_ordered_map<int, int, bad_hash> m;
+    for (int i = 0; i < 200; ++i)
+        CHECK(m.insert(i, -i));
+    for (int i = 0; i < 200; i += 3)
+        CHECK(m.erase(i));
+    for (int i = 0; i < 200; ++i)
+        CHECK(m.find(i) == (i % 3 ? std::optional<int>(-i) : std::nullopt));
+}
+
+void test_concurrent_disjoint() {
+    pl::split_ordered_map<int, int> m;
+    const int threads = 8, per_thread = 20000;
+    {
+        std::vector<std::jthread> workers;
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                for (int i = 0; i < per_thread; ++i) {
+                    int k = i * threads + t;
+                    CHECK(m.insert(k, k));
+                    if (i % 3 == 0)
+                        CHECK(m.erase(k));
+                }
+            });
+        }
+    }
+    std::size_t expected = 0;
+    for (int t = 0; t < threads; ++t) {
+        for (int i = 0; i < per_thread; ++i) {
+            int k = i * threads + t;
+            CHECK(m.contains(k) == (i % 3 != 0));
+            expected += i % 3 != 0;
+        }
+    }
+    CHECK(m.size() == expected);
+}
+
+void test_concurrent_contended() {
+    pl::split_ordered_map<int, int> m;
+    {
+        std::vector<std::jthread> workers;
+        for (int t = 0; t < 8; ++t) {
+            workers.emplace_back([&, t] {
+                std::mt19937 rng(static_cast<unsigned>(t));
+                for (int i = 0; i < 50000; ++i) {
+                    int k = static_cast<int>(rng() % 500);
+                    if (rng() & 1)
+                        m.insert(k, k);
+                    else
+                        m.erase(k);
+                    if (auto v = m.find(k))
+                        CHECK(*v == k);
+                }
+            });
+        }
+    }
+    std::size_t present = 0;
+    for (int k = 0; k < 500; ++k)
+        present += m.contains(k);
+    CHECK(present == m.size());
+}
+
+// Counts live values so the tests can see erased nodes being freed.  The
+// payload is on the heap, so reading a freed value trips AddressSanitizer.
+struct counted {
+    static inline std::atomic<std::ptrdiff_t> live{0};
+    static inline std::atomic<std::ptrdiff_t> peak{0};
+    int value;
+    std::string payload;
+    explicit counted(int v) : value(v), payload(64, 'x') { born(); }
+    counted(const counted& o) : value(o.value), payload(o.payload) { born(); }
+    counted(counted&& o) noexcept : value(o.value), payload(std::move(o.payload)) { born(); }
+    ~counted() { --live; }
+    static void born() {
+        const std::ptrdiff_t n = ++live;
+        std::ptrdiff_t p = peak.load();
+        while (n > p && !peak.compare_exchange_weak(p, n)) {
+        }
+    }
+};
+
+// Steady insert/erase traffic over a small key space must not grow memory:
+// the values alive stay within the keys present plus a bounded backlog.
+void test_churn_memory_bounded() {
+    constexpr int keys = 1000;
+    constexpr std::ptrdiff_t backlog = 4096;
+    counted::live = 0;
+    counted::peak = 0;
+    {
+        pl::split_ordered_map<int, counted> m;
+        for (int round = 0; round < 500; ++round) {
+            for (int k = 0; k < keys; ++k)
+                m.insert(k, counted(k));
+            for (int k = 0; k < keys; ++k)
+                m.erase(k);
+        }
+        CHECK(m.empty());
+        CHECK(counted::peak.load() <= keys + backlog);
+    }
+    CHECK(counted::live.load() == 0);
+
+    counted::peak = 0;
+    {
+        pl::split_ordered_map<int, counted> m;
+        std::atomic<bool> ok{true};
+        {
+            std::vector<std::jthread> workers;
+            for (int t = 0; t < 8; ++t) {
+                workers.emplace_back([&, t] {
+                    std::mt19937 rng(static_cast<unsigned>(t));
+                    for (int i = 0; i < 100000; ++i) {
+                        const int k = static_cast<int>(rng() % keys);
+                        m.insert(k, counted(k));
+                        if (auto v = m.find(k); v && (v->value != k || v->payload.size() != 64))
+                            ok = false;
+                        m.erase(static_cast<int>(rng() % keys));
+                    }
+                });
+            }
+        }
+        CHECK(ok.load());
+        // 800k erases; without reclamation every erased value would still
+        // be alive here.  A few quiet operations finish any pending pass.
+        for (int i = 0; i < 4; ++i) {
+            m.insert(-1, counted(-1));
+            m.erase(-1);
+        }
+        CHECK(counted::live.load() <= static_cast<std::ptrdiff_t>(m.size()) + backlog);
+    }
+    CHECK(counted::live.load() == 0);
+}
+
+} // namespace
+
+int main() {
+    test_single_thread();
+    test_string_keys();
+    test_collisions();
+    test_concurrent_disjoint();
+    test_concurrent_contended();
+    test_churn_memory_bounded();
+    return check::exit_code();
+}
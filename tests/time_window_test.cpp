@@ -0,0 +1,173 @@
+#include <p_linked_list/time_window.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// A clock whose time points the test makes up.
+struct test_clock {
+    using duration = std::chrono::milliseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<test_clock>;
+    static constexpr bool is_steady = true;
+};
+
+using ms = std::chrono::milliseconds;
+using window = pl::time_window<long, test_clock>;
+
+test_clock::time_point at(long t) { return test_clock::time_point(ms(t)); }
+
+// Keeps every event and filters by bucket on each query.
+struct model {
+    long width;
+    long buckets;
+    long newest = -1;
+    std::vector<std::pair<long, long>> events;  // (bucket, value)
+
+    void push(long t, long v) {
+        newest = std::max(newest, t / width);
+        events.emplace_back(newest, v);
+    }
+    void advance(long t) { newest = std::max(newest, t / width); }
+    std::vector<long> live() const {
+        std::vector<long> out;
+        for (auto& [b, v] : events) {
+            if (b > newest - buckets)
+                out.push_back(v);
+        }
+        return out;
+    }
+};
+
+void check_against(const window& w, const model& m) {
+    const std::vector<long> live = m.live();
+    long sum = 0;
+    for (long v : live)
+        sum += v;
+    CHECK(w.count() == live.size());
+    CHECK(w.sum() == sum);
+    if (live.empty()) {
+        CHECK(!w.min() && !w.max());
+        CHECK(w.mean() == 0.0);
+    } else {
+        CHECK(w.min() == *std::min_element(live.begin(), live.end()));
+        CHECK(w.max() == *std::max_element(live.begin(), live.end()));
+        CHECK(w.mean() == static_cast<double>(sum) / static_cast<double>(live.size()));
+    }
+    std::vector<long> seen;
+    w.for_each([&](test_clock::time_point, long v) { seen.push_back(v); });
+    CHECK(seen == live);
+}
+
+void test_against_model() {
+    std::mt19937 rng(11);
+    for (long width : {1L, 10L, 250L}) {
+        for (long buckets : {1L, 4L, 60L}) {
+            window w(ms(width * buckets), ms(width));
+            model m{width, buckets, -1, {}};
+            long t = 0;
+            for (int i = 0; i < 5000; ++i) {
+                const unsigned r = rng() % 100;
+                if (r < 70)
+                    t += static_cast<long>(rng() % (width + 1));
+                else if (r < 95)
+                    t += static_cast<long>(rng() % (width * buckets + 1));
+                else
+                    t += static_cast<long>(rng() % (5 * width * buckets + 1));
+                const long v = static_cast<long>(rng() % 2001) - 1000;
+                if (rng() % 8 == 0) {
+                    w.advance(at(t));
+                    m.advance(t);
+                } else {
+                    w.push(at(t), v);
+                    m.push(t, v);
+                }
+                check_against(w, m);
+            }
+        }
+    }
+}
+
+void test_expiry_and_reuse() {
+    window w(ms(1000), ms(100));
+    CHECK(w.count() == 0 && !w.min() && w.mean() == 0.0);
+    for (long t = 0; t < 1000; ++t)
+        w.push(at(t), t);
+    CHECK(w.count() == 1000);
+    CHECK(w.min() == 0 && w.max() == 999);
+    w.advance(at(1099));
+    CHECK(w.count() == 900);
+    CHECK(w.min() == 100);
+    // Jumping far ahead empties the window in one step.
+    w.advance(at(1'000'000));
+    CHECK(w.count() == 0 && w.sum() == 0 && !w.max());
+    // Nodes of expired buckets are reused.
+    for (long t = 1'000'000; t < 1'001'000; ++t)
+        w.push(at(t), 1);
+    CHECK(w.count() == 1000 && w.sum() == 1000);
+}
+
+void test_late_events_join_newest_bucket() {
+    window w(ms(300), ms(100));
+    w.push(at(250), 5);
+    w.push(at(10), 7);  // older than the newest bucket: counted in it
+    CHECK(w.count() == 2);
+    w.advance(at(449));
+    CHECK(w.count() == 2);
+    w.advance(at(500));
+    CHECK(w.count() == 0);
+}
+
+void test_floating_point_values() {
+    pl::time_window<double, test_clock> w(ms(10), ms(1));
+    for (int i = 0; i < 20; ++i)
+        w.push(at(i), i * 0.5);
+    CHECK(w.count() == 10);
+    CHECK(w.min() == 5.0 && w.max() == 9.5);
+    CHECK(w.mean() == 7.25);
+}
+
+void test_non_positive_sizes() {
+    CHECK_THROWS(std::invalid_argument, window(ms(10), ms(0)));
+    CHECK_THROWS(std::invalid_argument, window(ms(10), ms(-1)));
+    CHECK_THROWS(std::invalid_argument, window(ms(0), ms(1)));
+    CHECK_THROWS(std::invalid_argument, window(ms(-10), ms(1)));
+    // A window narrower than one bucket still keeps that bucket.
+    window w(ms(1), ms(10));
+    w.push(at(5), 1);
+    w.push(at(15), 2);
+    CHECK(w.count() == 1 && w.sum() == 2);
+}
+
+void test_steady_clock_default() {
+    pl::time_window<int> w(std::chrono::seconds(1), std::chrono::milliseconds(10));
+    const auto now = std::chrono::steady_clock::now();
+    w.push(now, 3);
+    w.push(now + std::chrono::milliseconds(500), 4);
+    CHECK(w.sum() == 7);
+    w.advance(now + std::chrono::seconds(2));
+    CHECK(w.count() == 0);
+}
+
+} // namespace
+
+int main() {
+    test_against_model();
+    test_expiry_and_reuse();
+    test_late_events_join_newest_bucket();
+    test_floating_point_values();
+    test_non_positive_sizes();
+    test_steady_clock_default();
+    return check::exit_code();
+}
@@ -0,0 +1,247 @@
+#include <p_linked_list/work_stealing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "check.hpp"
+
+namespace pl = p_linked_list;
+
+namespace {
+
+// When non-negative, the calling thread's operator new fails once after this
+// many more allocations succeed.  Other threads are unaffected.
+thread_local int allocations_until_failure = -1;
+
+void* checked(void* p) {
+    if (allocations_until_failure == 0) {
+        allocations_until_failure = -1;
+        std::free(p);
+        p = nullptr;
+    } else if (allocations_until_failure > 0) {
+        --allocations_until_failure;
+    }
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+
+} // namespace
+
+void* operator new(std::size_t n) { return checked(std::malloc(n ? n : 1)); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+void test_deque_ends() {
+    pl::task_deque d;
+    std::vector<int> ran;
+    auto task_for = [&](int i) { return [&ran, i] { ran.push_back(i); }; };
+    CHECK(!d.pop_bottom() && !d.pop_top());
+    // Enough to span several blocks in both directions.
+    for (int i = 0; i < 1000; ++i)
+        d.push_bottom(task_for(i));
+    CHECK(d.size() == 1000);
+    for (int i = 0; i < 300; ++i)
+        (*d.pop_top())();
+    for (int i = 0; i < 300; ++i)
+        (*d.pop_bottom())();
+    std::vector<int> expect;
+    for (int i = 0; i < 300; ++i)
+        expect.push_back(i);
+    for (int i = 999; i >= 700; --i)
+        expect.push_back(i);
+    CHECK(ran == expect);
+    CHECK(d.size() == 400);
+    while (auto t = d.pop_top())
+        (*t)();
+    CHECK(d.size() == 0 && !d.pop_bottom());
+    CHECK(ran.size() == 1000 && ran.back() == 699);
+    // The emptied deque grows again from either end.
+    ran.clear();
+    for (int i = 0; i < 200; ++i)
+        d.push_bottom(task_for(i));
+    (*d.pop_top())();
+    (*d.pop_bottom())();
+    CHECK((ran == std::vector<int>{0, 199}));
+    CHECK(d.size() == 198);
+}
+
+void test_deque_random_against_model() {
+    pl::task_deque d;
+    std::vector<int> model;  // front = top
+    int out = -1;
+    std::mt19937 rng(2);
+    for (int i = 0; i < 100000; ++i) {
+        const unsigned op = rng() % 3;
+        if (op == 0 || model.empty()) {
+            d.push_bottom([&out, i] { out = i; });
+            model.push_back(i);
+        } else if (op == 1) {
+            (*d.pop_bottom())();
+            CHECK(out == model.back());
+            model.pop_back();
+        } else {
+            (*d.pop_top())();
+            CHECK(out == model.front());
+            model.erase(model.begin());
+        }
+    }
+    CHECK(d.size() == model.size());
+}
+
+long fib(pl::work_stealing_pool& pool, int n) {
+    if (n < 2)
+        return n;
+    if (n < 12)
+        return fib(pool, n - 1) + fib(pool, n - 2);
+    long a = 0, b = 0;
+    pl::parallel_invoke(pool, [&] { a = fib(pool, n - 1); }, [&] { b = fib(pool, n - 2); });
+    return a + b;
+}
+
+void test_fork_join() {
+    for (unsigned threads : {1u, 2u, 4u}) {
+        pl::work_stealing_pool pool(threads);
+        CHECK(pool.size() == threads);
+        CHECK(fib(pool, 25) == 75025);
+        // Fork-join from inside a pool task.
+        std::atomic<long> r{0};
+        {
+            pl::task_group outer(pool);
+            outer.spawn([&] { r = fib(pool, 20); });
+            outer.wait();
+        }
+        CHECK(r.load() == 6765);
+    }
+}
+
+void test_submit_from_outside() {
+    std::atomic<int> done{0};
+    {
+        pl::work_stealing_pool pool(3);
+        for (int i = 0; i < 10000; ++i)
+            pool.submit([&] { done.fetch_add(1); });
+        // The destructor finishes everything queued.
+    }
+    CHECK(done.load() == 10000);
+
+    pl::work_stealing_pool pool(2);
+    std::atomic<int> spawned{0};
+    pl::task_group g(pool);
+    for (int i = 0; i < 100; ++i) {
+        g.spawn([&] {
+            pl::task_group inner(pool);
+            for (int j = 0; j < 100; ++j)
+                inner.spawn([&] { spawned.fetch_add(1); });
+            inner.wait();
+        });
+    }
+    g.wait();
+    CHECK(spawned.load() == 10000);
+    CHECK(!pool.run_one());
+}
+
+void test_exceptions() {
+    pl::work_stealing_pool pool(2);
+    pl::task_group g(pool);
+    std::atomic<int> ran{0};
+    for (int i = 0; i < 100; ++i) {
+        g.spawn([&, i] {
+            ran.fetch_add(1);
+            if (i % 10 == 3)
+                throw std::runtime_error("task failed");
+        });
+    }
+    CHECK_THROWS(std::runtime_error, g.wait());
+    CHECK(ran.load() == 100);
+    // The error is reported once; the group is reusable.
+    g.spawn([&] { ran.fetch_add(1); });
+    g.wait();
+    CHECK(ran.load() == 101);
+
+    CHECK_THROWS(std::logic_error,
+                 pl::parallel_invoke(pool, [] {}, [] { throw std::logic_error("right side"); }));
+}
+
+// Failing each allocation of the constructor in turn covers a failure before
+// any worker starts, between workers and at the last one; the workers that
+// did start must be stopped and joined rather than terminate the process.
+void test_constructor_failure_joins_started_workers() {
+    int failures = 0;
+    for (int k = 0;; ++k) {
+        allocations_until_failure = k;
+        try {
+            pl::work_stealing_pool pool(4);
+            allocations_until_failure = -1;
+            break;
+        } catch (const std::bad_alloc&) {
+            ++failures;
+        }
+    }
+    // At least one failure per thread start.
+    CHECK(failures >= 4);
+    pl::work_stealing_pool pool(4);
+    CHECK(fib(pool, 20) == 6765);
+}
+
+// A spawn whose submit throws must not stay counted, or wait() never returns.
+void test_failed_spawn_is_not_waited_for() {
+    pl::work_stealing_pool pool(2);
+    pl::task_group g(pool);
+    std::atomic<int> ran{0};
+    g.spawn([&] { ran.fetch_add(1); });
+    // Too large for std::function's inline buffer, so queuing it allocates.
+    std::array<char, 64> big{};
+    auto task = [&ran, big] { ran.fetch_add(1 + big[0]); };
+    allocations_until_failure = 0;
+    CHECK_THROWS(std::bad_alloc, g.spawn(task));
+    allocations_until_failure = -1;
+    g.wait();
+    CHECK(ran.load() == 1);
+    g.spawn(task);
+    g.wait();
+    CHECK(ran.load() == 2);
+}
+
+void test_parallel_sum() {
+    pl::work_stealing_pool pool(4);
+    std::vector<std::uint32_t> v(1 << 20);
+    std::iota(v.begin(), v.end(), 0u);
+    std::atomic<std::uint64_t> total{0};
+    pl::task_group g(pool);
+    for (std::size_t i = 0; i < v.size(); i += 4096) {
+        g.spawn([&, i] {
+            std::uint64_t s = 0;
+            for (std::size_t j = i; j < std::min(v.size(), i + 4096); ++j)
+                s += v[j];
+            total.fetch_add(s);
+        });
+    }
+    g.wait();
+    CHECK(total.load() == std::uint64_t(v.size()) * (v.size() - 1) / 2);
+}
+
+} // namespace
+
+int main() {
+    test_deque_ends();
+    test_deque_random_against_model();
+    test_fork_join();
+    test_submit_from_outside();
+    test_exceptions();
+    test_constructor_failure_joins_started_workers();
+    test_failed_spawn_is_not_waited_for();
+    test_parallel_sum();
+    return check::exit_code();
+}